@@ -5,6 +5,7 @@
 #include <cstdint>
 #include <iomanip>
 #include <string>
+#include <algorithm>
 
 using namespace std;
 
@@ -53,6 +54,12 @@ namespace MSXHawk
 		bool sound_out_B;
 		bool sound_out_C;
 
+		// ticks not yet run, caught up when a counter runs out, before register writes and at the end of the frame
+		// so always 0 on frame boundaries, not stated
+		uint32_t pending_ticks = 0;
+		uint32_t event_ticks;
+		bool reg_written;
+
 		void Reset()
 		{
 			clock_A = clock_B = clock_C = 0x1000;
@@ -64,6 +71,9 @@ namespace MSXHawk
 				Register[i] = 0x0;
 			}
 			sync_psg_state();
+
+			calc_sample();
+			find_next_event();
 		}
 
 		short Sample()
@@ -141,6 +151,8 @@ namespace MSXHawk
 
 		void WriteReg(uint8_t value)
 		{
+			sync_sound();
+
 			value &= 0xFF;
 
 			if (port_sel != 0xE) { Register[port_sel] = value; }
@@ -163,86 +175,55 @@ namespace MSXHawk
 					E_up_down = 1;
 				}
 			}
+
+			// the output picks up the change at the end of the current tick
+			find_next_event();
+			reg_written = true;
 		}
 
-		bool generate_sound()
+		void clock_envelope()
 		{
-			// there are 8 cpu cycles for every psg cycle
-			clock_A--;
-			clock_B--;
-			clock_C--;
-
-			noise_clock--;
-			env_clock--;
-
-			// clock noise
-			if (noise_clock == 0)
-			{
-				noise = (noise >> 1) ^ (((noise &0x1) > 0) ? 0x10004 : 0);
-				noise_clock = noise_per;
-			}
+			env_E += E_up_down;
 
-			if (env_clock == 0)
+			if (env_E == 16 || env_E == -1)
 			{
-				env_clock = env_per;
-
-				env_E += E_up_down;
-
-				if (env_E == 16 || env_E == -1)
+				// we just completed a period of the envelope, determine what to do now based on the envelope shape
+				if (env_shape == 0 || env_shape == 1 || env_shape == 3 || env_shape == 9)
 				{
-					// we just completed a period of the envelope, determine what to do now based on the envelope shape
-					if (env_shape == 0 || env_shape == 1 || env_shape == 3 || env_shape == 9)
-					{
-						E_up_down = 0;
-						env_E = 0;
-					}
-					else if (env_shape == 5 || env_shape == 7)
-					{
-						E_up_down = 0;
-						env_E = 15;
-					}
-					else if (env_shape == 4 || env_shape == 8)
-					{
-						if (env_E == 16)
-						{
-							env_E = 15;
-							E_up_down = -1;
-						}
-						else
-						{
-							env_E = 0;
-							E_up_down = 1;
-						}
-					}
-					else if (env_shape == 2)
+					E_up_down = 0;
+					env_E = 0;
+				}
+				else if (env_shape == 5 || env_shape == 7)
+				{
+					E_up_down = 0;
+					env_E = 15;
+				}
+				else if (env_shape == 4 || env_shape == 8)
+				{
+					if (env_E == 16)
 					{
 						env_E = 15;
+						E_up_down = -1;
 					}
 					else
 					{
 						env_E = 0;
+						E_up_down = 1;
 					}
 				}
+				else if (env_shape == 2)
+				{
+					env_E = 15;
+				}
+				else
+				{
+					env_E = 0;
+				}
 			}
+		}
 
-			if (clock_A == 0)
-			{
-				A_up = !A_up;
-				clock_A = sq_per_A;
-			}
-
-			if (clock_B == 0)
-			{
-				B_up = !B_up;
-				clock_B = sq_per_B;
-			}
-
-			if (clock_C == 0)
-			{
-				C_up = !C_up;
-				clock_C = sq_per_C;
-			}
-
+		void calc_sample()
+		{
 			sound_out_A = (((noise & 0x1) > 0) | A_noise) & (A_on | A_up);
 			sound_out_B = (((noise & 0x1) > 0) | B_noise) & (B_on | B_up);
 			sound_out_C = (((noise & 0x1) > 0) | C_noise) & (C_on | C_up);
@@ -276,12 +257,59 @@ namespace MSXHawk
 			{
 				current_sample += (sound_out_C ? VolumeTable[vol_C] : 0);
 			}
+		}
 
-			current_sample;
+		// runs the pending ticks all at once, the output is only recalculated at the end since nothing can change it in between
+		void sync_sound()
+		{
+			if (pending_ticks == 0) { return; }
+
+			uint32_t ticks = pending_ticks;
+			pending_ticks = 0;
 
-			if (current_sample != old_sample) { return true; }
+			if ((count_expiries(clock_A, sq_per_A, ticks) & 1) > 0) { A_up = !A_up; }
+			if ((count_expiries(clock_B, sq_per_B, ticks) & 1) > 0) { B_up = !B_up; }
+			if ((count_expiries(clock_C, sq_per_C, ticks) & 1) > 0) { C_up = !C_up; }
 
-			return false;
+			for (uint32_t i = count_expiries(noise_clock, noise_per, ticks); i > 0; i--)
+			{
+				noise = (noise >> 1) ^ (((noise & 0x1) > 0) ? 0x10004 : 0);
+			}
+
+			for (uint32_t i = count_expiries(env_clock, env_per, ticks); i > 0; i--)
+			{
+				clock_envelope();
+			}
+
+			calc_sample();
+			find_next_event();
+			reg_written = false;
+		}
+
+		// the output can only change when a counter runs out or a register is written
+		void find_next_event()
+		{
+			event_ticks = ticks_left(clock_A);
+			event_ticks = std::min(event_ticks, ticks_left(clock_B));
+			event_ticks = std::min(event_ticks, ticks_left(clock_C));
+			event_ticks = std::min(event_ticks, ticks_left(noise_clock));
+			event_ticks = std::min(event_ticks, ticks_left(env_clock));
+		}
+
+		static uint32_t ticks_left(uint32_t clock)
+		{
+			return (clock == 0) ? 0xFFFFFFFF : clock;
+		}
+
+		// runs a counter that is decremented every tick and reloaded with per when it hits 0, returns how many times it did
+		static uint32_t count_expiries(uint32_t& clock, uint32_t per, uint32_t ticks)
+		{
+			// a counter sitting at 0 only expires after wrapping all the way around
+			if ((clock == 0) || (clock > ticks)) { clock -= ticks; return 0; }
+
+			ticks -= clock;
+			clock = per - (ticks % per);
+			return 1 + ticks / per;
 		}
 
 		#pragma endregion
@@ -427,6 +455,11 @@ namespace MSXHawk
 			old_sample = *loader; loader++; old_sample |= (*loader << 8); loader++;
 			old_sample |= (*loader << 16); loader++; old_sample |= (*loader << 24); loader++;
 
+			pending_ticks = 0;
+			reg_written = false;
+			calc_sample();
+			find_next_event();
+
 			return loader;
 		}
 
@@ -3,9 +3,12 @@
 
 #include <iostream>
 #include <cstdint>
+#include <cstdlib>
 #include <iomanip>
 #include <string>
 #include <cstring>
+#include <vector>
+#include <algorithm>
 
 #include "Z80A.h"
 #include "AY_3_8910.h"
@@ -91,7 +94,7 @@ namespace MSXHawk
 			{
 				vdp.ScanLine = i;
 
-				vdp.RenderScanline(i);
+				vdp.RenderScanline(i, render);
 
 				if (vdp.ScanLine == 192)
 				{
@@ -107,10 +110,7 @@ namespace MSXHawk
 					{
 						cpu.ExecuteOne(16);
 						sampleclock+=16;
-						new_sample |= psg.generate_sound();
-						new_sample |= SCC_1.generate_sound(16);
-						//new_sample |= SCC_2.generate_sound();
-						if (new_sample) { Add_Audio_Sample(); }
+						Generate_Sound(16, rendersound);
 					}
 					cpu.ExecuteOne(4);
 					sampleclock += 4;
@@ -120,19 +120,13 @@ namespace MSXHawk
 				case 1:
 					cpu.ExecuteOne(12);
 					sampleclock += 12;
-					new_sample |= psg.generate_sound();
-					new_sample |= SCC_1.generate_sound(12);
-					//new_sample |= SCC_2.generate_sound();
-					if (new_sample) { Add_Audio_Sample(); }
+					Generate_Sound(12, rendersound);
 					
 					for (int i = 0; i < 13; i++)
 					{
 						cpu.ExecuteOne(16);
 						sampleclock += 16;
-						new_sample |= psg.generate_sound();
-						new_sample |= SCC_1.generate_sound(16);
-						//new_sample |= SCC_2.generate_sound();
-						if (new_sample) { Add_Audio_Sample(); }
+						Generate_Sound(16, rendersound);
 					}
 					cpu.ExecuteOne(8);
 					sampleclock += 8;
@@ -142,19 +136,13 @@ namespace MSXHawk
 				case 2:
 					cpu.ExecuteOne(8);
 					sampleclock += 8;
-					new_sample |= psg.generate_sound();
-					new_sample |= SCC_1.generate_sound(8);
-					//new_sample |= SCC_2.generate_sound();
-					if (new_sample) { Add_Audio_Sample(); }
+					Generate_Sound(8, rendersound);
 
 					for (int i = 0; i < 13; i++)
 					{
 						cpu.ExecuteOne(16);
 						sampleclock += 16;
-						new_sample |= psg.generate_sound();
-						new_sample |= SCC_1.generate_sound(16);
-						//new_sample |= SCC_2.generate_sound();
-						if (new_sample) { Add_Audio_Sample(); }
+						Generate_Sound(16, rendersound);
 					}
 					cpu.ExecuteOne(12);
 					sampleclock += 12;
@@ -163,28 +151,46 @@ namespace MSXHawk
 				case 3:
 					cpu.ExecuteOne(4);
 					sampleclock += 4;
-					new_sample |= psg.generate_sound();
-					new_sample |= SCC_1.generate_sound(4);
-					//new_sample |= SCC_2.generate_sound();
-					if (new_sample) { Add_Audio_Sample(); }
+					Generate_Sound(4, rendersound);
 
 					for (int i = 0; i < 14; i++)
 					{
 						cpu.ExecuteOne(16);
 						sampleclock += 16;
-						new_sample |= psg.generate_sound();
-						new_sample |= SCC_1.generate_sound(16);
-						//new_sample |= SCC_2.generate_sound();
-						if (new_sample) { Add_Audio_Sample(); }
+						Generate_Sound(16, rendersound);
 					}
 					sl_case = 0;
 					break;
 				}
 			}
 
+			// bring the sound chips up to date, when sound was rendered the samples are already settled
+			psg.sync_sound();
+			SCC_1.sync_sound();
+
+			psg.old_sample = psg.current_sample;
+			SCC_1.old_sample = SCC_1.current_sample;
+
 			return MemMap.lagged;
 		}
 
+		// one psg tick per slice, the chips only do any work when their output can change
+		inline void Generate_Sound(uint32_t cycles, bool rendersound)
+		{
+			psg.pending_ticks++;
+			SCC_1.pending_cycles += cycles;
+
+			if (rendersound)
+			{
+				if ((psg.pending_ticks >= psg.event_ticks) || psg.reg_written) { psg.sync_sound(); }
+				if ((SCC_1.pending_cycles >= SCC_1.event_cycles) || SCC_1.reg_written) { SCC_1.sync_sound(); }
+
+				new_sample |= (psg.current_sample != psg.old_sample);
+				new_sample |= (SCC_1.current_sample != SCC_1.old_sample);
+				if (new_sample) { Add_Audio_Sample(); }
+			}
+		}
+
 		void Add_Audio_Sample() 
 		{
 			if (num_samples < 4500)
@@ -234,7 +240,7 @@ namespace MSXHawk
 
 		#pragma region State Save / Load
 
-		void SaveState(uint8_t* saver)
+		uint8_t* SaveState(uint8_t* saver)
 		{
 			saver = vdp.SaveState(saver);
 			saver = cpu.SaveState(saver);
@@ -245,6 +251,8 @@ namespace MSXHawk
 
 			*saver = (uint8_t)(new_sample ? 1 : 0); saver++;
 			*saver = sl_case; saver++;
+
+			return saver;
 		}
 
 		void LoadState(uint8_t* loader)
@@ -260,6 +268,78 @@ namespace MSXHawk
 			sl_case = *loader; loader++;
 		}
 
+		// checked states are a small header followed by exactly what SaveState writes, every byte is written so
+		// two states of the same machine state are identical and can be compared or hashed directly
+		// bump the version whenever anything changes what SaveState writes
+		static const uint32_t StateMagic = 0x4853584D; // "MSXH"
+		static const uint32_t StateVersion = 1;
+		static const uint32_t StateHeaderSize = 12;
+
+		uint32_t state_size = 0;
+
+		// size of a checked state, plain states are StateHeaderSize smaller
+		uint32_t GetStateSize()
+		{
+			if (state_size == 0)
+			{
+				// every part of the state has a fixed size, so it only needs measuring once
+				// everything SaveState writes is copied out of a member of this class, so the state can't be bigger than it
+				std::vector<uint8_t> scratch(sizeof(MSXCore));
+				size_t length = (size_t)(SaveState(scratch.data()) - scratch.data());
+
+				// if that ever stops holding the heap is already overrun, so stop here rather than carry on
+				if (length > scratch.size()) { std::abort(); }
+
+				state_size = (uint32_t)length + StateHeaderSize;
+			}
+
+			return state_size;
+		}
+
+		// returns the number of bytes written, or -1 if the buffer is too small
+		int32_t SaveStateChecked(uint8_t* saver, uint32_t length)
+		{
+			uint32_t size = GetStateSize();
+
+			if (length < size) { return -1; }
+
+			saver = WriteStateWord(saver, StateMagic);
+			saver = WriteStateWord(saver, StateVersion);
+			saver = WriteStateWord(saver, size);
+
+			SaveState(saver);
+
+			return (int32_t)size;
+		}
+
+		// returns 0 on success, -1 if the buffer is too small, -2 if it isn't an MSXHawk state, -3 if it is from another version
+		// nothing is loaded unless the state checks out
+		int32_t LoadStateChecked(uint8_t* loader, uint32_t length)
+		{
+			uint32_t size = GetStateSize();
+
+			if (length < size) { return -1; }
+			if (ReadStateWord(loader) != StateMagic) { return -2; }
+			if ((ReadStateWord(loader + 4) != StateVersion) || (ReadStateWord(loader + 8) != size)) { return -3; }
+
+			LoadState(loader + StateHeaderSize);
+
+			return 0;
+		}
+
+		static uint8_t* WriteStateWord(uint8_t* saver, uint32_t value)
+		{
+			*saver = (uint8_t)(value & 0xFF); saver++; *saver = (uint8_t)((value >> 8) & 0xFF); saver++;
+			*saver = (uint8_t)((value >> 16) & 0xFF); saver++; *saver = (uint8_t)((value >> 24) & 0xFF); saver++;
+
+			return saver;
+		}
+
+		static uint32_t ReadStateWord(uint8_t* loader)
+		{
+			return (uint32_t)loader[0] | ((uint32_t)loader[1] << 8) | ((uint32_t)loader[2] << 16) | ((uint32_t)loader[3] << 24);
+		}
+
 		#pragma endregion
 
 		#pragma region Memory Domain Functions
@@ -283,6 +363,81 @@ namespace MSXHawk
 			return MemMap.ram[addr & 0xFFFF];
 		}
 
+		// range versions of the above, addresses wrap around the same way
+		void GetSysBusRange(uint8_t* dest, uint32_t addr, uint32_t length)
+		{
+			// a bank at a time, without touching the cpu's own bank variables
+			while (length > 0)
+			{
+				addr &= 0xFFFF;
+				uint32_t offset = addr & cpu.low_mask;
+				uint32_t chunk = std::min(length, cpu.low_mask + 1 - offset);
+
+				std::memcpy(dest, &cpu.MemoryMap[(addr >> cpu.bank_shift) & cpu.high_mask][offset], chunk);
+				dest += chunk; addr += chunk; length -= chunk;
+			}
+		}
+
+		void GetVRAMRange(uint8_t* dest, uint32_t addr, uint32_t length)
+		{
+			CopyFromWrapped(dest, vdp.VRAM, 0x3FFF, addr, length);
+		}
+
+		void SetVRAMRange(uint8_t* src, uint32_t addr, uint32_t length)
+		{
+			CopyToWrapped(vdp.VRAM, src, 0x3FFF, addr, length);
+			vdp.InvalidateCache();
+		}
+
+		void GetRAMRange(uint8_t* dest, uint32_t addr, uint32_t length)
+		{
+			CopyFromWrapped(dest, MemMap.ram, 0xFFFF, addr, length);
+		}
+
+		void SetRAMRange(uint8_t* src, uint32_t addr, uint32_t length)
+		{
+			CopyToWrapped(MemMap.ram, src, 0xFFFF, addr, length);
+		}
+
+		static void CopyFromWrapped(uint8_t* dest, uint8_t* mem, uint32_t mask, uint32_t addr, uint32_t length)
+		{
+			while (length > 0)
+			{
+				addr &= mask;
+				uint32_t chunk = std::min(length, mask + 1 - addr);
+				std::memcpy(dest, &mem[addr], chunk);
+				dest += chunk; addr += chunk; length -= chunk;
+			}
+		}
+
+		static void CopyToWrapped(uint8_t* mem, uint8_t* src, uint32_t mask, uint32_t addr, uint32_t length)
+		{
+			while (length > 0)
+			{
+				addr &= mask;
+				uint32_t chunk = std::min(length, mask + 1 - addr);
+				std::memcpy(&mem[addr], src, chunk);
+				src += chunk; addr += chunk; length -= chunk;
+			}
+		}
+
+		// flat regions that can be accessed directly, in order until false is returned
+		// VRAM is read only this way, writes go through SetVRAMRange
+		bool GetMemoryArea(int32_t which, uint8_t** data, int32_t* size, bool* writable, const char** name)
+		{
+			switch (which)
+			{
+			case 0:
+				*data = vdp.VRAM; *size = 0x4000; *writable = false; *name = "VRAM";
+				return true;
+			case 1:
+				*data = MemMap.ram; *size = 0x10000; *writable = true; *name = "RAM";
+				return true;
+			default:
+				return false;
+			}
+		}
+
 		#pragma endregion
 
 		#pragma region Tracer
@@ -84,6 +84,24 @@ MSXHawk_EXPORT void MSX_load_state(MSXCore* p, uint8_t* loader)
 	p->LoadState(loader);
 }
 
+// size of a checked state, plain states fit in this too
+MSXHawk_EXPORT uint32_t MSX_state_size(MSXCore* p)
+{
+	return p->GetStateSize();
+}
+
+// save a versioned state, returns the length written or a negative value if the buffer is too small
+MSXHawk_EXPORT int32_t MSX_save_state_checked(MSXCore* p, uint8_t* saver, uint32_t length)
+{
+	return p->SaveStateChecked(saver, length);
+}
+
+// load a versioned state, returns 0 on success or a negative value if it doesn't match this core
+MSXHawk_EXPORT int32_t MSX_load_state_checked(MSXCore* p, uint8_t* loader, uint32_t length)
+{
+	return p->LoadStateChecked(loader, length);
+}
+
 #pragma endregion
 
 #pragma region Memory Domain Functions
@@ -100,6 +118,31 @@ MSXHawk_EXPORT uint8_t MSX_getram(MSXCore* p, uint32_t addr) {
 	return p->GetRAM(addr);
 }
 
+MSXHawk_EXPORT void MSX_getsysbus_range(MSXCore* p, uint8_t* dest, uint32_t addr, uint32_t length) {
+	p->GetSysBusRange(dest, addr, length);
+}
+
+MSXHawk_EXPORT void MSX_getvram_range(MSXCore* p, uint8_t* dest, uint32_t addr, uint32_t length) {
+	p->GetVRAMRange(dest, addr, length);
+}
+
+MSXHawk_EXPORT void MSX_setvram_range(MSXCore* p, uint8_t* src, uint32_t addr, uint32_t length) {
+	p->SetVRAMRange(src, addr, length);
+}
+
+MSXHawk_EXPORT void MSX_getram_range(MSXCore* p, uint8_t* dest, uint32_t addr, uint32_t length) {
+	p->GetRAMRange(dest, addr, length);
+}
+
+MSXHawk_EXPORT void MSX_setram_range(MSXCore* p, uint8_t* src, uint32_t addr, uint32_t length) {
+	p->SetRAMRange(src, addr, length);
+}
+
+// direct pointers to flat memory, which counts up from 0 until false is returned
+MSXHawk_EXPORT bool MSX_get_memory_area(MSXCore* p, int32_t which, uint8_t** data, int32_t* size, bool* writable, const char** name) {
+	return p->GetMemoryArea(which, data, size, writable, name);
+}
+
 #pragma endregion
 
 
@@ -6,6 +6,7 @@
 #include <iomanip>
 #include <string>
 #include <cstring>
+#include <algorithm>
 
 using namespace std;
 
@@ -38,6 +39,12 @@ namespace MSXHawk
 		// channel output, not stated
 		int32_t ch_1_out, ch_2_out, ch_3_out, ch_4_out, ch_5_out;
 
+		// cycles not yet run, caught up when a channel steps, before register writes and at the end of the frame
+		// so always 0 on frame boundaries, not stated
+		uint32_t pending_cycles = 0;
+		uint32_t event_cycles;
+		bool reg_written;
+
 		/*
 		const uint32_t VolumeTable[16] =
 		{
@@ -60,6 +67,8 @@ namespace MSXHawk
 			{
 				WriteReg(i, 0);
 			}
+
+			current_sample = ch_1_out + ch_2_out + ch_3_out + ch_4_out + ch_5_out;
 		}
 
 		short Sample()
@@ -75,6 +84,8 @@ namespace MSXHawk
 
 		void WriteReg(uint8_t addr, uint8_t value)
 		{
+			sync_sound();
+
 			// addresses 0x90-0xA0 are the same as 0x80-90
 			if ((addr >= 0x90) && (addr < 0xA0))
 			{
@@ -132,88 +143,87 @@ namespace MSXHawk
 			{
 				// there is a test register in this range, but it is used by games, ignore for now
 			}
+
+			// the output picks up the change at the end of the current slice
+			find_next_event();
+			reg_written = true;
 		}
 
-		bool generate_sound(int cycles)
-		{		
-			for (int i = 0; i < cycles; i++)
-			{
-				if (ch_1_en)
-				{
-					ch_1_clk--;
-
-					if (ch_1_clk == 0)
-					{
-						ch_1_clk = ch_1_frq;
-						ch_1_cnt++;
-						ch_1_cnt &= 0x1F;
-
-						ch_1_out = (int32_t)((int8_t)page_pntr[ch_1_cnt]) * VolumeTable[ch_1_vol];
-					}
-				}
+		// runs the pending cycles all at once, the output is only recalculated at the end since nothing can change it in between
+		void sync_sound()
+		{
+			if (pending_cycles == 0) { return; }
 
-				if (ch_2_en)
-				{
-					ch_2_clk--;
+			uint32_t cycles = pending_cycles;
+			pending_cycles = 0;
 
-					if (ch_2_clk == 0)
-					{
-						ch_2_clk = ch_2_frq;
-						ch_2_cnt++;
-						ch_2_cnt &= 0x1F;
+			uint32_t steps;
 
-						ch_2_out = (int32_t)((int8_t)page_pntr[ch_2_cnt + 0x20]) * VolumeTable[ch_2_vol];
-					}
-				}
+			if (ch_1_en && ((steps = count_steps(ch_1_clk, ch_1_frq, cycles)) > 0))
+			{
+				ch_1_cnt = (ch_1_cnt + steps) & 0x1F;
+				ch_1_out = (int32_t)((int8_t)page_pntr[ch_1_cnt]) * VolumeTable[ch_1_vol];
+			}
 
-				if (ch_3_en)
-				{
-					ch_3_clk--;
+			if (ch_2_en && ((steps = count_steps(ch_2_clk, ch_2_frq, cycles)) > 0))
+			{
+				ch_2_cnt = (ch_2_cnt + steps) & 0x1F;
+				ch_2_out = (int32_t)((int8_t)page_pntr[ch_2_cnt + 0x20]) * VolumeTable[ch_2_vol];
+			}
 
-					if (ch_3_clk == 0)
-					{
-						ch_3_clk = ch_3_frq;
-						ch_3_cnt++;
-						ch_3_cnt &= 0x1F;
+			if (ch_3_en && ((steps = count_steps(ch_3_clk, ch_3_frq, cycles)) > 0))
+			{
+				ch_3_cnt = (ch_3_cnt + steps) & 0x1F;
+				ch_3_out = (int32_t)((int8_t)page_pntr[ch_3_cnt + 0x40]) * VolumeTable[ch_3_vol];
+			}
 
-						ch_3_out = (int32_t)((int8_t)page_pntr[ch_3_cnt + 0x40]) * VolumeTable[ch_3_vol];
-					}
-				}
+			if (ch_4_en && ((steps = count_steps(ch_4_clk, ch_4_frq, cycles)) > 0))
+			{
+				ch_4_cnt = (ch_4_cnt + steps) & 0x1F;
+				ch_4_out = (int32_t)((int8_t)page_pntr[ch_4_cnt + 0x60]) * VolumeTable[ch_4_vol];
+			}
 
-				if (ch_4_en)
-				{
-					ch_4_clk--;
+			if (ch_5_en && ((steps = count_steps(ch_5_clk, ch_5_frq, cycles)) > 0))
+			{
+				ch_5_cnt = (ch_5_cnt + steps) & 0x1F;
+				ch_5_out = (int32_t)((int8_t)page_pntr[ch_5_cnt + 0x60]) * VolumeTable[ch_5_vol];
+			}
 
-					if (ch_4_clk == 0)
-					{
-						ch_4_clk = ch_4_frq;
-						ch_4_cnt++;
-						ch_4_cnt &= 0x1F;
+			current_sample = ch_1_out + ch_2_out + ch_3_out + ch_4_out + ch_5_out;
 
-						ch_4_out = (int32_t)((int8_t)page_pntr[ch_4_cnt + 0x60]) * VolumeTable[ch_4_vol];
-					}
-				}
+			find_next_event();
+			reg_written = false;
+		}
 
-				if (ch_5_en)
-				{
-					ch_5_clk--;
+		// the output can only change when an enabled channel steps or a register is written
+		void find_next_event()
+		{
+			event_cycles = 0xFFFFFFFF;
 
-					if (ch_5_clk == 0)
-					{
-						ch_5_clk = ch_5_frq;
-						ch_5_cnt++;
-						ch_5_cnt &= 0x1F;
+			if (ch_1_en) { event_cycles = std::min(event_cycles, cycles_left(ch_1_clk)); }
+			if (ch_2_en) { event_cycles = std::min(event_cycles, cycles_left(ch_2_clk)); }
+			if (ch_3_en) { event_cycles = std::min(event_cycles, cycles_left(ch_3_clk)); }
+			if (ch_4_en) { event_cycles = std::min(event_cycles, cycles_left(ch_4_clk)); }
+			if (ch_5_en) { event_cycles = std::min(event_cycles, cycles_left(ch_5_clk)); }
+		}
 
-						ch_5_out = (int32_t)((int8_t)page_pntr[ch_5_cnt + 0x60]) * VolumeTable[ch_5_vol];
-					}
-				}
-			}
+		static uint32_t cycles_left(uint16_t clk)
+		{
+			return (clk == 0) ? 0x10000 : clk;
+		}
 
-			current_sample = ch_1_out + ch_2_out + ch_3_out + ch_4_out + ch_5_out;
+		// runs a channel clock for the given cycles, returns how many times it reloaded (stepping the wave counter)
+		static uint32_t count_steps(uint16_t& clk, uint16_t frq, uint32_t cycles)
+		{
+			// the clocks are 16 bit, so a clock at (or reloaded with) 0 takes 0x10000 cycles to come back around
+			uint32_t c = (clk == 0) ? 0x10000 : clk;
+			uint32_t per = (frq == 0) ? 0x10000 : frq;
 
-			if (current_sample != old_sample) { return true; }
+			if (c > cycles) { clk = (uint16_t)(c - cycles); return 0; }
 
-			return false;
+			cycles -= c;
+			clk = (uint16_t)(per - (cycles % per));
+			return 1 + cycles / per;
 		}
 
 #pragma endregion
@@ -323,6 +333,11 @@ namespace MSXHawk
 			if (ch_4_en) { ch_4_out = (int32_t)((int8_t)page_pntr[ch_4_cnt + 0x60]) * VolumeTable[ch_4_vol]; } else { ch_4_out = 0; }
 			if (ch_5_en) { ch_5_out = (int32_t)((int8_t)page_pntr[ch_5_cnt + 0x60]) * VolumeTable[ch_5_vol]; } else { ch_5_out = 0; }
 
+			pending_cycles = 0;
+			reg_written = false;
+			current_sample = ch_1_out + ch_2_out + ch_3_out + ch_4_out + ch_5_out;
+			find_next_event();
+
 			return loader;
 		}
 
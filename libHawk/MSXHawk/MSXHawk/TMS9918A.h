@@ -15,7 +15,7 @@ namespace MSXHawk
 
 		TMS9918A()
 		{
-
+			InvalidateCache();
 		}
 
 		bool* IRQ_PTR = nullptr;
@@ -49,6 +49,16 @@ namespace MSXHawk
 		uint8_t ScanlinePriorityBuffer[256] = {};
 		uint8_t SpriteCollisionBuffer[256] = {};
 
+		// line cache, not stated (rebuilt from VRAM and registers after loading)
+		// BGBuffer holds the rendered background of each line, FrameBuffer only has to be restored from it where sprites were drawn
+		uint32_t BGBuffer[192 * 256] = {};
+		bool BGLineDirty[192];
+		bool LineHasSprites[192];
+		bool SpriteLinesValid;
+		uint8_t SpriteLineCount[192];
+		uint8_t SpriteLineList[192][4];
+		uint8_t SpriteLineOverflow[192];
+
 		// constants after load, not stated
 		uint32_t BackgroundColor = 0;
 		uint32_t IPeriod = 228;
@@ -140,7 +150,11 @@ namespace MSXHawk
 			VdpWaitingForLatchByte = true;
 			VdpBuffer = value;
 
-			VRAM[VdpAddress] = value;
+			if (VRAM[VdpAddress] != value)
+			{
+				VRAM[VdpAddress] = value;
+				InvalidateVram(VdpAddress);
+			}
 			//if (!Mode16k)
 			//    Console.WriteLine("VRAM written while not in 16k addressing mode!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!");
 			VdpAddress++;
@@ -151,31 +165,103 @@ namespace MSXHawk
 		{
 			if (reg >= 8) return;
 
+			uint8_t changed = Registers[reg] ^ data;
 			Registers[reg] = data;
 			switch (reg)
 			{
 			case 0: // Mode Control Register 1
 				CheckVideoMode();
+				if (changed) { InvalidateBackground(); }
 				break;
 			case 1: // Mode Control Register 2
 				CheckVideoMode();
 				IRQ_PTR[0] = (EnableInterrupts() && InterruptPendingGet());
+				if (changed & 0x58) { InvalidateBackground(); } // display and mode bits
+				if (changed & 0x03) { SpriteLinesValid = false; } // sprite size and magnification
 				break;
 			case 2: // Name Table Base Address
 				TmsPatternNameTableBase = (Registers[2] << 10) & 0x3C00;
+				if (changed) { InvalidateBackground(); }
 				break;
 			case 3: // Color Table Base Address
 				ColorTableBase = (Registers[3] << 6) & 0x3FC0;
+				if (changed) { InvalidateBackground(); }
 				break;
 			case 4: // Pattern Generator Base Address
 				PatternGeneratorBase = (Registers[4] << 11) & 0x3800;
+				if (changed) { InvalidateBackground(); }
 				break;
 			case 5: // Sprite Attribute Table Base Address
 				TmsSpriteAttributeBase = (Registers[5] << 7) & 0x3F80;
+				if (changed) { SpriteLinesValid = false; }
 				break;
 			case 6: // Sprite Pattern Generator Base Adderss 
 				SpritePatternGeneratorBase = (Registers[6] << 11) & 0x3800;
 				break;
+			case 7: // Text and Backdrop Color
+				if (changed) { InvalidateBackground(); }
+				break;
+			}
+		}
+
+		void InvalidateBackground()
+		{
+			for (int i = 0; i < 192; i++) { BGLineDirty[i] = true; }
+		}
+
+		// called when VRAM was changed from outside the data port, or after loading a state
+		void InvalidateCache()
+		{
+			InvalidateBackground();
+			SpriteLinesValid = false;
+		}
+
+		void MarkLinesDirty(uint32_t first, uint32_t step, uint32_t count)
+		{
+			for (uint32_t i = 0; i < count; i++) { BGLineDirty[first + i * step] = true; }
+		}
+
+		// marks the lines whose background depends on the VRAM byte at addr in the current mode
+		void InvalidateVram(uint32_t addr)
+		{
+			uint32_t ofs = addr - TmsSpriteAttributeBase;
+			if (ofs < 0x80) { SpriteLinesValid = false; }
+
+			switch (TmsMode)
+			{
+			case 0:
+				ofs = addr - TmsPatternNameTableBase;
+				if (ofs < 768) { MarkLinesDirty((ofs / 32) * 8, 1, 8); }
+				ofs = addr - PatternGeneratorBase;
+				if (ofs < 0x800) { MarkLinesDirty(ofs & 7, 8, 24); }
+				ofs = addr - ColorTableBase;
+				if (ofs < 32) { InvalidateBackground(); }
+				break;
+			case 1:
+				ofs = addr - TmsPatternNameTableBase;
+				if (ofs < 960) { MarkLinesDirty((ofs / 40) * 8, 1, 8); }
+				ofs = addr - PatternGeneratorBase;
+				if (ofs < 0x800) { MarkLinesDirty(ofs & 7, 8, 24); }
+				break;
+			case 2:
+				ofs = addr - TmsPatternNameTableBase;
+				if (ofs < 768) { MarkLinesDirty((ofs / 32) * 8, 1, 8); }
+				// pattern and colour tables are split in thirds of the screen, 8 bytes per character
+				ofs = addr - (((Registers[4] & 4) << 11) & 0x2000);
+				if (ofs < 0x1800) { MarkLinesDirty((ofs >> 11) * 64 + (ofs & 7), 8, 8); }
+				ofs = addr - (ColorTableBase & 0x2000);
+				if (ofs < 0x1800) { MarkLinesDirty((ofs >> 11) * 64 + (ofs & 7), 8, 8); }
+				break;
+			case 3:
+				ofs = addr - TmsPatternNameTableBase;
+				if (ofs < 768) { MarkLinesDirty((ofs / 32) * 8, 1, 8); }
+				// each pattern byte covers 4 lines of every 4th character row
+				ofs = addr - PatternGeneratorBase;
+				if (ofs < 0x800)
+				{
+					for (uint32_t row = (ofs & 7) >> 1; row < 24; row += 4) { MarkLinesDirty(row * 8 + (ofs & 1) * 4, 1, 4); }
+				}
+				break;
 			}
 		}
 
@@ -207,38 +293,45 @@ namespace MSXHawk
 			else TmsMode = 0;
 		}
 
-		void RenderScanline(int32_t scanLine)
+		void RenderScanline(int32_t scanLine, bool render)
 		{
 			if (scanLine >= 192)
 				return;
 
-			if (TmsMode == 2)
-			{
-				RenderBackgroundM2(scanLine);
-				RenderTmsSprites(scanLine);
-			}
-			else if (TmsMode == 0)
-			{
-				RenderBackgroundM0(scanLine);
-				RenderTmsSprites(scanLine);
-			}
-			else if (TmsMode == 3)
+			// sprite attributes are normally updated during vblank, so the per-line lists are rebuilt once at the top of the frame
+			if ((scanLine == 0) && !SpriteLinesValid && (TmsMode != 1)) { BuildSpriteLines(); }
+
+			if (!render)
 			{
-				RenderBackgroundM3(scanLine);
-				RenderTmsSprites(scanLine);
+				// nothing is drawn, but sprite collision and 5th sprite status are still visible to the game
+				if (TmsMode != 1) { RenderTmsSprites(scanLine, false); }
+				return;
 			}
-			else if (TmsMode == 1)
+
+			bool restore = BGLineDirty[scanLine] || LineHasSprites[scanLine];
+
+			if (BGLineDirty[scanLine])
 			{
-				RenderBackgroundM1(scanLine);
-				// no sprites (text mode)
+				if (TmsMode == 2) { RenderBackgroundM2(scanLine); }
+				else if (TmsMode == 0) { RenderBackgroundM0(scanLine); }
+				else if (TmsMode == 3) { RenderBackgroundM3(scanLine); }
+				else if (TmsMode == 1) { RenderBackgroundM1(scanLine); }
+
+				BGLineDirty[scanLine] = false;
 			}
+
+			// a clean line without sprites last time is still correct in the frame buffer
+			if (restore) { std::memcpy(&FrameBuffer[scanLine * 256], &BGBuffer[scanLine * 256], sizeof(uint32_t) * 256); }
+
+			// no sprites in text mode
+			LineHasSprites[scanLine] = (TmsMode != 1) && RenderTmsSprites(scanLine, true);
 		}
 
 		void RenderBackgroundM0(uint32_t scanLine)
 		{
 			if (DisplayOn() == false)
 			{
-				for (int i = 0; i < 256; i++) { FrameBuffer[scanLine * 256 + i] = 0; };
+				for (int i = 0; i < 256; i++) { BGBuffer[scanLine * 256 + i] = 0; };
 				return;
 			}
 
@@ -258,14 +351,14 @@ namespace MSXHawk
 				fgColor = fgIndex == 0 ? ScreenBGColor : PaletteTMS9918[fgIndex];
 				bgColor = bgIndex == 0 ? ScreenBGColor : PaletteTMS9918[bgIndex];
 
-				FrameBuffer[FrameBufferOffset++] = ((pv & 0x80) > 0) ? fgColor : bgColor;
-				FrameBuffer[FrameBufferOffset++] = ((pv & 0x40) > 0) ? fgColor : bgColor;
-				FrameBuffer[FrameBufferOffset++] = ((pv & 0x20) > 0) ? fgColor : bgColor;
-				FrameBuffer[FrameBufferOffset++] = ((pv & 0x10) > 0) ? fgColor : bgColor;
-				FrameBuffer[FrameBufferOffset++] = ((pv & 0x08) > 0) ? fgColor : bgColor;
-				FrameBuffer[FrameBufferOffset++] = ((pv & 0x04) > 0) ? fgColor : bgColor;
-				FrameBuffer[FrameBufferOffset++] = ((pv & 0x02) > 0) ? fgColor : bgColor;
-				FrameBuffer[FrameBufferOffset++] = ((pv & 0x01) > 0) ? fgColor : bgColor;
+				BGBuffer[FrameBufferOffset++] = ((pv & 0x80) > 0) ? fgColor : bgColor;
+				BGBuffer[FrameBufferOffset++] = ((pv & 0x40) > 0) ? fgColor : bgColor;
+				BGBuffer[FrameBufferOffset++] = ((pv & 0x20) > 0) ? fgColor : bgColor;
+				BGBuffer[FrameBufferOffset++] = ((pv & 0x10) > 0) ? fgColor : bgColor;
+				BGBuffer[FrameBufferOffset++] = ((pv & 0x08) > 0) ? fgColor : bgColor;
+				BGBuffer[FrameBufferOffset++] = ((pv & 0x04) > 0) ? fgColor : bgColor;
+				BGBuffer[FrameBufferOffset++] = ((pv & 0x02) > 0) ? fgColor : bgColor;
+				BGBuffer[FrameBufferOffset++] = ((pv & 0x01) > 0) ? fgColor : bgColor;
 			}
 		}
 
@@ -273,7 +366,7 @@ namespace MSXHawk
 		{
 			if (DisplayOn() == false)
 			{
-				for (int i = 0; i < 256; i++) { FrameBuffer[scanLine * 256 + i] = 0; };
+				for (int i = 0; i < 256; i++) { BGBuffer[scanLine * 256 + i] = 0; };
 				return;
 			}
 
@@ -293,12 +386,12 @@ namespace MSXHawk
 				fgColor = fgIndex == 0 ? ScreenBGColor : PaletteTMS9918[fgIndex];
 				bgColor = bgIndex == 0 ? ScreenBGColor : PaletteTMS9918[bgIndex];
 
-				FrameBuffer[FrameBufferOffset++] = ((pv & 0x80) > 0) ? fgColor : bgColor;
-				FrameBuffer[FrameBufferOffset++] = ((pv & 0x40) > 0) ? fgColor : bgColor;
-				FrameBuffer[FrameBufferOffset++] = ((pv & 0x20) > 0) ? fgColor : bgColor;
-				FrameBuffer[FrameBufferOffset++] = ((pv & 0x10) > 0) ? fgColor : bgColor;
-				FrameBuffer[FrameBufferOffset++] = ((pv & 0x08) > 0) ? fgColor : bgColor;
-				FrameBuffer[FrameBufferOffset++] = ((pv & 0x04) > 0) ? fgColor : bgColor;
+				BGBuffer[FrameBufferOffset++] = ((pv & 0x80) > 0) ? fgColor : bgColor;
+				BGBuffer[FrameBufferOffset++] = ((pv & 0x40) > 0) ? fgColor : bgColor;
+				BGBuffer[FrameBufferOffset++] = ((pv & 0x20) > 0) ? fgColor : bgColor;
+				BGBuffer[FrameBufferOffset++] = ((pv & 0x10) > 0) ? fgColor : bgColor;
+				BGBuffer[FrameBufferOffset++] = ((pv & 0x08) > 0) ? fgColor : bgColor;
+				BGBuffer[FrameBufferOffset++] = ((pv & 0x04) > 0) ? fgColor : bgColor;
 			}
 		}
 
@@ -306,7 +399,7 @@ namespace MSXHawk
 		{
 			if (DisplayOn() == false)
 			{
-				for (int i = 0; i < 256; i++) { FrameBuffer[scanLine * 256 + i] = 0; };
+				for (int i = 0; i < 256; i++) { BGBuffer[scanLine * 256 + i] = 0; };
 				return;
 			}
 
@@ -328,14 +421,14 @@ namespace MSXHawk
 				fgColor = fgIndex == 0 ? ScreenBGColor : PaletteTMS9918[fgIndex];
 				bgColor = bgIndex == 0 ? ScreenBGColor : PaletteTMS9918[bgIndex];
 
-				FrameBuffer[FrameBufferOffset++] = ((pv & 0x80) > 0) ? fgColor : bgColor;
-				FrameBuffer[FrameBufferOffset++] = ((pv & 0x40) > 0) ? fgColor : bgColor;
-				FrameBuffer[FrameBufferOffset++] = ((pv & 0x20) > 0) ? fgColor : bgColor;
-				FrameBuffer[FrameBufferOffset++] = ((pv & 0x10) > 0) ? fgColor : bgColor;
-				FrameBuffer[FrameBufferOffset++] = ((pv & 0x08) > 0) ? fgColor : bgColor;
-				FrameBuffer[FrameBufferOffset++] = ((pv & 0x04) > 0) ? fgColor : bgColor;
-				FrameBuffer[FrameBufferOffset++] = ((pv & 0x02) > 0) ? fgColor : bgColor;
-				FrameBuffer[FrameBufferOffset++] = ((pv & 0x01) > 0) ? fgColor : bgColor;
+				BGBuffer[FrameBufferOffset++] = ((pv & 0x80) > 0) ? fgColor : bgColor;
+				BGBuffer[FrameBufferOffset++] = ((pv & 0x40) > 0) ? fgColor : bgColor;
+				BGBuffer[FrameBufferOffset++] = ((pv & 0x20) > 0) ? fgColor : bgColor;
+				BGBuffer[FrameBufferOffset++] = ((pv & 0x10) > 0) ? fgColor : bgColor;
+				BGBuffer[FrameBufferOffset++] = ((pv & 0x08) > 0) ? fgColor : bgColor;
+				BGBuffer[FrameBufferOffset++] = ((pv & 0x04) > 0) ? fgColor : bgColor;
+				BGBuffer[FrameBufferOffset++] = ((pv & 0x02) > 0) ? fgColor : bgColor;
+				BGBuffer[FrameBufferOffset++] = ((pv & 0x01) > 0) ? fgColor : bgColor;
 			}
 		}
 
@@ -343,7 +436,7 @@ namespace MSXHawk
 		{
 			if (DisplayOn() == false)
 			{
-				for (int i = 0; i < 256; i++) { FrameBuffer[scanLine * 256 + i] = 0; };
+				for (int i = 0; i < 256; i++) { BGBuffer[scanLine * 256 + i] = 0; };
 				return;
 			}
 
@@ -363,61 +456,90 @@ namespace MSXHawk
 				lColor = lColorIndex == 0 ? ScreenBGColor : PaletteTMS9918[lColorIndex];
 				rColor = rColorIndex == 0 ? ScreenBGColor : PaletteTMS9918[rColorIndex];
 
-				FrameBuffer[FrameBufferOffset++] = lColor;
-				FrameBuffer[FrameBufferOffset++] = lColor;
-				FrameBuffer[FrameBufferOffset++] = lColor;
-				FrameBuffer[FrameBufferOffset++] = lColor;
-				FrameBuffer[FrameBufferOffset++] = rColor;
-				FrameBuffer[FrameBufferOffset++] = rColor;
-				FrameBuffer[FrameBufferOffset++] = rColor;
-				FrameBuffer[FrameBufferOffset] = rColor;
+				BGBuffer[FrameBufferOffset++] = lColor;
+				BGBuffer[FrameBufferOffset++] = lColor;
+				BGBuffer[FrameBufferOffset++] = lColor;
+				BGBuffer[FrameBufferOffset++] = lColor;
+				BGBuffer[FrameBufferOffset++] = rColor;
+				BGBuffer[FrameBufferOffset++] = rColor;
+				BGBuffer[FrameBufferOffset++] = rColor;
+				BGBuffer[FrameBufferOffset++] = rColor;
 			}
 		}
 
-		inline void RenderTmsSprites(int32_t scanLine)
+		// returns true if any sprite is on the scanline
+		inline bool RenderTmsSprites(int32_t scanLine, bool render)
 		{
 			if (EnableDoubledSprites() == false)
 			{
-				RenderTmsSpritesStandard(scanLine);
+				return RenderTmsSpritesStandard(scanLine, render);
 			}
 			else
 			{
-				RenderTmsSpritesDouble(scanLine);
+				return RenderTmsSpritesDouble(scanLine, render);
 			}
 		}
 
-		void RenderTmsSpritesStandard(int32_t scanLine)
+		// same search as FindTmsSprites, but for all lines at once
+		void BuildSpriteLines()
 		{
-			if (DisplayOn() == false) return;
+			int32_t SpriteSize = 8;
+			if (EnableLargeSprites()) SpriteSize *= 2;
+			if (EnableDoubledSprites()) SpriteSize *= 2;
 
-			for (uint32_t i = 0; i < 256; i++) 
-			{ 
-				ScanlinePriorityBuffer[i] = 0; 
-				SpriteCollisionBuffer[i] = 0;
-			};
+			for (int32_t i = 0; i < 192; i++)
+			{
+				SpriteLineCount[i] = 0;
+				SpriteLineOverflow[i] = 0xFF;
+			}
 
-			bool LargeSprites = EnableLargeSprites();
+			for (int32_t i = 0; i < 32; i++)
+			{
+				int32_t y = VRAM[TmsSpriteAttributeBase + (i * 4)];
 
-			int32_t SpriteSize = 8;
-			if (LargeSprites) SpriteSize *= 2;
-			const int32_t OneCellSize = 8;
+				if (y == 208) break; // terminator sprite
+				if (y > 224) y -= 256; // sprite Y wrap
+				y++; // inexplicably, sprites start on Y+1
+
+				for (int32_t line = (y < 0 ? 0 : y); line < y + SpriteSize && line < 192; line++)
+				{
+					if (SpriteLineCount[line] < 4) { SpriteLineList[line][SpriteLineCount[line]++] = (uint8_t)i; }
+					else if (SpriteLineOverflow[line] == 0xFF) { SpriteLineOverflow[line] = (uint8_t)i; }
+				}
+			}
+
+			SpriteLinesValid = true;
+		}
+
+		// finds the (up to 4) sprites shown on this scanline and sets the 5th sprite status if there are more
+		int32_t FindTmsSprites(int32_t scanLine, int32_t SpriteSize, int32_t* SpriteList)
+		{
+			if (SpriteLinesValid)
+			{
+				if (SpriteLineOverflow[scanLine] != 0xFF)
+				{
+					StatusByte &= 0xE0;    // Clear FS0-FS4 bits
+					StatusByte |= SpriteLineOverflow[scanLine]; // set 5th sprite index
+					StatusByte |= 0x40;    // set overflow bit
+				}
 
+				for (int32_t i = 0; i < SpriteLineCount[scanLine]; i++) { SpriteList[i] = SpriteLineList[scanLine][i]; }
+
+				return SpriteLineCount[scanLine];
+			}
+
+			// attributes changed during this frame, search the table directly
 			int32_t NumSpritesOnScanline = 0;
 			for (int32_t i = 0; i < 32; i++)
 			{
-				int32_t SpriteBase = TmsSpriteAttributeBase + (i * 4);
-				int32_t y = VRAM[SpriteBase++];
-				int32_t x = VRAM[SpriteBase++];
-				int32_t Pattern = VRAM[SpriteBase++];
-				int32_t Color = VRAM[SpriteBase];
+				int32_t y = VRAM[TmsSpriteAttributeBase + (i * 4)];
 
 				if (y == 208) break; // terminator sprite
 				if (y > 224) y -= 256; // sprite Y wrap
 				y++; // inexplicably, sprites start on Y+1
 				if (y > scanLine || y + SpriteSize <= scanLine) continue; // sprite is not on this scanline
-				if ((Color & 0x80) > 0) x -= 32; // Early Clock adjustment
 
-				if (++NumSpritesOnScanline == 5)
+				if (NumSpritesOnScanline == 4)
 				{
 					StatusByte &= 0xE0;    // Clear FS0-FS4 bits
 					StatusByte |= (uint8_t)i; // set 5th sprite index
@@ -425,6 +547,46 @@ namespace MSXHawk
 					break;
 				}
 
+				SpriteList[NumSpritesOnScanline++] = i;
+			}
+
+			return NumSpritesOnScanline;
+		}
+
+		bool RenderTmsSpritesStandard(int32_t scanLine, bool render)
+		{
+			if (DisplayOn() == false) return false;
+
+			bool LargeSprites = EnableLargeSprites();
+
+			int32_t SpriteSize = 8;
+			if (LargeSprites) SpriteSize *= 2;
+			const int32_t OneCellSize = 8;
+
+			int32_t SpriteList[4];
+			int32_t NumSpritesOnScanline = FindTmsSprites(scanLine, SpriteSize, SpriteList);
+
+			// when not rendering, only a new collision can change anything from here on
+			if (!render && ((NumSpritesOnScanline < 2) || ((StatusByte & 0x20) > 0))) return NumSpritesOnScanline > 0;
+
+			for (uint32_t i = 0; i < 256; i++) 
+			{ 
+				ScanlinePriorityBuffer[i] = 0; 
+				SpriteCollisionBuffer[i] = 0;
+			};
+
+			for (int32_t s = 0; s < NumSpritesOnScanline; s++)
+			{
+				int32_t SpriteBase = TmsSpriteAttributeBase + (SpriteList[s] * 4);
+				int32_t y = VRAM[SpriteBase++];
+				int32_t x = VRAM[SpriteBase++];
+				int32_t Pattern = VRAM[SpriteBase++];
+				int32_t Color = VRAM[SpriteBase];
+
+				if (y > 224) y -= 256; // sprite Y wrap
+				y++; // inexplicably, sprites start on Y+1
+				if ((Color & 0x80) > 0) x -= 32; // Early Clock adjustment
+
 				if (LargeSprites) Pattern &= 0xFC; // 16x16 sprites forced to 4-uint8_t alignment
 				int32_t SpriteLine = scanLine - y;
 
@@ -449,22 +611,18 @@ namespace MSXHawk
 						{
 							ScanlinePriorityBuffer[x + xp] = 1;
 							SpriteCollisionBuffer[x + xp] = 1;
-							FrameBuffer[(scanLine * 256) + x + xp] = PaletteTMS9918[Color & 0x0F];
+							if (render) { FrameBuffer[(scanLine * 256) + x + xp] = PaletteTMS9918[Color & 0x0F]; }
 						}
 					}
 				}
 			}
+
+			return NumSpritesOnScanline > 0;
 		}
 
-		void RenderTmsSpritesDouble(int32_t scanLine)
+		bool RenderTmsSpritesDouble(int32_t scanLine, bool render)
 		{
-			if (DisplayOn() == false) return;
-
-			for (uint32_t i = 0; i < 256; i++)
-			{
-				ScanlinePriorityBuffer[i] = 0;
-				SpriteCollisionBuffer[i] = 0;
-			};
+			if (DisplayOn() == false) return false;
 
 			bool LargeSprites = EnableLargeSprites();
 
@@ -473,29 +631,30 @@ namespace MSXHawk
 			SpriteSize *= 2;  // because sprite magnification
 			const int32_t OneCellSize = 16; // once 8-pixel cell, doubled, will take 16 pixels
 
-			int32_t NumSpritesOnScanline = 0;
-			for (int32_t i = 0; i < 32; i++)
+			int32_t SpriteList[4];
+			int32_t NumSpritesOnScanline = FindTmsSprites(scanLine, SpriteSize, SpriteList);
+
+			// when not rendering, only a new collision can change anything from here on
+			if (!render && ((NumSpritesOnScanline < 2) || ((StatusByte & 0x20) > 0))) return NumSpritesOnScanline > 0;
+
+			for (uint32_t i = 0; i < 256; i++)
 			{
-				int32_t SpriteBase = TmsSpriteAttributeBase + (i * 4);
+				ScanlinePriorityBuffer[i] = 0;
+				SpriteCollisionBuffer[i] = 0;
+			};
+
+			for (int32_t s = 0; s < NumSpritesOnScanline; s++)
+			{
+				int32_t SpriteBase = TmsSpriteAttributeBase + (SpriteList[s] * 4);
 				int32_t y = VRAM[SpriteBase++];
 				int32_t x = VRAM[SpriteBase++];
 				int32_t Pattern = VRAM[SpriteBase++];
 				int32_t Color = VRAM[SpriteBase];
 
-				if (y == 208) break; // terminator sprite
 				if (y > 224) y -= 256; // sprite Y wrap
 				y++; // inexplicably, sprites start on Y+1
-				if (y > scanLine || y + SpriteSize <= scanLine) continue; // sprite is not on this scanline
 				if ((Color & 0x80) > 0) x -= 32; // Early Clock adjustment
 
-				if (++NumSpritesOnScanline == 5)
-				{
-					StatusByte &= 0xE0;    // Clear FS0-FS4 bits
-					StatusByte |= (uint8_t)i; // set 5th sprite index
-					StatusByte |= 0x40;    // set overflow bit
-					break;
-				}
-
 				if (LargeSprites) Pattern &= 0xFC; // 16x16 sprites forced to 4-byte alignment
 				int32_t SpriteLine = scanLine - y;
 				SpriteLine /= 2; // because of sprite magnification
@@ -517,11 +676,13 @@ namespace MSXHawk
 						{
 							ScanlinePriorityBuffer[x + xp] = 1;
 							SpriteCollisionBuffer[x + xp] = 1;
-							FrameBuffer[(scanLine * 256) + x + xp] = PaletteTMS9918[Color & 0x0F];
+							if (render) { FrameBuffer[(scanLine * 256) + x + xp] = PaletteTMS9918[Color & 0x0F]; }
 						}
 					}
 				}
 			}
+
+			return NumSpritesOnScanline > 0;
 		}
 
 		#pragma endregion
@@ -602,6 +763,8 @@ namespace MSXHawk
 
 			TmsSpriteAttributeBase = *loader; loader++; TmsSpriteAttributeBase |= (*loader << 8); loader++;
 			TmsSpriteAttributeBase |= (*loader << 16); loader++; TmsSpriteAttributeBase |= (*loader << 24); loader++;
+
+			InvalidateCache();
 			
 			return loader;
 		}
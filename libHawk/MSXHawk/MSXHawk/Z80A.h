@@ -129,6 +129,22 @@ namespace MSXHawk
 		uint32_t IYIndexMEMRQ[256 * 19] = {};
 		uint32_t IXYCBIndexMEMRQ[256 * 19] = {};
 
+		// where the ops that do something sit in a sequence, so it can be run without stepping through its idle cycles
+		struct FastSeq
+		{
+			uint32_t cycles; // most cycles the sequence can take
+			uint32_t num_ops;
+			uint8_t ofst[19]; // where each op starts in the instruction vector
+			uint8_t cycle[19]; // and the cycle it runs on, counting from 1
+		};
+
+		// indexed by instr_bank, then opcode
+		FastSeq FastSeqs[6][256] = {};
+		FastSeq NoHaltFast = {};
+
+		// run whole sequences at once when they fit in the cycles left to execute (not savestated, doesn't change the results)
+		bool FastPath = true;
+
 		#pragma endregion
 
 		#pragma region Constant Declarations
@@ -589,700 +605,762 @@ namespace MSXHawk
 		{
 			for (stepper = 0; stepper < steps; stepper++)
 			{
+				// at the start of a sequence from the decode tables, run all of it at once if it can finish within this call
+				if ((instr_pntr == 0) && (irq_pntr == 0) && FastPath && !FlagW)
+				{
+					FastSeq* seq = nullptr;
+
+					if (instr_bank < 6) { seq = &FastSeqs[instr_bank][opcode]; }
+					else if (instr_bank == 11) { seq = &NoHaltFast; }
+
+					if (seq && (seq->cycles <= (steps - stepper)))
+					{
+						stepper += RunSequence(*seq) - 1;
+						continue;
+					}
+				}
+
 				bus_pntr++; mem_pntr++;
 
-				switch (cur_instr_ofst[instr_pntr++])
+				ExecuteMicroOp();
+
+				if (I_skip)
 				{
-				case IDLE:
-					// do nothing
-					break;
-				case OP:
-					// should never reach here
+					I_skip = false;
+				}
+				else if (++irq_pntr == cur_irqs_ofst[0])
+				{
+					EndInstruction();
+				}
 
-					break;
-				case OP_F:
-					// Read the opcode of the next instruction	
-					//if (OnExecFetch != null) OnExecFetch(RegPC);
+				TotalExecutedCycles++;
+			}
+		}
 
-					if (TraceCallback) { TraceCallback(0); }
+		// Runs a sequence from its start, only dispatching the cycles that do something (everything but IDLE and WAIT).
+		// Nothing outside the CPU runs within ExecuteOne, so this ends up exactly where stepping through it would.
+		// Returns the number of cycles taken.
+		// TotalExecutedCycles is kept at what stepping would have it at for each op, since the trace logger reads it.
+		inline uint32_t RunSequence(FastSeq& seq)
+		{
+			uint64_t start = TotalExecutedCycles;
 
-					bank_num = bank_offset = RegPCget();
-					RegPCset(bank_num + 1);
-					bank_offset &= low_mask;
-					bank_num = (bank_num >> bank_shift)& high_mask;
-					opcode = MemoryMap[bank_num][bank_offset];
-					FetchInstruction();
+			for (uint32_t i = 0; i < seq.num_ops; i++)
+			{
+				// a failed condition can end the instruction early
+				if (seq.cycle[i] > cur_irqs_ofst[0]) { break; }
 
-					temp_R = (Regs[R] & 0x7F);
-					temp_R++;
-					temp_R &= 0x7F;
-					Regs[R] = ((Regs[R] & 0x80) | temp_R);
+				instr_pntr = seq.ofst[i];
+				TotalExecutedCycles = start + seq.cycle[i] - 1;
+				ExecuteMicroOp();
 
-					instr_pntr = bus_pntr = mem_pntr = irq_pntr = 0;
-					I_skip = true;
-					break;
-				case HALT:
-					halted = true;
-					// NOTE: Check how halt state effects the DB
-					Regs[DB] = 0xFF;
+				// the op moved on to a new sequence (opcode fetch, prefix, or a repeat)
+				if (I_skip)
+				{
+					I_skip = false;
+					TotalExecutedCycles++;
+					return seq.cycle[i];
+				}
+			}
 
-					temp_R = (Regs[R] & 0x7F);
-					temp_R++;
-					temp_R &= 0x7F;
-					Regs[R] = ((Regs[R] & 0x80) | temp_R);
-					break;
-				case RD:
-					Read_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
-					instr_pntr += 3;
-					break;
-				case WR:
-					Write_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
-					instr_pntr += 3;
-					break;
-				case RD_INC:
-					Read_INC_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
-					instr_pntr += 3;
-					break;
-				case RD_INC_TR_PC:
-					Read_INC_TR_PC_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2], cur_instr_ofst[instr_pntr + 3]);
-					instr_pntr += 4;
-					break;
-				case RD_OP:
-					if (cur_instr_ofst[instr_pntr++] == 1) { Read_INC_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]); }
-					else { Read_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]); }
-					instr_pntr += 3;
-					switch (cur_instr_ofst[instr_pntr])
-					{
-					case ADD8:
-						ADD8_Func(cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
-						break;
-					case ADC8:
-						ADC8_Func(cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
-						break;
-					case SUB8:
-						SUB8_Func(cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
-						break;
-					case SBC8:
-						SBC8_Func(cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
-						break;
-					case AND8:
-						AND8_Func(cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
-						break;
-					case XOR8:
-						XOR8_Func(cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
-						break;
-					case OR8:
-						OR8_Func(cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
-						break;
-					case CP8:
-						CP8_Func(cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
-						break;
-					case TR:
-						Regs[cur_instr_ofst[instr_pntr + 1]] = Regs[cur_instr_ofst[instr_pntr + 2]];
-						break;
-					}
-					instr_pntr += 3;
-					break;
-				case WR_INC:
-					Write_INC_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
-					instr_pntr += 3;
-					break;
-				case WR_DEC:
-					Write_DEC_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
-					instr_pntr += 3;
-					break;
-				case WR_TR_PC:
-					Write_TR_PC_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
-					instr_pntr += 3;
-					break;
-				case WR_INC_WA:
-					Write_INC_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
-					instr_pntr += 3;
-					Regs[W] = Regs[A];
-					break;
-				case TR:
-					Regs[cur_instr_ofst[instr_pntr]] = Regs[cur_instr_ofst[instr_pntr + 1]];
-					instr_pntr += 2;
-					break;
-				case TR16:
-					Regs[cur_instr_ofst[instr_pntr]] = Regs[cur_instr_ofst[instr_pntr + 2]];
-					Regs[cur_instr_ofst[instr_pntr + 1]] = Regs[cur_instr_ofst[instr_pntr + 3]];
-					instr_pntr += 4;
-					break;
-				case ADD16:
-					ADD16_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2], cur_instr_ofst[instr_pntr + 3]);
-					instr_pntr += 4;
-					break;
+			uint32_t cycles = cur_irqs_ofst[0];
+
+			TotalExecutedCycles = start + cycles - 1;
+			EndInstruction();
+
+			TotalExecutedCycles++;
+			return cycles;
+		}
+
+		// Executes the op at instr_pntr
+		inline void ExecuteMicroOp()
+		{
+			switch (cur_instr_ofst[instr_pntr++])
+			{
+			case IDLE:
+				// do nothing
+				break;
+			case OP:
+				// should never reach here
+
+				break;
+			case OP_F:
+				// Read the opcode of the next instruction	
+				//if (OnExecFetch != null) OnExecFetch(RegPC);
+
+				if (TraceCallback) { TraceCallback(0); }
+
+				bank_num = bank_offset = RegPCget();
+				RegPCset(bank_num + 1);
+				bank_offset &= low_mask;
+				bank_num = (bank_num >> bank_shift)& high_mask;
+				opcode = MemoryMap[bank_num][bank_offset];
+				FetchInstruction();
+
+				temp_R = (Regs[R] & 0x7F);
+				temp_R++;
+				temp_R &= 0x7F;
+				Regs[R] = ((Regs[R] & 0x80) | temp_R);
+
+				instr_pntr = bus_pntr = mem_pntr = irq_pntr = 0;
+				I_skip = true;
+				break;
+			case HALT:
+				halted = true;
+				// NOTE: Check how halt state effects the DB
+				Regs[DB] = 0xFF;
+
+				temp_R = (Regs[R] & 0x7F);
+				temp_R++;
+				temp_R &= 0x7F;
+				Regs[R] = ((Regs[R] & 0x80) | temp_R);
+				break;
+			case RD:
+				Read_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
+				instr_pntr += 3;
+				break;
+			case WR:
+				Write_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
+				instr_pntr += 3;
+				break;
+			case RD_INC:
+				Read_INC_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
+				instr_pntr += 3;
+				break;
+			case RD_INC_TR_PC:
+				Read_INC_TR_PC_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2], cur_instr_ofst[instr_pntr + 3]);
+				instr_pntr += 4;
+				break;
+			case RD_OP:
+				if (cur_instr_ofst[instr_pntr++] == 1) { Read_INC_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]); }
+				else { Read_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]); }
+				instr_pntr += 3;
+				switch (cur_instr_ofst[instr_pntr])
+				{
 				case ADD8:
-					ADD8_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1]);
-					instr_pntr += 2;
-					break;
-				case SUB8:
-					SUB8_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1]);
-					instr_pntr += 2;
+					ADD8_Func(cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
 					break;
 				case ADC8:
-					ADC8_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1]);
-					instr_pntr += 2;
+					ADC8_Func(cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
 					break;
-				case ADC16:
-					ADC_16_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2], cur_instr_ofst[instr_pntr + 3]);
-					instr_pntr += 4;
+				case SUB8:
+					SUB8_Func(cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
 					break;
 				case SBC8:
-					SBC8_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1]);
-					instr_pntr += 2;
-					break;
-				case SBC16:
-					SBC_16_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2], cur_instr_ofst[instr_pntr + 3]);
-					instr_pntr += 4;
-					break;
-				case INC16:
-					INC16_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1]);
-					instr_pntr += 2;
-					break;
-				case INC8:
-					INC8_Func(cur_instr_ofst[instr_pntr]);
-					instr_pntr += 1;
-					break;
-				case DEC16:
-					DEC16_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1]);
-					instr_pntr += 2;
-					break;
-				case DEC8:
-					DEC8_Func(cur_instr_ofst[instr_pntr]);
-					instr_pntr += 1;
-					break;
-				case RLC:
-					RLC_Func(cur_instr_ofst[instr_pntr]);
-					instr_pntr += 1;
-					break;
-				case RL:
-					RL_Func(cur_instr_ofst[instr_pntr]);
-					instr_pntr += 1;
-					break;
-				case RRC:
-					RRC_Func(cur_instr_ofst[instr_pntr]);
-					instr_pntr += 1;
-					break;
-				case RR:
-					RR_Func(cur_instr_ofst[instr_pntr]);
-					instr_pntr += 1;
-					break;
-				case CPL:
-					CPL_Func(cur_instr_ofst[instr_pntr]);
-					instr_pntr += 1;
-					break;
-				case DA:
-					DA_Func(cur_instr_ofst[instr_pntr]);
-					instr_pntr += 1;
-					break;
-				case SCF:
-					SCF_Func(cur_instr_ofst[instr_pntr]);
-					instr_pntr += 1;
-					break;
-				case CCF:
-					CCF_Func(cur_instr_ofst[instr_pntr]);
-					instr_pntr += 1;
+					SBC8_Func(cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
 					break;
 				case AND8:
-					AND8_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1]);
-					instr_pntr += 2;
+					AND8_Func(cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
 					break;
 				case XOR8:
-					XOR8_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1]);
-					instr_pntr += 2;
+					XOR8_Func(cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
 					break;
 				case OR8:
-					OR8_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1]);
-					instr_pntr += 2;
+					OR8_Func(cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
 					break;
 				case CP8:
-					CP8_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1]);
-					instr_pntr += 2;
-					break;
-				case SLA:
-					SLA_Func(cur_instr_ofst[instr_pntr]);
-					instr_pntr += 1;
-					break;
-				case SRA:
-					SRA_Func(cur_instr_ofst[instr_pntr]);
-					instr_pntr += 1;
+					CP8_Func(cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
 					break;
-				case SRL:
-					SRL_Func(cur_instr_ofst[instr_pntr]);
-					instr_pntr += 1;
-					break;
-				case SLL:
-					SLL_Func(cur_instr_ofst[instr_pntr]);
-					instr_pntr += 1;
-					break;
-				case BIT:
-					BIT_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1]);
-					instr_pntr += 2;
-					break;
-				case I_BIT:
-					I_BIT_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1]);
-					instr_pntr += 2;
-					break;
-				case RES:
-					Regs[cur_instr_ofst[instr_pntr + 1]] &= (uint32_t)(0xFF - (1 << cur_instr_ofst[instr_pntr]));
-					instr_pntr += 2;
-					break;
-				case SET:
-					Regs[cur_instr_ofst[instr_pntr + 1]] |= (uint32_t)(1 << cur_instr_ofst[instr_pntr]);
-					instr_pntr += 2;
-					break;
-				case EI:
-					EI_pending = 2;
-					break;
-				case DI:
-					IFF1 = IFF2 = false;
-					break;
-				case EXCH:
-					EXCH_16_Func(F_s, A_s, F, A);
-					break;
-				case EXX:
-					EXCH_16_Func(C_s, B_s, C, B);
-					EXCH_16_Func(E_s, D_s, E, D);
-					EXCH_16_Func(L_s, H_s, L, H);
-					break;
-				case EXCH_16:
-					EXCH_16_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2], cur_instr_ofst[instr_pntr + 3]);
-					instr_pntr += 4;
+				case TR:
+					Regs[cur_instr_ofst[instr_pntr + 1]] = Regs[cur_instr_ofst[instr_pntr + 2]];
 					break;
-				case PREFIX:
-					NO_prefix = false;
-					if (PRE_SRC == CBpre) { CB_prefix = true; }
-					if (PRE_SRC == EXTDpre) { EXTD_prefix = true; }
-					if (PRE_SRC == IXpre) { IX_prefix = true; }
-					if (PRE_SRC == IYpre) { IY_prefix = true; }
-					if (PRE_SRC == IXCBpre) { IXCB_prefix = true; }
-					if (PRE_SRC == IYCBpre) { IYCB_prefix = true; }
-
-					// only the first prefix in a double prefix increases R, although I don't know how / why
-					if (PRE_SRC < 4)
-					{
-						temp_R = (Regs[R] & 0x7F);
-						temp_R++;
-						temp_R &= 0x7F;
-						Regs[R] = ((Regs[R] & 0x80) | temp_R);
-					}
+				}
+				instr_pntr += 3;
+				break;
+			case WR_INC:
+				Write_INC_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
+				instr_pntr += 3;
+				break;
+			case WR_DEC:
+				Write_DEC_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
+				instr_pntr += 3;
+				break;
+			case WR_TR_PC:
+				Write_TR_PC_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
+				instr_pntr += 3;
+				break;
+			case WR_INC_WA:
+				Write_INC_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
+				instr_pntr += 3;
+				Regs[W] = Regs[A];
+				break;
+			case TR:
+				Regs[cur_instr_ofst[instr_pntr]] = Regs[cur_instr_ofst[instr_pntr + 1]];
+				instr_pntr += 2;
+				break;
+			case TR16:
+				Regs[cur_instr_ofst[instr_pntr]] = Regs[cur_instr_ofst[instr_pntr + 2]];
+				Regs[cur_instr_ofst[instr_pntr + 1]] = Regs[cur_instr_ofst[instr_pntr + 3]];
+				instr_pntr += 4;
+				break;
+			case ADD16:
+				ADD16_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2], cur_instr_ofst[instr_pntr + 3]);
+				instr_pntr += 4;
+				break;
+			case ADD8:
+				ADD8_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1]);
+				instr_pntr += 2;
+				break;
+			case SUB8:
+				SUB8_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1]);
+				instr_pntr += 2;
+				break;
+			case ADC8:
+				ADC8_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1]);
+				instr_pntr += 2;
+				break;
+			case ADC16:
+				ADC_16_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2], cur_instr_ofst[instr_pntr + 3]);
+				instr_pntr += 4;
+				break;
+			case SBC8:
+				SBC8_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1]);
+				instr_pntr += 2;
+				break;
+			case SBC16:
+				SBC_16_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2], cur_instr_ofst[instr_pntr + 3]);
+				instr_pntr += 4;
+				break;
+			case INC16:
+				INC16_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1]);
+				instr_pntr += 2;
+				break;
+			case INC8:
+				INC8_Func(cur_instr_ofst[instr_pntr]);
+				instr_pntr += 1;
+				break;
+			case DEC16:
+				DEC16_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1]);
+				instr_pntr += 2;
+				break;
+			case DEC8:
+				DEC8_Func(cur_instr_ofst[instr_pntr]);
+				instr_pntr += 1;
+				break;
+			case RLC:
+				RLC_Func(cur_instr_ofst[instr_pntr]);
+				instr_pntr += 1;
+				break;
+			case RL:
+				RL_Func(cur_instr_ofst[instr_pntr]);
+				instr_pntr += 1;
+				break;
+			case RRC:
+				RRC_Func(cur_instr_ofst[instr_pntr]);
+				instr_pntr += 1;
+				break;
+			case RR:
+				RR_Func(cur_instr_ofst[instr_pntr]);
+				instr_pntr += 1;
+				break;
+			case CPL:
+				CPL_Func(cur_instr_ofst[instr_pntr]);
+				instr_pntr += 1;
+				break;
+			case DA:
+				DA_Func(cur_instr_ofst[instr_pntr]);
+				instr_pntr += 1;
+				break;
+			case SCF:
+				SCF_Func(cur_instr_ofst[instr_pntr]);
+				instr_pntr += 1;
+				break;
+			case CCF:
+				CCF_Func(cur_instr_ofst[instr_pntr]);
+				instr_pntr += 1;
+				break;
+			case AND8:
+				AND8_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1]);
+				instr_pntr += 2;
+				break;
+			case XOR8:
+				XOR8_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1]);
+				instr_pntr += 2;
+				break;
+			case OR8:
+				OR8_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1]);
+				instr_pntr += 2;
+				break;
+			case CP8:
+				CP8_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1]);
+				instr_pntr += 2;
+				break;
+			case SLA:
+				SLA_Func(cur_instr_ofst[instr_pntr]);
+				instr_pntr += 1;
+				break;
+			case SRA:
+				SRA_Func(cur_instr_ofst[instr_pntr]);
+				instr_pntr += 1;
+				break;
+			case SRL:
+				SRL_Func(cur_instr_ofst[instr_pntr]);
+				instr_pntr += 1;
+				break;
+			case SLL:
+				SLL_Func(cur_instr_ofst[instr_pntr]);
+				instr_pntr += 1;
+				break;
+			case BIT:
+				BIT_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1]);
+				instr_pntr += 2;
+				break;
+			case I_BIT:
+				I_BIT_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1]);
+				instr_pntr += 2;
+				break;
+			case RES:
+				Regs[cur_instr_ofst[instr_pntr + 1]] &= (uint32_t)(0xFF - (1 << cur_instr_ofst[instr_pntr]));
+				instr_pntr += 2;
+				break;
+			case SET:
+				Regs[cur_instr_ofst[instr_pntr + 1]] |= (uint32_t)(1 << cur_instr_ofst[instr_pntr]);
+				instr_pntr += 2;
+				break;
+			case EI:
+				EI_pending = 2;
+				break;
+			case DI:
+				IFF1 = IFF2 = false;
+				break;
+			case EXCH:
+				EXCH_16_Func(F_s, A_s, F, A);
+				break;
+			case EXX:
+				EXCH_16_Func(C_s, B_s, C, B);
+				EXCH_16_Func(E_s, D_s, E, D);
+				EXCH_16_Func(L_s, H_s, L, H);
+				break;
+			case EXCH_16:
+				EXCH_16_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2], cur_instr_ofst[instr_pntr + 3]);
+				instr_pntr += 4;
+				break;
+			case PREFIX:
+				NO_prefix = false;
+				if (PRE_SRC == CBpre) { CB_prefix = true; }
+				if (PRE_SRC == EXTDpre) { EXTD_prefix = true; }
+				if (PRE_SRC == IXpre) { IX_prefix = true; }
+				if (PRE_SRC == IYpre) { IY_prefix = true; }
+				if (PRE_SRC == IXCBpre) { IXCB_prefix = true; }
+				if (PRE_SRC == IYCBpre) { IYCB_prefix = true; }
+
+				// only the first prefix in a double prefix increases R, although I don't know how / why
+				if (PRE_SRC < 4)
+				{
+					temp_R = (Regs[R] & 0x7F);
+					temp_R++;
+					temp_R &= 0x7F;
+					Regs[R] = ((Regs[R] & 0x80) | temp_R);
+				}
 
-					bank_num = bank_offset = RegPCget();
-					RegPCset(bank_num + 1);
-					bank_offset &= low_mask;
-					bank_num = (bank_num >> bank_shift)& high_mask;
-					opcode = MemoryMap[bank_num][bank_offset];
-					FetchInstruction();
+				bank_num = bank_offset = RegPCget();
+				RegPCset(bank_num + 1);
+				bank_offset &= low_mask;
+				bank_num = (bank_num >> bank_shift)& high_mask;
+				opcode = MemoryMap[bank_num][bank_offset];
+				FetchInstruction();
 
-					instr_pntr = bus_pntr = mem_pntr = irq_pntr = 0;
-					I_skip = true;
-					break;
-				case ASGN:
-					Regs[cur_instr_ofst[instr_pntr]] = cur_instr_ofst[instr_pntr + 1];
-					instr_pntr += 2;
-					break;
-				case ADDS:
-					ADDS_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2], cur_instr_ofst[instr_pntr + 3]);
-					instr_pntr += 4;
-					break;
-				case EI_RETI:
-					// NOTE: This is needed for systems using multiple interrupt sources, it triggers the next interrupt
-					// Not currently implemented here
-					IFF1 = IFF2;
-					break;
-				case EI_RETN:
-					IFF1 = IFF2;
-					break;
-				case OUT:
-					OUT_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
-					instr_pntr += 3;
-					break;
-				case OUT_INC:
-					OUT_INC_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
-					instr_pntr += 3;
-					break;
-				case IN:
-					IN_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
-					instr_pntr += 3;
-					break;
-				case IN_INC:
-					IN_INC_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
-					instr_pntr += 3;
-					break;
-				case IN_A_N_INC:
-					IN_A_N_INC_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
-					instr_pntr += 3;
-					break;
-				case NEG:
-					NEG_8_Func(cur_instr_ofst[instr_pntr]);
-					instr_pntr += 1;
-					break;
-				case INT_MODE:
-					interruptMode = cur_instr_ofst[instr_pntr];
-					instr_pntr += 1;
-					break;
-				case RRD:
-					RRD_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1]);
-					instr_pntr += 2;
-					break;
-				case RLD:
-					RLD_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1]);
-					instr_pntr += 2;
-					break;
-				case SET_FL_LD_R:
-					DEC16_Func(C, B);
-					SET_FL_LD_Func();
+				instr_pntr = bus_pntr = mem_pntr = irq_pntr = 0;
+				I_skip = true;
+				break;
+			case ASGN:
+				Regs[cur_instr_ofst[instr_pntr]] = cur_instr_ofst[instr_pntr + 1];
+				instr_pntr += 2;
+				break;
+			case ADDS:
+				ADDS_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2], cur_instr_ofst[instr_pntr + 3]);
+				instr_pntr += 4;
+				break;
+			case EI_RETI:
+				// NOTE: This is needed for systems using multiple interrupt sources, it triggers the next interrupt
+				// Not currently implemented here
+				IFF1 = IFF2;
+				break;
+			case EI_RETN:
+				IFF1 = IFF2;
+				break;
+			case OUT:
+				OUT_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
+				instr_pntr += 3;
+				break;
+			case OUT_INC:
+				OUT_INC_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
+				instr_pntr += 3;
+				break;
+			case IN:
+				IN_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
+				instr_pntr += 3;
+				break;
+			case IN_INC:
+				IN_INC_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
+				instr_pntr += 3;
+				break;
+			case IN_A_N_INC:
+				IN_A_N_INC_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
+				instr_pntr += 3;
+				break;
+			case NEG:
+				NEG_8_Func(cur_instr_ofst[instr_pntr]);
+				instr_pntr += 1;
+				break;
+			case INT_MODE:
+				interruptMode = cur_instr_ofst[instr_pntr];
+				instr_pntr += 1;
+				break;
+			case RRD:
+				RRD_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1]);
+				instr_pntr += 2;
+				break;
+			case RLD:
+				RLD_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1]);
+				instr_pntr += 2;
+				break;
+			case SET_FL_LD_R:
+				DEC16_Func(C, B);
+				SET_FL_LD_Func();
 
-					Ztemp1 = cur_instr_ofst[instr_pntr++];
-					Ztemp2 = cur_instr_ofst[instr_pntr++];
-					Ztemp3 = cur_instr_ofst[instr_pntr++];
+				Ztemp1 = cur_instr_ofst[instr_pntr++];
+				Ztemp2 = cur_instr_ofst[instr_pntr++];
+				Ztemp3 = cur_instr_ofst[instr_pntr++];
 
-					if (((Regs[C] | (Regs[B] << 8)) != 0) && (Ztemp3 > 0))
-					{
-						cur_instr_ofst = &LD_OP_R_INST[0];
-						cur_instr_ofst[14] = Ztemp2; Ztemp2_saver = Ztemp2;
-						cur_bus_ofst = &LD_OP_R_BUSRQ[0];
-						cur_mem_ofst = &LD_OP_R_MEMRQ[0];
-						cur_irqs_ofst = &LD_OP_R_IRQS;
+				if (((Regs[C] | (Regs[B] << 8)) != 0) && (Ztemp3 > 0))
+				{
+					cur_instr_ofst = &LD_OP_R_INST[0];
+					cur_instr_ofst[14] = Ztemp2; Ztemp2_saver = Ztemp2;
+					cur_bus_ofst = &LD_OP_R_BUSRQ[0];
+					cur_mem_ofst = &LD_OP_R_MEMRQ[0];
+					cur_irqs_ofst = &LD_OP_R_IRQS;
 
-						instr_bank = 7;
+					instr_bank = 7;
 
-						instr_pntr = mem_pntr = bus_pntr = irq_pntr = 0;
-						I_skip = true;
-					}
-					else
-					{
-						if (Ztemp2 == INC16) { INC16_Func(E, D); }
-						else { DEC16_Func(E, D); }
-					}
-					break;
-				case SET_FL_CP_R:
-					SET_FL_CP_Func();
+					instr_pntr = mem_pntr = bus_pntr = irq_pntr = 0;
+					I_skip = true;
+				}
+				else
+				{
+					if (Ztemp2 == INC16) { INC16_Func(E, D); }
+					else { DEC16_Func(E, D); }
+				}
+				break;
+			case SET_FL_CP_R:
+				SET_FL_CP_Func();
 
-					Ztemp1 = cur_instr_ofst[instr_pntr++];
-					Ztemp2 = cur_instr_ofst[instr_pntr++];
-					Ztemp3 = cur_instr_ofst[instr_pntr++];
+				Ztemp1 = cur_instr_ofst[instr_pntr++];
+				Ztemp2 = cur_instr_ofst[instr_pntr++];
+				Ztemp3 = cur_instr_ofst[instr_pntr++];
 
-					if (((Regs[C] | (Regs[B] << 8)) != 0) && (Ztemp3 > 0) && !FlagZget())
-					{
-						cur_instr_ofst = &LD_CP_R_INST[0];
-						cur_instr_ofst[14] = Ztemp2; Ztemp2_saver = Ztemp2;
-						cur_bus_ofst = &LD_CP_R_BUSRQ[0];
-						cur_mem_ofst = &LD_CP_R_MEMRQ[0];
-						cur_irqs_ofst = &LD_CP_R_IRQS;
+				if (((Regs[C] | (Regs[B] << 8)) != 0) && (Ztemp3 > 0) && !FlagZget())
+				{
+					cur_instr_ofst = &LD_CP_R_INST[0];
+					cur_instr_ofst[14] = Ztemp2; Ztemp2_saver = Ztemp2;
+					cur_bus_ofst = &LD_CP_R_BUSRQ[0];
+					cur_mem_ofst = &LD_CP_R_MEMRQ[0];
+					cur_irqs_ofst = &LD_CP_R_IRQS;
 
-						instr_bank = 8;
+					instr_bank = 8;
 
-						instr_pntr = mem_pntr = bus_pntr = irq_pntr = 0;
-						I_skip = true;
-					}
-					else
-					{
-						if (Ztemp2 == INC16) { INC16_Func(L, H); }
-						else { DEC16_Func(L, H); }
-					}
-					break;
-				case SET_FL_IR:
-					Regs[cur_instr_ofst[instr_pntr]] = Regs[cur_instr_ofst[instr_pntr + 1]];
-					SET_FL_IR_Func(cur_instr_ofst[instr_pntr]);
-					instr_pntr += 2;
-					break;
-				case FTCH_DB:
-					FTCH_DB_Func();
-					break;
-				case WAIT:
-					if (FlagW)
-					{
-						instr_pntr--; bus_pntr--; mem_pntr--;
-						I_skip = true;
-					}
-					break;
-				case RST:
-					Regs[Z] = cur_instr_ofst[instr_pntr++];
-					Regs[W] = 0;
-					break;
-				case REP_OP_I:
-					Write_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
-					instr_pntr += 3;
+					instr_pntr = mem_pntr = bus_pntr = irq_pntr = 0;
+					I_skip = true;
+				}
+				else
+				{
+					if (Ztemp2 == INC16) { INC16_Func(L, H); }
+					else { DEC16_Func(L, H); }
+				}
+				break;
+			case SET_FL_IR:
+				Regs[cur_instr_ofst[instr_pntr]] = Regs[cur_instr_ofst[instr_pntr + 1]];
+				SET_FL_IR_Func(cur_instr_ofst[instr_pntr]);
+				instr_pntr += 2;
+				break;
+			case FTCH_DB:
+				FTCH_DB_Func();
+				break;
+			case WAIT:
+				if (FlagW)
+				{
+					instr_pntr--; bus_pntr--; mem_pntr--;
+					I_skip = true;
+				}
+				break;
+			case RST:
+				Regs[Z] = cur_instr_ofst[instr_pntr++];
+				Regs[W] = 0;
+				break;
+			case REP_OP_I:
+				Write_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
+				instr_pntr += 3;
 
-					Ztemp4 = cur_instr_ofst[instr_pntr++];
-					if (Ztemp4 == DEC16)
-					{
-						Regs[Z] = Regs[C];
-						Regs[W] = Regs[B];
-						DEC16_Func(Z, W);
-						DEC8_Func(B);
-
-						// take care of other flags
-						// taken from 'undocumented z80 documented' and Fuse
-						FlagNset((Regs[ALU] & 0x80) > 0);
-						FlagHset(((Regs[ALU] + Regs[C] - 1) & 0xFF) < Regs[ALU]);
-						FlagCset(((Regs[ALU] + Regs[C] - 1) & 0xFF) < Regs[ALU]);
-						FlagPset(TableParity[((Regs[ALU] + Regs[C] - 1) & 7) ^ Regs[B]]);
-					}
-					else
-					{
-						Regs[Z] = Regs[C];
-						Regs[W] = Regs[B];
-						INC16_Func(Z, W);
-						DEC8_Func(B);
-
-						// take care of other flags
-						// taken from 'undocumented z80 documented' and Fuse
-						FlagNset((Regs[ALU] & 0x80) > 0);
-						FlagHset(((Regs[ALU] + Regs[C] + 1) & 0xFF) < Regs[ALU]);
-						FlagCset(((Regs[ALU] + Regs[C] + 1) & 0xFF) < Regs[ALU]);
-						FlagPset(TableParity[((Regs[ALU] + Regs[C] + 1) & 7) ^ Regs[B]]);
-					}
+				Ztemp4 = cur_instr_ofst[instr_pntr++];
+				if (Ztemp4 == DEC16)
+				{
+					Regs[Z] = Regs[C];
+					Regs[W] = Regs[B];
+					DEC16_Func(Z, W);
+					DEC8_Func(B);
 
-					Ztemp1 = cur_instr_ofst[instr_pntr++];
-					Ztemp2 = cur_instr_ofst[instr_pntr++];
-					Ztemp3 = cur_instr_ofst[instr_pntr++];
+					// take care of other flags
+					// taken from 'undocumented z80 documented' and Fuse
+					FlagNset((Regs[ALU] & 0x80) > 0);
+					FlagHset(((Regs[ALU] + Regs[C] - 1) & 0xFF) < Regs[ALU]);
+					FlagCset(((Regs[ALU] + Regs[C] - 1) & 0xFF) < Regs[ALU]);
+					FlagPset(TableParity[((Regs[ALU] + Regs[C] - 1) & 7) ^ Regs[B]]);
+				}
+				else
+				{
+					Regs[Z] = Regs[C];
+					Regs[W] = Regs[B];
+					INC16_Func(Z, W);
+					DEC8_Func(B);
 
-					if ((Regs[B] != 0) && (Ztemp3 > 0))
-					{
-						cur_instr_ofst = &REP_OP_I_INST[0];
-						cur_instr_ofst[8] = Ztemp2; Ztemp2_saver = Ztemp2;
-						cur_bus_ofst = &REP_OP_I_BUSRQ[0];
-						cur_mem_ofst = &REP_OP_I_MEMRQ[0];
-						cur_irqs_ofst = &REP_OP_I_IRQS;
+					// take care of other flags
+					// taken from 'undocumented z80 documented' and Fuse
+					FlagNset((Regs[ALU] & 0x80) > 0);
+					FlagHset(((Regs[ALU] + Regs[C] + 1) & 0xFF) < Regs[ALU]);
+					FlagCset(((Regs[ALU] + Regs[C] + 1) & 0xFF) < Regs[ALU]);
+					FlagPset(TableParity[((Regs[ALU] + Regs[C] + 1) & 7) ^ Regs[B]]);
+				}
 
-						instr_bank = 9;
+				Ztemp1 = cur_instr_ofst[instr_pntr++];
+				Ztemp2 = cur_instr_ofst[instr_pntr++];
+				Ztemp3 = cur_instr_ofst[instr_pntr++];
 
-						instr_pntr = mem_pntr = bus_pntr = irq_pntr = 0;
-						I_skip = true;
-					}
-					else
-					{
-						if (Ztemp2 == INC16) { INC16_Func(L, H); }
-						else { DEC16_Func(L, H); }
-					}
-					break;
-				case REP_OP_O:
-					OUT_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
-					instr_pntr += 3;
+				if ((Regs[B] != 0) && (Ztemp3 > 0))
+				{
+					cur_instr_ofst = &REP_OP_I_INST[0];
+					cur_instr_ofst[8] = Ztemp2; Ztemp2_saver = Ztemp2;
+					cur_bus_ofst = &REP_OP_I_BUSRQ[0];
+					cur_mem_ofst = &REP_OP_I_MEMRQ[0];
+					cur_irqs_ofst = &REP_OP_I_IRQS;
 
-					Ztemp4 = cur_instr_ofst[instr_pntr++];
-					if (Ztemp4 == DEC16)
-					{
-						DEC16_Func(L, H);
-						DEC8_Func(B);
-						Regs[Z] = Regs[C];
-						Regs[W] = Regs[B];
-						DEC16_Func(Z, W);
-					}
-					else
-					{
-						INC16_Func(L, H);
-						DEC8_Func(B);
-						Regs[Z] = Regs[C];
-						Regs[W] = Regs[B];
-						INC16_Func(Z, W);
-					}
+					instr_bank = 9;
 
-					// take care of other flags
-					// taken from 'undocumented z80 documented'
-					FlagNset((Regs[ALU] & 0x80) > 0);
-					FlagHset((Regs[ALU] + Regs[L]) > 0xFF);
-					FlagCset((Regs[ALU] + Regs[L]) > 0xFF);
-					FlagPset(TableParity[((Regs[ALU] + Regs[L]) & 7) ^ (Regs[B])]);
+					instr_pntr = mem_pntr = bus_pntr = irq_pntr = 0;
+					I_skip = true;
+				}
+				else
+				{
+					if (Ztemp2 == INC16) { INC16_Func(L, H); }
+					else { DEC16_Func(L, H); }
+				}
+				break;
+			case REP_OP_O:
+				OUT_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2]);
+				instr_pntr += 3;
 
-					Ztemp1 = cur_instr_ofst[instr_pntr++];
-					Ztemp2 = cur_instr_ofst[instr_pntr++];
-					Ztemp3 = cur_instr_ofst[instr_pntr++];
+				Ztemp4 = cur_instr_ofst[instr_pntr++];
+				if (Ztemp4 == DEC16)
+				{
+					DEC16_Func(L, H);
+					DEC8_Func(B);
+					Regs[Z] = Regs[C];
+					Regs[W] = Regs[B];
+					DEC16_Func(Z, W);
+				}
+				else
+				{
+					INC16_Func(L, H);
+					DEC8_Func(B);
+					Regs[Z] = Regs[C];
+					Regs[W] = Regs[B];
+					INC16_Func(Z, W);
+				}
 
-					if ((Regs[B] != 0) && (Ztemp3 > 0))
-					{
-						cur_instr_ofst = &REP_OP_O_INST[0];
-						cur_bus_ofst = &REP_OP_O_BUSRQ[0];
-						cur_mem_ofst = &REP_OP_O_MEMRQ[0];
-						cur_irqs_ofst = &REP_OP_O_IRQS;
+				// take care of other flags
+				// taken from 'undocumented z80 documented'
+				FlagNset((Regs[ALU] & 0x80) > 0);
+				FlagHset((Regs[ALU] + Regs[L]) > 0xFF);
+				FlagCset((Regs[ALU] + Regs[L]) > 0xFF);
+				FlagPset(TableParity[((Regs[ALU] + Regs[L]) & 7) ^ (Regs[B])]);
 
-						instr_bank = 10;
+				Ztemp1 = cur_instr_ofst[instr_pntr++];
+				Ztemp2 = cur_instr_ofst[instr_pntr++];
+				Ztemp3 = cur_instr_ofst[instr_pntr++];
 
-						instr_pntr = mem_pntr = bus_pntr = irq_pntr = 0;
-						I_skip = true;
-					}
+				if ((Regs[B] != 0) && (Ztemp3 > 0))
+				{
+					cur_instr_ofst = &REP_OP_O_INST[0];
+					cur_bus_ofst = &REP_OP_O_BUSRQ[0];
+					cur_mem_ofst = &REP_OP_O_MEMRQ[0];
+					cur_irqs_ofst = &REP_OP_O_IRQS;
+
+					instr_bank = 10;
+
+					instr_pntr = mem_pntr = bus_pntr = irq_pntr = 0;
+					I_skip = true;
+				}
+				break;
+			case IORQ:
+				//IRQACKCallback();
+				break;
+			case PREFT_ASGN:
+				if (cur_instr_ofst[instr_pntr++] == IXCBpre)
+				{
+					Regs[W] = Regs[Ixh];
+					Regs[Z] = Regs[Ixl];
+				}
+				else
+				{
+					Regs[W] = Regs[Iyh];
+					Regs[Z] = Regs[Iyl];
+				};
+				break;
+			case PREX_ASGN:
+				PRE_SRC = cur_instr_ofst[instr_pntr++];
+				break;
+			case JP_COND_TR:
+				if (jp_cond_chk)
+				{
+					Read_INC_TR_PC_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2], cur_instr_ofst[instr_pntr + 3]);
+					instr_pntr += 4;
+				}
+				else
+				{
+					// NOTE: Start at 1 since we skip the Z in the instruction vector
+					Read_INC_Func(cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2], cur_instr_ofst[instr_pntr + 3]);
+					instr_pntr += 3;
+				}
+				break;
+			case ASGN_B:
+				Regs[B] = (uint8_t)((Regs[B] - 1) & 0xFF);
+				break;
+			case COND_CHK:
+				checker = false;
+				switch (cur_instr_ofst[instr_pntr++])
+				{
+				case ALWAYS_T:
+					checker = true;
 					break;
-				case IORQ:
-					//IRQACKCallback();
+				case ALWAYS_F:
+					checker = false;
 					break;
-				case PREFT_ASGN:
-					if (cur_instr_ofst[instr_pntr++] == IXCBpre)
-					{
-						Regs[W] = Regs[Ixh];
-						Regs[Z] = Regs[Ixl];
-					}
-					else
-					{
-						Regs[W] = Regs[Iyh];
-						Regs[Z] = Regs[Iyl];
-					};
+				case FLAG_Z:
+					checker = FlagZget();
 					break;
-				case PREX_ASGN:
-					PRE_SRC = cur_instr_ofst[instr_pntr++];
+				case FLAG_NZ:
+					checker = !FlagZget();
 					break;
-				case JP_COND_TR:
-					if (jp_cond_chk)
-					{
-						Read_INC_TR_PC_Func(cur_instr_ofst[instr_pntr], cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2], cur_instr_ofst[instr_pntr + 3]);
-						instr_pntr += 4;
-					}
-					else
-					{
-						// NOTE: Start at 1 since we skip the Z in the instruction vector
-						Read_INC_Func(cur_instr_ofst[instr_pntr + 1], cur_instr_ofst[instr_pntr + 2], cur_instr_ofst[instr_pntr + 3]);
-						instr_pntr += 3;
-					}
+				case FLAG_C:
+					checker = FlagCget();
 					break;
-				case ASGN_B:
-					Regs[B] = (uint8_t)((Regs[B] - 1) & 0xFF);
+				case FLAG_NC:
+					checker = !FlagCget();
 					break;
-				case COND_CHK:
-					checker = false;
-					switch (cur_instr_ofst[instr_pntr++])
-					{
-					case ALWAYS_T:
-						checker = true;
-						break;
-					case ALWAYS_F:
-						checker = false;
-						break;
-					case FLAG_Z:
-						checker = FlagZget();
-						break;
-					case FLAG_NZ:
-						checker = !FlagZget();
-						break;
-					case FLAG_C:
-						checker = FlagCget();
-						break;
-					case FLAG_NC:
-						checker = !FlagCget();
-						break;
-					case FLAG_P:
-						checker = FlagPget();
-						break;
-					case FLAG_NP:
-						checker = !FlagPget();
-						break;
-					case FLAG_S:
-						checker = FlagSget();
-						break;
-					case FLAG_NS:
-						checker = !FlagSget();
-						break;
-					case B_ZERO:
-						checker = (Regs[B] - 1) != 0;
-						break;
-					}
-
-					// true condition is what is representedin the instruction vectors
-					// for false condition, we need to advance the IRQS pointer dependent on which instruction is calling			
-					if (checker)
-					{
-						instr_pntr++;
-					}
-					else
-					{
-						// 0 = DJNZ, 1 = JR COND, 2 = JP COND, 3 = RET COND, 4 = CALL
-						cond_chk_fail = true;
-						cur_irqs_ofst = &False_IRQS[cur_instr_ofst[instr_pntr]];
-						IRQS_cond_offset = cur_instr_ofst[instr_pntr];
-						instr_pntr++;
-					}
-
-					jp_cond_chk = checker;
+				case FLAG_P:
+					checker = FlagPget();
+					break;
+				case FLAG_NP:
+					checker = !FlagPget();
+					break;
+				case FLAG_S:
+					checker = FlagSget();
+					break;
+				case FLAG_NS:
+					checker = !FlagSget();
+					break;
+				case B_ZERO:
+					checker = (Regs[B] - 1) != 0;
 					break;
 				}
 
-				if (I_skip)
+				// true condition is what is representedin the instruction vectors
+				// for false condition, we need to advance the IRQS pointer dependent on which instruction is calling			
+				if (checker)
 				{
-					I_skip = false;
+					instr_pntr++;
 				}
-				else if (++irq_pntr == cur_irqs_ofst[0])
+				else
 				{
-					cond_chk_fail = false;
+					// 0 = DJNZ, 1 = JR COND, 2 = JP COND, 3 = RET COND, 4 = CALL
+					cond_chk_fail = true;
+					cur_irqs_ofst = &False_IRQS[cur_instr_ofst[instr_pntr]];
+					IRQS_cond_offset = cur_instr_ofst[instr_pntr];
+					instr_pntr++;
+				}
 
-					if (EI_pending > 0)
-					{
-						EI_pending--;
-						if (EI_pending == 0) { IFF1 = IFF2 = true; }
-					}
+				jp_cond_chk = checker;
+				break;
+			}
+		}
 
-					// NMI has priority
-					if (nonMaskableInterruptPending)
-					{
-						nonMaskableInterruptPending = false;
+		// The instruction is over: take an interrupt, or start fetching the next instruction
+		inline void EndInstruction()
+		{
+			cond_chk_fail = false;
 
-						if (TraceCallback) { TraceCallback(1); }
+			if (EI_pending > 0)
+			{
+				EI_pending--;
+				if (EI_pending == 0) { IFF1 = IFF2 = true; }
+			}
 
-						IFF2 = IFF1;
-						IFF1 = false;
-						NMI_();
-						//NMICallback();
-						instr_pntr = mem_pntr = bus_pntr = irq_pntr = 0;
+			// NMI has priority
+			if (nonMaskableInterruptPending)
+			{
+				nonMaskableInterruptPending = false;
 
-						temp_R = (Regs[R] & 0x7F);
-						temp_R++;
-						temp_R &= 0x7F;
-						Regs[R] = ((Regs[R] & 0x80) | temp_R);
+				if (TraceCallback) { TraceCallback(1); }
 
-						halted = false;
-					}
-					// if we are processing an interrrupt, we need to modify the instruction vector
-					else if (IFF1 && FlagI)
-					{
-						IFF1 = IFF2 = false;
-						EI_pending = 0;
-
-						if (TraceCallback) { TraceCallback(2); }
-
-						switch (interruptMode)
-						{
-						case 0:
-							// Requires something to be pushed onto the data bus
-							// we'll assume it's a zero for now
-							INTERRUPT_0(0);
-							break;
-						case 1:
-							INTERRUPT_1();
-							break;
-						case 2:
-							INTERRUPT_2();
-							break;
-						}
-						//IRQCallback();
-						instr_pntr = mem_pntr = bus_pntr = irq_pntr = 0;
-
-						temp_R = (Regs[R] & 0x7F);
-						temp_R++;
-						temp_R &= 0x7F;
-						Regs[R] = ((Regs[R] & 0x80) | temp_R);
-
-						halted = false;
-					}
-					// otherwise start a new normal access
-					else if (!halted)
-					{
-						cur_instr_ofst = &NO_HALT_INST[0];
-						cur_bus_ofst = &NO_HALT_BUSRQ[0];
-						cur_mem_ofst = &NO_HALT_MEMRQ[0];
-						cur_irqs_ofst = &NO_HALT_IRQS;
+				IFF2 = IFF1;
+				IFF1 = false;
+				NMI_();
+				//NMICallback();
+				instr_pntr = mem_pntr = bus_pntr = irq_pntr = 0;
 
-						instr_bank = 11;
+				temp_R = (Regs[R] & 0x7F);
+				temp_R++;
+				temp_R &= 0x7F;
+				Regs[R] = ((Regs[R] & 0x80) | temp_R);
 
-						instr_pntr = mem_pntr = bus_pntr = irq_pntr = 0;
-					}
-					else
-					{
-						instr_pntr = mem_pntr = bus_pntr = irq_pntr = 0;
-					}
+				halted = false;
+			}
+			// if we are processing an interrrupt, we need to modify the instruction vector
+			else if (IFF1 && FlagI)
+			{
+				IFF1 = IFF2 = false;
+				EI_pending = 0;
+
+				if (TraceCallback) { TraceCallback(2); }
+
+				switch (interruptMode)
+				{
+				case 0:
+					// Requires something to be pushed onto the data bus
+					// we'll assume it's a zero for now
+					INTERRUPT_0(0);
+					break;
+				case 1:
+					INTERRUPT_1();
+					break;
+				case 2:
+					INTERRUPT_2();
+					break;
 				}
+				//IRQCallback();
+				instr_pntr = mem_pntr = bus_pntr = irq_pntr = 0;
 
-				TotalExecutedCycles++;
+				temp_R = (Regs[R] & 0x7F);
+				temp_R++;
+				temp_R &= 0x7F;
+				Regs[R] = ((Regs[R] & 0x80) | temp_R);
+
+				halted = false;
+			}
+			// otherwise start a new normal access
+			else if (!halted)
+			{
+				cur_instr_ofst = &NO_HALT_INST[0];
+				cur_bus_ofst = &NO_HALT_BUSRQ[0];
+				cur_mem_ofst = &NO_HALT_MEMRQ[0];
+				cur_irqs_ofst = &NO_HALT_IRQS;
+
+				instr_bank = 11;
+
+				instr_pntr = mem_pntr = bus_pntr = irq_pntr = 0;
+			}
+			else
+			{
+				instr_pntr = mem_pntr = bus_pntr = irq_pntr = 0;
 			}
 		}
 
@@ -2691,6 +2769,7 @@ namespace MSXHawk
 				std::memcpy(&NoIndexBUSRQ[i * 19], &BUSRQ, sizeof(uint32_t) * 19);
 				std::memcpy(&NoIndexMEMRQ[i * 19], &MEMRQ, sizeof(uint32_t) * 19);
 				NoIndexIRQS[i] = IRQS;
+				BuildFastSeq(FastSeqs[0][i], cur_instr, 38, IRQS);
 
 				switch (i)
 				{
@@ -2956,6 +3035,7 @@ namespace MSXHawk
 				std::memcpy(&CBIndexBUSRQ[i * 19], &BUSRQ, sizeof(uint32_t) * 19);
 				std::memcpy(&CBIndexMEMRQ[i * 19], &MEMRQ, sizeof(uint32_t) * 19);
 				CBIndexIRQS[i] = IRQS;
+				BuildFastSeq(FastSeqs[1][i], cur_instr, 38, IRQS);
 
 				switch (i)
 				{
@@ -3047,6 +3127,7 @@ namespace MSXHawk
 				std::memcpy(&EXTIndexBUSRQ[i * 19], &BUSRQ, sizeof(uint32_t) * 19);
 				std::memcpy(&EXTIndexMEMRQ[i * 19], &MEMRQ, sizeof(uint32_t) * 19);
 				EXTIndexIRQS[i] = IRQS;
+				BuildFastSeq(FastSeqs[2][i], cur_instr, 38, IRQS);
 
 				switch (i)
 				{
@@ -3312,6 +3393,7 @@ namespace MSXHawk
 				std::memcpy(&IXIndexBUSRQ[i * 19], &BUSRQ, sizeof(uint32_t) * 19);
 				std::memcpy(&IXIndexMEMRQ[i * 19], &MEMRQ, sizeof(uint32_t) * 19);
 				IXIndexIRQS[i] = IRQS;
+				BuildFastSeq(FastSeqs[3][i], cur_instr, 38, IRQS);
 				
 				switch (i)
 				{
@@ -3577,6 +3659,7 @@ namespace MSXHawk
 				std::memcpy(&IYIndexBUSRQ[i * 19], &BUSRQ, sizeof(uint32_t) * 19);
 				std::memcpy(&IYIndexMEMRQ[i * 19], &MEMRQ, sizeof(uint32_t) * 19);
 				IYIndexIRQS[i] = IRQS;
+				BuildFastSeq(FastSeqs[4][i], cur_instr, 38, IRQS);
 
 				switch (i)
 				{
@@ -3842,6 +3925,69 @@ namespace MSXHawk
 				std::memcpy(&IXYCBIndexBUSRQ[i * 19], &BUSRQ, sizeof(uint32_t) * 19);
 				std::memcpy(&IXYCBIndexMEMRQ[i * 19], &MEMRQ, sizeof(uint32_t) * 19);
 				IXYCBIndexIRQS[i] = IRQS;
+				BuildFastSeq(FastSeqs[5][i], cur_instr, 38, IRQS);
+			}
+
+			BuildFastSeq(NoHaltFast, NO_HALT_INST, 4, NO_HALT_IRQS);
+		}
+
+		void BuildFastSeq(FastSeq& seq, uint32_t* instr, uint32_t length, uint32_t irqs)
+		{
+			uint32_t pntr = 0;
+			uint32_t cycle = 1;
+
+			seq.cycles = irqs;
+			seq.num_ops = 0;
+
+			for (; cycle <= irqs; cycle++)
+			{
+				if ((pntr >= length) || (seq.num_ops == 19))
+				{
+					// never happens with the current tables, but leave anything odd to the micro-stepping
+					seq.cycles = 0xFFFFFFFF;
+					return;
+				}
+
+				uint32_t op = instr[pntr];
+
+				if ((op != IDLE) && (op != WAIT))
+				{
+					seq.ofst[seq.num_ops] = (uint8_t)pntr;
+					seq.cycle[seq.num_ops] = (uint8_t)cycle;
+					seq.num_ops++;
+				}
+
+				// these always start a new sequence
+				if ((op == OP_F) || (op == PREFIX))
+				{
+					seq.cycles = cycle;
+					return;
+				}
+
+				pntr += MicroOpLength(op);
+			}
+		}
+
+		// number of words an op takes up in the instruction vector, including itself
+		static uint32_t MicroOpLength(uint32_t op)
+		{
+			switch (op)
+			{
+			case INC8: case DEC8: case RLC: case RL: case RRC: case RR: case CPL: case DA: case SCF: case CCF:
+			case SLA: case SRA: case SRL: case SLL: case NEG: case INT_MODE: case RST: case PREFT_ASGN: case PREX_ASGN:
+				return 2;
+			case TR: case ADD8: case SUB8: case ADC8: case SBC8: case INC16: case DEC16: case AND8: case XOR8: case OR8: case CP8:
+			case BIT: case I_BIT: case RES: case SET: case ASGN: case RRD: case RLD: case SET_FL_IR: case COND_CHK:
+				return 3;
+			case RD: case WR: case RD_INC: case WR_INC: case WR_DEC: case WR_TR_PC: case WR_INC_WA:
+			case OUT: case OUT_INC: case IN: case IN_INC: case IN_A_N_INC: case SET_FL_LD_R: case SET_FL_CP_R:
+				return 4;
+			case RD_INC_TR_PC: case TR16: case ADD16: case ADC16: case SBC16: case EXCH_16: case ADDS: case JP_COND_TR:
+				return 5;
+			case RD_OP: case REP_OP_I: case REP_OP_O:
+				return 8;
+			default:
+				return 1;
 			}
 		}
 
@@ -161,7 +161,7 @@ public:
 
 	inline int GetPC() { return mPC; }
 
-	template<bool isReader>void SyncState(NewState *ns);
+	template<bool isReader, class NS>void SyncState(NS *ns);
 
 private:
 	CSystem	&mSystem;
@@ -110,7 +110,7 @@ public:
 	bool GetSaveRamPtr(int &size, uint8 *&data);
 	void GetReadOnlyPtrs(int &s0, uint8 *&p0, int &s1, uint8 *&p1);
 
-	template<bool isReader>void SyncState(NewState *ns);
+	template<bool isReader, class NS>void SyncState(NS *ns);
 
 private:
 	EMMODE	mBank;
@@ -80,7 +80,7 @@ class CMemMap : public CLynxBase
 		uint32	WriteCycle(void) {return 5;};
 		uint32	ObjectSize(void) {return MEMMAP_SIZE;};
 
-		template<bool isReader>void SyncState(NewState *ns);
+		template<bool isReader, class NS>void SyncState(NS *ns);
 
 	// Data members
 
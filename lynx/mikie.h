@@ -220,7 +220,7 @@ public:
 	uint32		mpDisplayCurrentLine;
 	uint32		framebuffer[SCREEN_WIDTH * SCREEN_HEIGHT];
 
-	template<bool isReader>void SyncState(NewState *ns);
+	template<bool isReader, class NS>void SyncState(NS *ns);
 
 private:
 	CSystem		&mSystem;
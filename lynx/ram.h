@@ -79,7 +79,7 @@ public:
 	uint32   ObjectSize(void) {return RAM_SIZE;};
 	uint8*	GetRamPointer(void) { return mRamData; };
 
-	template<bool isReader>void SyncState(NewState *ns);
+	template<bool isReader, class NS>void SyncState(NS *ns);
 
 	// Data members
 
@@ -67,7 +67,7 @@ public:
 	uint32	WriteCycle(void) {return 5;}
 	uint32	ObjectSize(void) {return ROM_SIZE;}
 
-	template<bool isReader>void SyncState(NewState *ns);
+	template<bool isReader, class NS>void SyncState(NS *ns);
 
 	// Data members
 
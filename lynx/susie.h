@@ -329,7 +329,7 @@ class CSusie : public CLynxBase
 		uint32	PaintSprites(void);
 		bool lagged; // set to false whenever joystick/switches are read
 
-		template<bool isReader>void SyncState(NewState *ns);
+		template<bool isReader, class NS>void SyncState(NS *ns);
 
 	private:
 		void	DoMathDivide(void);
@@ -225,7 +225,7 @@ public:
 	// video dest
 	uint32 *videobuffer;
 
-	template<bool isReader>void SyncState(NewState *ns);
+	template<bool isReader, class NS>void SyncState(NS *ns);
 };
 
 #endif
@@ -42,6 +42,11 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <fcntl.h>
+#elif defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <io.h>
 #endif
 
 // Some really bad preprocessor abuse follows to handle platforms that don't have fseeko and ftello...and of course
@@ -197,6 +202,31 @@ uint8 *FileStream::map(void) noexcept
    madvise(mapping, mapping_size, MADV_SEQUENTIAL | MADV_WILLNEED);
    #endif
   }
+#elif defined(_WIN32)
+  // Read-only only; the mapping object can be closed right away, as the view holds its own reference.
+  if(OpenedMode == MODE_READ)
+  {
+   uint64 length = size();
+   HANDLE fh = (HANDLE)_get_osfhandle(_fileno(fp));
+   HANDLE mh;
+
+   if(!length || length > SIZE_MAX || fh == INVALID_HANDLE_VALUE)
+    return(NULL);
+
+   mh = CreateFileMappingW(fh, NULL, PAGE_READONLY, 0, 0, NULL);
+   if(mh)
+   {
+    void* tptr = MapViewOfFile(mh, FILE_MAP_READ, 0, 0, 0);
+
+    CloseHandle(mh);
+
+    if(tptr)
+    {
+     mapping = tptr;
+     mapping_size = length;
+    }
+   }
+  }
 #endif
  }
 
@@ -214,6 +244,8 @@ void FileStream::unmap(void) noexcept
  {
 #ifdef HAVE_MMAP
   munmap(mapping, mapping_size);
+#elif defined(_WIN32)
+  UnmapViewOfFile(mapping);
 #endif
   mapping = NULL;
   mapping_size = 0;
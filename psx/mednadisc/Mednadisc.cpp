@@ -3,11 +3,22 @@
 #include "Mednadisc.h"
 
 #include "error.h"
+#include "endian.h"
 
 #include "cdrom/CDAccess.h"
 #include "cdrom/CDUtility.h"
 #include "cdrom/cdromif.h"
 #include "cdrom/CDAccess_Image.h"
+#include "cdrom/dvdisaster.h"
+
+#include "hash/crc.h"
+#include "hash/sha1.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 
 class MednaDisc
@@ -19,6 +30,7 @@ public:
 	}
 	CDAccess* disc;
 	CDUtility::TOC toc;
+	std::string path; //kept so verification workers can open their own CDAccess
 };
 
 EW_EXPORT void* mednadisc_LoadCD(const char* fname)
@@ -33,6 +45,7 @@ EW_EXPORT void* mednadisc_LoadCD(const char* fname)
 
 	MednaDisc* md = new MednaDisc();
 	md->disc = disc;
+	md->path = fname;
 	disc->Read_TOC(&md->toc);
 	return md;
 }
@@ -75,6 +88,277 @@ EW_EXPORT int32 mednadisc_ReadSector(MednaDisc* md, int lba, void* buf2448)
 	return 1;
 }
 
+namespace
+{
+	enum
+	{
+		VERIFY_AUDIO,
+		VERIFY_NO_EDC, //mode 0, or mode 2 form 2 with the optional EDC left blank
+		VERIFY_EDC_OK,
+		VERIFY_CORRECTED,
+		VERIFY_BAD,
+		VERIFY_READ_ERROR,
+	};
+
+	//sectors handed to a worker at a time; also the hashing granularity
+	const int32 kVerifyChunkSectors = 256;
+	const int32 kRawSectorSize = 2448;
+
+	struct VerifySlot
+	{
+		int32 chunk; //chunk whose sectors are ready in here, or -1
+		std::vector<uint8> data;
+		std::vector<uint8> status;
+	};
+
+	struct VerifyJob
+	{
+		int32 lba_start, lba_end;
+		int32 nchunks;
+		bool data_track[101];
+		int32 track_end[101];
+
+		std::mutex lock;
+		std::condition_variable cv;
+		int32 next_chunk;
+		int32 consumed;
+		std::vector<VerifySlot> slots;
+	};
+}
+
+static uint8 VerifySector(uint8* buf, bool data_track)
+{
+	static const uint8 sync[12] = { 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00 };
+
+	if(!data_track)
+		return VERIFY_AUDIO;
+
+	if(memcmp(buf, sync, sizeof(sync)))
+		return VERIFY_BAD;
+
+	const uint8 mode = buf[15];
+	bool xa;
+
+	if(mode == 1)
+		xa = false;
+	else if(mode == 2)
+	{
+		//form 2 carries no ECC, and its EDC is optional
+		if(buf[18] & 0x20)
+		{
+			const uint32 stored = MDFN_de32lsb(&buf[2348]);
+
+			if(!stored)
+				return VERIFY_NO_EDC;
+
+			return (EDCCrc32(buf + 16, 2332) == stored) ? VERIFY_EDC_OK : VERIFY_BAD;
+		}
+		xa = true;
+	}
+	else
+		return VERIFY_NO_EDC;
+
+	if(CDUtility::edc_check(buf, xa))
+		return VERIFY_EDC_OK;
+
+	//L-EC corrects in place; keep the image's bytes intact for hashing
+	uint8 tmp[2352];
+	memcpy(tmp, buf, sizeof(tmp));
+
+	return CDUtility::edc_lec_check_and_correct(tmp, xa) ? VERIFY_CORRECTED : VERIFY_BAD;
+}
+
+static void VerifyWorker(VerifyJob* job, CDAccess* disc)
+{
+	for(;;)
+	{
+		int32 chunk;
+		{
+			std::unique_lock<std::mutex> lk(job->lock);
+			chunk = job->next_chunk++;
+			if(chunk >= job->nchunks)
+				return;
+			//don't run further ahead of the hashing than there are slots
+			job->cv.wait(lk, [&] { return chunk < job->consumed + (int32)job->slots.size(); });
+		}
+
+		VerifySlot& slot = job->slots[chunk % job->slots.size()];
+		const int32 lba0 = job->lba_start + chunk * kVerifyChunkSectors;
+		const int32 count = std::min<int32>(kVerifyChunkSectors, job->lba_end - lba0);
+		int track = 0;
+
+		for(int32 i = 0; i < count; i++)
+		{
+			const int32 lba = lba0 + i;
+			uint8* buf = &slot.data[i * kRawSectorSize];
+
+			while(track < 100 && lba >= job->track_end[track])
+				track++;
+
+			try
+			{
+				disc->Read_Raw_Sector(buf, lba);
+				slot.status[i] = VerifySector(buf, job->data_track[track]);
+			}
+			catch(MDFN_Error &)
+			{
+				memset(buf, 0, kRawSectorSize);
+				slot.status[i] = VERIFY_READ_ERROR;
+			}
+		}
+
+		{
+			std::lock_guard<std::mutex> lk(job->lock);
+			slot.chunk = chunk;
+		}
+		job->cv.notify_all();
+	}
+}
+
+//Reads every sector from the first track to the lead-out, checking EDC (and L-EC when the EDC fails) on data sectors
+//and hashing each track's 2352-byte main channel data in order. Audio tracks go through the same Read_Raw_Sector path
+//as emulation, so compressed audio is decoded by the CDAFReader backends.
+//Sectors are read by a pool of `threads` workers (0 = one per core), each with its own CDAccess so that file handles and
+//audio decoders aren't shared; the calling thread does the hashing.
+//Returns the number of reports written to reports100.
+EW_EXPORT int32 mednadisc_VerifyDisc(MednaDisc* md, int32 threads, MednaDiscTrackReport* reports100)
+{
+	const CDUtility::TOC &toc = md->toc;
+	VerifyJob job;
+	int32 ntracks = 0;
+
+	for(int t = toc.first_track; t <= toc.last_track; t++)
+	{
+		int32 end = toc.tracks[100].lba;
+		for(int n = t + 1; n <= toc.last_track; n++)
+			if(toc.tracks[n].valid)
+			{
+				end = toc.tracks[n].lba;
+				break;
+			}
+
+		if(!toc.tracks[t].valid || (int32)toc.tracks[t].lba >= end)
+			continue;
+
+		MednaDiscTrackReport& r = reports100[ntracks];
+		memset(&r, 0, sizeof(r));
+		r.track = t;
+		r.lba = toc.tracks[t].lba;
+		r.sectors = end - r.lba;
+		r.is_data = (toc.tracks[t].control & CDUtility::SUBQ_CTRLF_DATA) ? 1 : 0;
+
+		job.data_track[ntracks] = r.is_data != 0;
+		job.track_end[ntracks] = end;
+		ntracks++;
+	}
+
+	if(!ntracks)
+		return 0;
+
+	for(int i = ntracks; i < 101; i++)
+	{
+		job.data_track[i] = false;
+		job.track_end[i] = INT32_MAX;
+	}
+
+	job.lba_start = reports100[0].lba;
+	job.lba_end = reports100[ntracks - 1].lba + reports100[ntracks - 1].sectors;
+	job.nchunks = (job.lba_end - job.lba_start + kVerifyChunkSectors - 1) / kVerifyChunkSectors;
+	job.next_chunk = 0;
+	job.consumed = 0;
+
+	if(threads <= 0)
+		threads = std::max<int32>(1, std::thread::hardware_concurrency());
+	threads = std::min<int32>(threads, job.nchunks);
+
+	//the first worker borrows the disc's own CDAccess; the rest get their own
+	std::vector<CDAccess*> discs(1, md->disc);
+	for(int32 i = 1; i < threads; i++)
+	{
+		try
+		{
+			discs.push_back(CDAccess_Open(md->path, false));
+		}
+		catch(MDFN_Error &)
+		{
+			//make do with the workers we have
+			break;
+		}
+	}
+
+	job.slots.resize(discs.size() * 2);
+	for(VerifySlot& slot : job.slots)
+	{
+		slot.chunk = -1;
+		slot.data.resize(kVerifyChunkSectors * kRawSectorSize);
+		slot.status.resize(kVerifyChunkSectors);
+	}
+
+	//the L-EC tables are built lazily and not thread-safe
+	CDUtility::CDUtility_Init();
+
+	std::vector<std::thread> workers;
+	for(CDAccess* disc : discs)
+		workers.emplace_back(VerifyWorker, &job, disc);
+
+	int track = 0;
+	uint32 crc = 0;
+	sha1_context sha1;
+
+	for(int32 chunk = 0; chunk < job.nchunks; chunk++)
+	{
+		VerifySlot& slot = job.slots[chunk % job.slots.size()];
+		{
+			std::unique_lock<std::mutex> lk(job.lock);
+			job.cv.wait(lk, [&] { return slot.chunk == chunk; });
+		}
+
+		const int32 lba0 = job.lba_start + chunk * kVerifyChunkSectors;
+		const int32 count = std::min<int32>(kVerifyChunkSectors, job.lba_end - lba0);
+
+		for(int32 i = 0; i < count; i++)
+		{
+			const uint8* buf = &slot.data[i * kRawSectorSize];
+			MednaDiscTrackReport& r = reports100[track];
+
+			crc = crc32_update(crc, buf, 2352);
+			sha1.update(buf, 2352);
+
+			switch(slot.status[i])
+			{
+				case VERIFY_EDC_OK: r.edc_ok++; break;
+				case VERIFY_CORRECTED: r.edc_corrected++; break;
+				case VERIFY_BAD: r.edc_bad++; break;
+				case VERIFY_READ_ERROR: r.read_errors++; break;
+			}
+
+			if(lba0 + i + 1 == job.track_end[track])
+			{
+				r.crc32 = crc;
+				sha1.finish(r.sha1);
+				crc = 0;
+				sha1 = sha1_context();
+				track++;
+			}
+		}
+
+		{
+			std::lock_guard<std::mutex> lk(job.lock);
+			slot.chunk = -1;
+			job.consumed++;
+		}
+		job.cv.notify_all();
+	}
+
+	for(std::thread& w : workers)
+		w.join();
+
+	for(size_t i = 1; i < discs.size(); i++)
+		delete discs[i];
+
+	return ntracks;
+}
+
 EW_EXPORT void mednadisc_CloseCD(MednaDisc* md)
 {
 	delete md;
@@ -6,4 +6,20 @@ class MednaDisc;
 
 EW_EXPORT void* mednadisc_LoadCD(const char* fname);
 EW_EXPORT int32 mednadisc_ReadSector(MednaDisc* disc, int lba, void* buf2448);
-EW_EXPORT void mednadisc_CloseCD(MednaDisc* disc);
\ No newline at end of file
+EW_EXPORT void mednadisc_CloseCD(MednaDisc* disc);
+
+struct MednaDiscTrackReport
+{
+	int32 track;
+	int32 lba;           //first sector of the track (index 01)
+	int32 sectors;       //up to the next track or the lead-out
+	int32 is_data;
+	uint32 crc32;        //of the 2352-byte main channel data of all the track's sectors
+	uint8 sha1[20];
+	int32 edc_ok;        //data sectors whose EDC matched as read
+	int32 edc_corrected; //data sectors that matched only after L-EC
+	int32 edc_bad;       //data sectors L-EC couldn't fix (or with no sync pattern)
+	int32 read_errors;   //sectors the image couldn't supply; hashed as zeros
+};
+
+EW_EXPORT int32 mednadisc_VerifyDisc(MednaDisc* disc, int32 threads, MednaDiscTrackReport* reports100);
\ No newline at end of file
@@ -30,6 +30,8 @@
 #include "CDAFReader_SF.h"
 #endif
 
+#include <vector>
+
 CDAFReader::CDAFReader() : LastReadPos(0)
 {
 
@@ -45,6 +47,115 @@ CDAFReader* CDAFR_Null_Open(Stream* fp)
 	return NULL;
 }
 
+// Keeps the most recently used one-second chunks of decoded PCM around.  CD-DA playback seeks a lot(looping, resuming after
+// data reads), and without this every one of those seeks re-decodes from the nearest keyframe.
+class CDAFReader_Cache final : public CDAFReader
+{
+ public:
+ CDAFReader_Cache(CDAFReader* reader);
+ virtual ~CDAFReader_Cache() override;
+
+ virtual uint64 FrameCount(void) override;
+
+ private:
+ virtual uint64 Read_(int16* buffer, uint64 frames) override;
+ virtual bool Seek_(uint64 frame_offset) override;
+
+ enum : uint64 { ChunkFrames = 588 * 75 };
+ enum : unsigned { ChunkCount = 8 };
+
+ struct Chunk
+ {
+  uint64 index;		// ~0 when unused
+  uint64 frames;	// Less than ChunkFrames only at the end of the stream.
+  uint64 last_use;
+  std::vector<int16> pcm;
+ };
+
+ const Chunk* GetChunk(uint64 index);
+
+ CDAFReader* reader;
+ Chunk chunks[ChunkCount];
+ uint64 use_counter;
+ uint64 pos;
+};
+
+CDAFReader_Cache::CDAFReader_Cache(CDAFReader* r) : reader(r), use_counter(0), pos(0)
+{
+ for(Chunk& c : chunks)
+ {
+  c.index = ~(uint64)0;
+  c.frames = 0;
+  c.last_use = 0;
+ }
+}
+
+CDAFReader_Cache::~CDAFReader_Cache()
+{
+ delete reader;
+}
+
+uint64 CDAFReader_Cache::FrameCount(void)
+{
+ return reader->FrameCount();
+}
+
+bool CDAFReader_Cache::Seek_(uint64 frame_offset)
+{
+ pos = frame_offset;
+ return true;
+}
+
+const CDAFReader_Cache::Chunk* CDAFReader_Cache::GetChunk(uint64 index)
+{
+ Chunk* victim = &chunks[0];
+
+ for(Chunk& c : chunks)
+ {
+  if(c.index == index)
+  {
+   c.last_use = ++use_counter;
+   return &c;
+  }
+
+  if(c.last_use < victim->last_use)
+   victim = &c;
+ }
+
+ // Chunks are filled in order when playback runs straight through, so the wrapped reader only actually seeks on a jump.
+ victim->index = ~(uint64)0;
+ victim->pcm.resize(ChunkFrames * 2);
+ victim->frames = reader->Read(index * ChunkFrames, &victim->pcm[0], ChunkFrames);
+ victim->index = index;
+ victim->last_use = ++use_counter;
+
+ return victim;
+}
+
+uint64 CDAFReader_Cache::Read_(int16* buffer, uint64 frames)
+{
+ uint64 ret = 0;
+
+ while(frames)
+ {
+  const Chunk* c = GetChunk(pos / ChunkFrames);
+  const uint64 offs = pos % ChunkFrames;
+
+  if(offs >= c->frames)
+   break;
+
+  const uint64 count = std::min<uint64>(frames, c->frames - offs);
+
+  memcpy(buffer, &c->pcm[offs * 2], count * 2 * sizeof(int16));
+  buffer += count * 2;
+  frames -= count;
+  pos += count;
+  ret += count;
+ }
+
+ return ret;
+}
+
 CDAFReader *CDAFR_Open(Stream *fp)
 {
  static CDAFReader* (* const OpenFuncs[])(Stream* fp) =
@@ -70,7 +181,10 @@ CDAFReader *CDAFR_Open(Stream *fp)
   try
   {
    fp->rewind();
-   return f(fp);
+
+   CDAFReader* ret = f(fp);
+
+   return ret ? new CDAFReader_Cache(ret) : NULL;
   }
   catch(int i)
   {
@@ -36,6 +36,7 @@ class CDAFReader
 
 // AR_Open(), and CDAFReader, will NOT take "ownership" of the Stream object(IE it won't ever delete it).  Though it does assume it has exclusive access
 // to it for as long as the CDAFReader object exists.
+// The returned reader caches recently decoded PCM, so seeking back into it is cheap.
 CDAFReader *CDAFR_Open(Stream *fp);
 
 #endif
@@ -834,6 +834,16 @@ void CDAccess_Image::ImageOpen(const std::string& path, bool image_memcache)
   if(!Tracks[x].fp && !Tracks[x].AReader)
    throw MDFN_Error(0, _("Missing track %u."), x);
 
+  // Binary tracks are read straight out of a mapping of their file, where the stream can provide one.
+  Tracks[x].MapData = NULL;
+  Tracks[x].MapSize = 0;
+
+  if(!Tracks[x].AReader)
+  {
+   Tracks[x].MapData = Tracks[x].fp->map();
+   Tracks[x].MapSize = Tracks[x].fp->map_size();
+  }
+
   if(Tracks[x].DIFormat == DI_FORMAT_AUDIO)
    Tracks[x].subq_control &= ~SUBQ_CTRLF_DATA;
   else
@@ -983,6 +993,18 @@ CDAccess_Image::~CDAccess_Image()
  Cleanup();
 }
 
+// Reads the next 'len' bytes of a binary track, from the mapping when 'src' points into it, otherwise from the stream.
+static INLINE void ReadTrackData(CDRFILE_TRACK_INFO *ct, const uint8 *&src, uint8 *dest, uint32 len)
+{
+ if(src)
+ {
+  memcpy(dest, src, len);
+  src += len;
+ }
+ else
+  ct->fp->read(dest, len);
+}
+
 void CDAccess_Image::Read_Raw_Sector(uint8 *buf, int32 lba)
 {
   uint8 SimuQ[0xC];
@@ -1091,36 +1113,42 @@ void CDAccess_Image::Read_Raw_Sector(uint8 *buf, int32 lba)
    {
     long SeekPos = ct->FileOffset;
     long LBARelPos = lba - ct->LBA;
+    const uint32 sector_size = DI_Size_Table[ct->DIFormat] + (ct->SubchannelMode ? 96 : 0);
+    const uint8 *src = NULL;
 
     SeekPos += LBARelPos * DI_Size_Table[ct->DIFormat];
 
     if(ct->SubchannelMode)
      SeekPos += 96 * (lba - ct->LBA);
 
-    ct->fp->seek(SeekPos, SEEK_SET);
+    // Sectors running past the end of the mapping go through the stream, so the short read is reported the same way.
+    if(ct->MapData && SeekPos >= 0 && (uint64)SeekPos + sector_size <= ct->MapSize)
+     src = ct->MapData + SeekPos;
+    else
+     ct->fp->seek(SeekPos, SEEK_SET);
 
     switch(ct->DIFormat)
     {
 	case DI_FORMAT_AUDIO:
-		ct->fp->read(buf, 2352);
+		ReadTrackData(ct, src, buf, 2352);
 
 		if(ct->RawAudioMSBFirst)
 		 Endian_A16_Swap(buf, 588 * 2);
 		break;
 
 	case DI_FORMAT_MODE1:
-		ct->fp->read(buf + 12 + 3 + 1, 2048);
+		ReadTrackData(ct, src, buf + 12 + 3 + 1, 2048);
 		encode_mode1_sector(lba + 150, buf);
 		break;
 
 	case DI_FORMAT_MODE1_RAW:
 	case DI_FORMAT_MODE2_RAW:
 	case DI_FORMAT_CDI_RAW:
-		ct->fp->read(buf, 2352);
+		ReadTrackData(ct, src, buf, 2352);
 		break;
 
 	case DI_FORMAT_MODE2:
-		ct->fp->read(buf + 16, 2336);
+		ReadTrackData(ct, src, buf + 16, 2336);
 		encode_mode2_sector(lba + 150, buf);
 		break;
 
@@ -1128,19 +1156,19 @@ void CDAccess_Image::Read_Raw_Sector(uint8 *buf, int32 lba)
 	// FIXME: M2F1, M2F2, does sub-header come before or after user data(standards say before, but I wonder
 	// about cdrdao...).
 	case DI_FORMAT_MODE2_FORM1:
-		ct->fp->read(buf + 24, 2048);
+		ReadTrackData(ct, src, buf + 24, 2048);
 		//encode_mode2_form1_sector(lba + 150, buf);
 		break;
 
 	case DI_FORMAT_MODE2_FORM2:
-		ct->fp->read(buf + 24, 2324);
+		ReadTrackData(ct, src, buf + 24, 2324);
 		//encode_mode2_form2_sector(lba + 150, buf);
 		break;
 
     }
 
     if(ct->SubchannelMode)
-     ct->fp->read(buf + 2352, 96);
+     ReadTrackData(ct, src, buf + 2352, 96);
    }
   } // end if audible part of audio track read.
 }
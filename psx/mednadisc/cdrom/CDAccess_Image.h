@@ -31,6 +31,9 @@ struct CDRFILE_TRACK_INFO
 	uint32 LastSamplePos;
 
 	CDAFReader *AReader;
+
+	const uint8 *MapData;	// fp->map() of a binary track's file, or NULL to go through fp.
+	uint64 MapSize;
 };
 #if 0
 struct Medium_Chunk
@@ -119,12 +119,122 @@ unsigned long  edctable[256] =
  * CDROM EDC calculation
  */
 
-uint32 EDCCrc32(const unsigned char *data, int len)
-{  
- uint32 crc = 0;
-
+static uint32 EDCCrc32_Table(uint32 crc, const unsigned char *data, int len)
+{
  while(len--)
   crc = edctable[(crc ^ *data++) & 0xFF] ^ (crc >> 8);
 
  return crc;
 }
+
+/*
+ * Carry-less multiply folding, as in the PCLMULQDQ crc32 of LibBizHash,
+ * with the fold constants recomputed for the EDC polynomial.
+ * Each 128-bit lane is folded forward until fewer than 16 bytes remain;
+ * the final lane and the tail are then run through the table, which
+ * saves the Barrett reduction step and its constants.
+ */
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define EDC_PCLMUL 1
+
+#include <emmintrin.h>
+#include <wmmintrin.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+static bool EDC_HavePCLMUL(void)
+{
+#ifdef _MSC_VER
+ int regs[4];
+
+ __cpuid(regs, 1);
+
+ return (regs[2] & (1 << 1)) && (regs[3] & (1 << 26));
+#else
+ unsigned int eax, ebx, ecx, edx;
+
+ if(!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+  return false;
+
+ return (ecx & (1 << 1)) && (edx & (1 << 26));
+#endif
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC push_options
+#pragma GCC target("sse2,pclmul")
+#elif defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2,pclmul"))), apply_to=function)
+#endif
+
+static INLINE __m128i EDC_Fold(__m128i x, __m128i k, __m128i next)
+{
+ return _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x01), _mm_clmulepi64_si128(x, k, 0x10)), next);
+}
+
+static uint32 EDCCrc32_PCLMUL(const unsigned char *data, int len)
+{
+ // (x^(4*128+32) mod P), (x^(4*128-32) mod P), bit-reflected and shifted left by one.
+ const __m128i k_fold4 = _mm_set_epi32(0x00000001, 0xf8931102, 0x00000001, 0x2e7928a2);
+ // Same for a distance of one lane: x^(128+32), x^(128-32)
+ const __m128i k_fold1 = _mm_set_epi32(0x00000000, 0x6c90c100, 0x00000001, 0xd5934102);
+ __m128i x0, x1, x2, x3;
+ unsigned char lane[16];
+
+ x0 = _mm_loadu_si128((const __m128i*)(data + 0x00));
+ x1 = _mm_loadu_si128((const __m128i*)(data + 0x10));
+ x2 = _mm_loadu_si128((const __m128i*)(data + 0x20));
+ x3 = _mm_loadu_si128((const __m128i*)(data + 0x30));
+ data += 64;
+ len -= 64;
+
+ while(len >= 64)
+ {
+  x0 = EDC_Fold(x0, k_fold4, _mm_loadu_si128((const __m128i*)(data + 0x00)));
+  x1 = EDC_Fold(x1, k_fold4, _mm_loadu_si128((const __m128i*)(data + 0x10)));
+  x2 = EDC_Fold(x2, k_fold4, _mm_loadu_si128((const __m128i*)(data + 0x20)));
+  x3 = EDC_Fold(x3, k_fold4, _mm_loadu_si128((const __m128i*)(data + 0x30)));
+  data += 64;
+  len -= 64;
+ }
+
+ x0 = EDC_Fold(x0, k_fold1, x1);
+ x0 = EDC_Fold(x0, k_fold1, x2);
+ x0 = EDC_Fold(x0, k_fold1, x3);
+
+ while(len >= 16)
+ {
+  x0 = EDC_Fold(x0, k_fold1, _mm_loadu_si128((const __m128i*)data));
+  data += 16;
+  len -= 16;
+ }
+
+ _mm_storeu_si128((__m128i*)lane, x0);
+
+ return EDCCrc32_Table(EDCCrc32_Table(0, lane, 16), data, len);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC pop_options
+#elif defined(__clang__)
+#pragma clang attribute pop
+#endif
+
+#endif
+
+uint32 EDCCrc32(const unsigned char *data, int len)
+{
+#ifdef EDC_PCLMUL
+ static const bool pclmul = EDC_HavePCLMUL();
+
+ if(pclmul && len >= 64)
+  return EDCCrc32_PCLMUL(data, len);
+#endif
+
+ return EDCCrc32_Table(0, data, len);
+}
@@ -0,0 +1,67 @@
+/* Mednafen - Multi-system Emulator
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "emuware/emuware.h"
+#include "crc.h"
+
+// Slice-by-4 tables for the reflected 0xEDB88320 polynomial.
+static const class CRC32_Tables
+{
+ public:
+ uint32 t[4][256];
+
+ CRC32_Tables()
+ {
+  for(unsigned i = 0; i < 256; i++)
+  {
+   uint32 c = i;
+
+   for(unsigned j = 0; j < 8; j++)
+    c = (c >> 1) ^ ((c & 1) ? 0xEDB88320 : 0);
+
+   t[0][i] = c;
+  }
+
+  for(unsigned i = 0; i < 256; i++)
+  {
+   t[1][i] = (t[0][i] >> 8) ^ t[0][t[0][i] & 0xFF];
+   t[2][i] = (t[1][i] >> 8) ^ t[0][t[1][i] & 0xFF];
+   t[3][i] = (t[2][i] >> 8) ^ t[0][t[2][i] & 0xFF];
+  }
+ }
+} crc32_tables;
+
+uint32 crc32_update(uint32 crc, const void* data, uint64 len)
+{
+ const uint32 (&t)[4][256] = crc32_tables.t;
+ const uint8* p = (const uint8*)data;
+
+ crc = ~crc;
+
+ while(len >= 4)
+ {
+  crc ^= p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32)p[3] << 24);
+  crc = t[3][crc & 0xFF] ^ t[2][(crc >> 8) & 0xFF] ^ t[1][(crc >> 16) & 0xFF] ^ t[0][crc >> 24];
+  p += 4;
+  len -= 4;
+ }
+
+ while(len--)
+  crc = t[0][(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+
+ return ~crc;
+}
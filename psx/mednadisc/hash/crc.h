@@ -0,0 +1,9 @@
+#ifndef __MDFN_HASH_CRC_H
+#define __MDFN_HASH_CRC_H
+
+#include "emuware/emuware.h"
+
+// zlib-compatible CRC-32; start with crc = 0 and feed the result back in to continue.
+uint32 crc32_update(uint32 crc, const void* data, uint64 len);
+
+#endif
@@ -0,0 +1,154 @@
+/* Mednafen - Multi-system Emulator
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "emuware/emuware.h"
+#include "sha1.h"
+
+#include <string.h>
+#include <algorithm>
+
+static INLINE uint32 rol32(uint32 v, unsigned n)
+{
+ return (v << n) | (v >> (32 - n));
+}
+
+static INLINE uint32 load_be32(const uint8* p)
+{
+ return ((uint32)p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3];
+}
+
+sha1_context::sha1_context() : buf_len(0), total_len(0)
+{
+ h[0] = 0x67452301;
+ h[1] = 0xEFCDAB89;
+ h[2] = 0x98BADCFE;
+ h[3] = 0x10325476;
+ h[4] = 0xC3D2E1F0;
+}
+
+void sha1_context::process_block(const uint8* block)
+{
+ uint32 w[80];
+ uint32 a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+
+ for(unsigned i = 0; i < 16; i++)
+  w[i] = load_be32(block + i * 4);
+
+ for(unsigned i = 16; i < 80; i++)
+  w[i] = rol32(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+
+ for(unsigned i = 0; i < 80; i++)
+ {
+  uint32 f, k;
+
+  if(i < 20)
+  {
+   f = (b & c) | (~b & d);
+   k = 0x5A827999;
+  }
+  else if(i < 40)
+  {
+   f = b ^ c ^ d;
+   k = 0x6ED9EBA1;
+  }
+  else if(i < 60)
+  {
+   f = (b & c) | (b & d) | (c & d);
+   k = 0x8F1BBCDC;
+  }
+  else
+  {
+   f = b ^ c ^ d;
+   k = 0xCA62C1D6;
+  }
+
+  const uint32 tmp = rol32(a, 5) + f + e + k + w[i];
+  e = d;
+  d = c;
+  c = rol32(b, 30);
+  b = a;
+  a = tmp;
+ }
+
+ h[0] += a;
+ h[1] += b;
+ h[2] += c;
+ h[3] += d;
+ h[4] += e;
+}
+
+void sha1_context::update(const void* data, uint64 len)
+{
+ const uint8* p = (const uint8*)data;
+
+ total_len += len;
+
+ if(buf_len)
+ {
+  const uint32 n = (uint32)std::min<uint64>(64 - buf_len, len);
+
+  memcpy(buf + buf_len, p, n);
+  buf_len += n;
+  p += n;
+  len -= n;
+
+  if(buf_len < 64)
+   return;
+
+  process_block(buf);
+  buf_len = 0;
+ }
+
+ while(len >= 64)
+ {
+  process_block(p);
+  p += 64;
+  len -= 64;
+ }
+
+ memcpy(buf, p, len);
+ buf_len = len;
+}
+
+void sha1_context::finish(uint8 digest[20])
+{
+ const uint64 bit_len = total_len * 8;
+
+ buf[buf_len++] = 0x80;
+
+ if(buf_len > 56)
+ {
+  memset(buf + buf_len, 0, 64 - buf_len);
+  process_block(buf);
+  buf_len = 0;
+ }
+
+ memset(buf + buf_len, 0, 56 - buf_len);
+
+ for(unsigned i = 0; i < 8; i++)
+  buf[56 + i] = bit_len >> (56 - i * 8);
+
+ process_block(buf);
+
+ for(unsigned i = 0; i < 5; i++)
+ {
+  digest[i * 4 + 0] = h[i] >> 24;
+  digest[i * 4 + 1] = h[i] >> 16;
+  digest[i * 4 + 2] = h[i] >> 8;
+  digest[i * 4 + 3] = h[i] >> 0;
+ }
+}
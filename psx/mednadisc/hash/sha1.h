@@ -0,0 +1,26 @@
+#ifndef __MDFN_HASH_SHA1_H
+#define __MDFN_HASH_SHA1_H
+
+#include "emuware/emuware.h"
+
+// Incremental SHA-1, for data that is hashed piecewise as it is read.
+class sha1_context
+{
+ public:
+
+ sha1_context();
+
+ void update(const void* data, uint64 len);
+ void finish(uint8 digest[20]);
+
+ private:
+
+ void process_block(const uint8* block);
+
+ uint32 h[5];
+ uint8 buf[64];
+ uint32 buf_len;
+ uint64 total_len;
+};
+
+#endif
@@ -19,6 +19,7 @@
 
 #include <string.h>
 #include <assert.h>
+#include <mutex>
 
 #include "dvdisaster.h"
 #include "octoshock.h"
@@ -67,8 +68,6 @@ static uint16 subq_crctab[256] =
 
 static uint8 scramble_table[2352 - 12];
 
-static bool CDUtility_Inited = false;
-
 static void InitScrambleTable(void)
 {
 	unsigned cv = 1;
@@ -92,17 +91,19 @@ static void InitScrambleTable(void)
 	// printf("0x%02x, ", scramble_table[i]);
 }
 
-void CDUtility_Init(void)
+static void InitTables(void)
 {
-	if (!CDUtility_Inited)
-	{
-		#ifdef WANT_LEC_CHECK
-			Init_LEC_Correct();
-			InitScrambleTable();
-		#endif
+	#ifdef WANT_LEC_CHECK
+		Init_LEC_Correct();
+		InitScrambleTable();
+	#endif
+}
 
-		CDUtility_Inited = true;
-	}
+//Safe to call from several threads at once; the tables are shared by all of them.
+void CDUtility_Init(void)
+{
+	static std::once_flag TablesOnce;
+	std::call_once(TablesOnce, InitTables);
 }
 
 
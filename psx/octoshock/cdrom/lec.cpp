@@ -26,6 +26,18 @@
 
 #include "lec.h"
 
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define LEC_SSSE3 1
+
+#include <tmmintrin.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
 #define GF8_PRIM_POLY 0x11d /* x^8 + x^4 + x^3 + x^2 + 1 */
 
 #define EDC_POLY 0x8001801b /* (x^16 + x^15 + x^2 + 1) (x^16 + x^2 + x + 1) */
@@ -58,15 +70,17 @@ public:
   operator const u_int16_t *() const	    { return &table[0][0]; }
 } CF8_Q_COEFFS_RESULTS_01;
 
-static const class CrcTable {
-private:
-  u_int32_t table[256];
+/* Products of the P parity coefficients (rows 19..42 of the table
+ * above) with the low and high nibble of a data byte, laid out for
+ * PSHUFB lookups. Index 0 holds the LSB, index 1 the MSB coefficient.
+ */
+static const class Gf8_P_Nibble_Tables {
 public:
-  CrcTable();
-  ~CrcTable() {}
-  u_int32_t operator[](int i) const	{ return table[i]; }
-  operator const u_int32_t *() const	{ return table;    }
-} CRCTABLE;
+  u_int8_t lo[2][24][16];
+  u_int8_t hi[2][24][16];
+  Gf8_P_Nibble_Tables();
+  ~Gf8_P_Nibble_Tables() {}
+} GF8_P_NIBBLE_TABLES;
 
 static const class ScrambleTable {
 private:
@@ -223,67 +237,30 @@ Gf8_Q_Coeffs_Results_01::Gf8_Q_Coeffs_Results_01()
   }
 }
 
-/* Reverses the bits in 'd'. 'bits' defines the bit width of 'd'.
- */
-static u_int32_t mirror_bits(u_int32_t d, int bits)
-{
-  int i;
-  u_int32_t r = 0;
-
-  for (i = 0; i < bits; i++) {
-    r <<= 1;
-
-    if ((d & 0x1) != 0)
-      r |= 0x1;
-
-    d >>= 1;
-  }
-
-  return r;
-}
-
-/* Build the CRC lookup table for EDC_POLY poly. The CRC is 32 bit wide
- * and reversed (i.e. the bit stream is divided by the EDC_POLY with the
- * LSB first order).
- */
-CrcTable::CrcTable ()
+Gf8_P_Nibble_Tables::Gf8_P_Nibble_Tables()
 {
-  u_int32_t i, j;
-  u_int32_t r;
-  
-  for (i = 0; i < 256; i++) {
-    r = mirror_bits(i, 8);
-
-    r <<= 24;
-
-    for (j = 0; j < 8; j++) {
-      if ((r & 0x80000000) != 0) {
-	r <<= 1;
-	r ^= EDC_POLY;
-      }
-      else {
-	r <<= 1;
-      }
+  int j, n;
+  u_int16_t l, h;
+
+  for (j = 0; j < 24; j++) {
+    for (n = 0; n < 16; n++) {
+      l = CF8_Q_COEFFS_RESULTS_01[19 + j][n];
+      h = CF8_Q_COEFFS_RESULTS_01[19 + j][n << 4];
+
+      lo[0][j][n] = l;
+      lo[1][j][n] = l >> 8;
+      hi[0][j][n] = h;
+      hi[1][j][n] = h >> 8;
     }
-
-    r = mirror_bits(r, 32);
-
-    table[i] = r;
   }
 }
 
-/* Calculates the CRC of given data with given lengths based on the
- * table lookup algorithm.
+/* Calculates the CRC of given data with given lengths; shares the
+ * (possibly PCLMULQDQ accelerated) EDC implementation in crc32.cpp.
  */
 static u_int32_t calc_edc(u_int8_t *data, int len)
 {
-  u_int32_t crc = 0;
-
-  while (len--) {
-    crc = CRCTABLE[(int)(crc ^ *data++) & 0xff] ^ (crc >> 8);
-  }
-
-  return crc;
+  return EDCCrc32(data, len);
 }
 
 /* Build the scramble table as defined in the yellow book. The bytes
@@ -383,6 +360,79 @@ static void set_sector_header(u_int8_t mode, u_int32_t adr, u_int8_t *sector)
   sector[LEC_HEADER_OFFSET + 3] = mode;
 }
 
+#ifdef LEC_SSSE3
+static bool lec_have_ssse3()
+{
+#ifdef _MSC_VER
+  int regs[4];
+
+  __cpuid(regs, 1);
+
+  return (regs[2] & (1 << 9)) != 0;
+#else
+  unsigned int eax, ebx, ecx, edx;
+
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+    return false;
+
+  return (ecx & (1 << 9)) != 0;
+#endif
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC push_options
+#pragma GCC target("ssse3")
+#elif defined(__clang__)
+#pragma clang attribute push (__attribute__((target("ssse3"))), apply_to=function)
+#endif
+
+/* P parity with the GF(2^8) multiplies done 16 bytes at a time.
+ * Every P vector uses the same coefficient per row, so row j of all
+ * 43 vectors (86 contiguous bytes) is multiplied by a constant, which
+ * PSHUFB does as two nibble lookups. The last block overlaps the one
+ * before it; both compute the same bytes there.
+ */
+static void calc_P_parity_ssse3(u_int8_t *sector)
+{
+  static const int offsets[6] = { 0, 16, 32, 48, 64, 2 * 43 - 16 };
+  const Gf8_P_Nibble_Tables &t = GF8_P_NIBBLE_TABLES;
+  const __m128i nibble_mask = _mm_set1_epi8(0x0f);
+  const u_int8_t *p_lsb_start;
+  u_int8_t *p0, *p1;
+  __m128i acc0, acc1, d, dl, dh;
+  int i, j;
+
+  p_lsb_start = sector + LEC_HEADER_OFFSET;
+
+  p1 = sector + LEC_MODE1_P_PARITY_OFFSET;
+  p0 = sector + LEC_MODE1_P_PARITY_OFFSET + 2 * 43;
+
+  for (i = 0; i < 6; i++) {
+    acc0 = acc1 = _mm_setzero_si128();
+
+    for (j = 0; j < 24; j++) {
+      d = _mm_loadu_si128((const __m128i *)(p_lsb_start + j * 2 * 43 + offsets[i]));
+      dl = _mm_and_si128(d, nibble_mask);
+      dh = _mm_and_si128(_mm_srli_epi16(d, 4), nibble_mask);
+
+      acc0 = _mm_xor_si128(acc0, _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)t.lo[0][j]), dl));
+      acc0 = _mm_xor_si128(acc0, _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)t.hi[0][j]), dh));
+      acc1 = _mm_xor_si128(acc1, _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)t.lo[1][j]), dl));
+      acc1 = _mm_xor_si128(acc1, _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)t.hi[1][j]), dh));
+    }
+
+    _mm_storeu_si128((__m128i *)(p0 + offsets[i]), acc0);
+    _mm_storeu_si128((__m128i *)(p1 + offsets[i]), acc1);
+  }
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC pop_options
+#elif defined(__clang__)
+#pragma clang attribute pop
+#endif
+#endif
+
 /* Calculate the P parities for the sector.
  * The 43 P vectors of length 24 are combined with the GF8_P_COEFFS.
  */
@@ -395,6 +445,15 @@ static void calc_P_parity(u_int8_t *sector)
   u_int8_t *p0, *p1;
   u_int8_t d0,d1;
 
+#ifdef LEC_SSSE3
+  static const bool ssse3 = lec_have_ssse3();
+
+  if (ssse3) {
+    calc_P_parity_ssse3(sector);
+    return;
+  }
+#endif
+
   p_lsb_start = sector + LEC_HEADER_OFFSET;
 
   p1 = sector + LEC_MODE1_P_PARITY_OFFSET;
@@ -74,4 +74,7 @@ void lec_encode_mode2_form2_sector(u_int32_t adr, u_int8_t *sector);
  */
 void lec_scramble(u_int8_t *sector);
 
+/* CDROM EDC of 'len' bytes at 'data' (crc32.cpp). */
+u_int32_t EDCCrc32(const unsigned char *data, int len);
+
 #endif
@@ -46,6 +46,97 @@ void NewStateExternalBuffer::Load(void *ptr, size_t size, const char *name)
 	length += size;
 }
 
+NewStateDeltaBuffer::NewStateDeltaBuffer(char *buffer, long maxlength, const char *reference, long refmaxlength)
+	:buffer(buffer), length(0), maxlength(maxlength), reference(reference), reflength(0), refmaxlength(reference ? refmaxlength : 0), badref(false)
+{
+}
+
+void NewStateDeltaBuffer::Save(const void *ptr, size_t size, const char *name)
+{
+	const char *src = static_cast<const char *>(ptr);
+
+	if (size < DeltaMinSize)
+	{
+		if (maxlength - length >= (long)size)
+			std::memcpy(buffer + length, src, size);
+		length += size;
+		reflength += size;
+		return;
+	}
+
+	const size_t nchunks = (size + DeltaChunkSize - 1) / DeltaChunkSize;
+	const long bitmap_length = (long)((nchunks + 7) / 8);
+	const bool bitmap_fits = maxlength - length >= bitmap_length;
+	const bool haveref = reference && refmaxlength - reflength >= (long)size;
+	unsigned char *bitmap = reinterpret_cast<unsigned char *>(buffer + length);
+
+	if (bitmap_fits)
+		std::memset(bitmap, 0, bitmap_length);
+	length += bitmap_length;
+
+	for (size_t i = 0; i < nchunks; i++)
+	{
+		const size_t offs = i * DeltaChunkSize;
+		const size_t n = std::min<size_t>(DeltaChunkSize, size - offs);
+
+		if (haveref && !std::memcmp(src + offs, reference + reflength + offs, n))
+			continue;
+
+		if (bitmap_fits)
+			bitmap[i >> 3] |= 1 << (i & 7);
+		if (maxlength - length >= (long)n)
+			std::memcpy(buffer + length, src + offs, n);
+		length += n;
+	}
+
+	reflength += size;
+}
+
+void NewStateDeltaBuffer::Load(void *ptr, size_t size, const char *name)
+{
+	char *dst = static_cast<char *>(ptr);
+
+	if (size < DeltaMinSize)
+	{
+		if (maxlength - length >= (long)size)
+			std::memcpy(dst, buffer + length, size);
+		length += size;
+		reflength += size;
+		return;
+	}
+
+	const size_t nchunks = (size + DeltaChunkSize - 1) / DeltaChunkSize;
+	const long bitmap_length = (long)((nchunks + 7) / 8);
+	const bool haveref = reference && refmaxlength - reflength >= (long)size;
+	const unsigned char *bitmap = reinterpret_cast<const unsigned char *>(buffer + length);
+
+	if (maxlength - length < bitmap_length)
+	{
+		length += bitmap_length;
+		return;
+	}
+	length += bitmap_length;
+
+	for (size_t i = 0; i < nchunks; i++)
+	{
+		const size_t offs = i * DeltaChunkSize;
+		const size_t n = std::min<size_t>(DeltaChunkSize, size - offs);
+
+		if (bitmap[i >> 3] & (1 << (i & 7)))
+		{
+			if (maxlength - length >= (long)n)
+				std::memcpy(dst + offs, buffer + length, n);
+			length += n;
+		}
+		else if (haveref)
+			std::memcpy(dst + offs, reference + reflength + offs, n);
+		else
+			badref = true;
+	}
+
+	reflength += size;
+}
+
 NewStateExternalFunctions::NewStateExternalFunctions(const FPtrs *ff)
 	:Save_(ff->Save_),
 	Load_(ff->Load_),
@@ -43,6 +43,32 @@ namespace EW
 		virtual void Load(void *ptr, size_t size, const char *name);
 	};
 
+	// Binary state stored as a delta against a reference state of the same layout(one written by NewStateExternalBuffer).
+	// Fields of DeltaMinSize bytes or more (main RAM, VRAM, SPU RAM...) are split into DeltaChunkSize byte chunks, and only the chunks
+	// that differ from the reference are stored, after a bitmap of which ones those are.  Smaller fields are stored as they are.
+	// Saving with no reference stores every chunk, which is the largest a delta can get.
+	class NewStateDeltaBuffer : public NewState
+	{
+	private:
+		char *const buffer;
+		long length;
+		const long maxlength;
+		const char *const reference;
+		long reflength;
+		const long refmaxlength;
+		bool badref;
+	public:
+		enum { DeltaMinSize = 65536, DeltaChunkSize = 4096 };
+
+		NewStateDeltaBuffer(char *buffer, long maxlength, const char *reference, long refmaxlength);
+		long GetLength() { return length; }
+		long GetReferenceLength() { return reflength; }
+		bool Overflow() { return length > maxlength; }
+		bool BadReference() { return badref; } // A chunk had to come from the reference, but it was too short
+		virtual void Save(const void *ptr, size_t size, const char *name);
+		virtual void Load(void *ptr, size_t size, const char *name);
+	};
+
 	struct FPtrs
 	{
 		void (*Save_)(const void *ptr, size_t size, const char *name);
@@ -4,7 +4,6 @@
 #include <stdint.h>
 #include <cstdlib>
 
-#ifdef _MSC_VER
 #define SIZEOF_CHAR sizeof(char)
 #define SIZEOF_SHORT sizeof(short)
 #define SIZEOF_INT sizeof(int)
@@ -14,6 +13,8 @@
 #define SIZEOF_PTRDIFF_T sizeof(void*)
 #define SIZEOF_SIZE_T sizeof(size_t)
 #define SIZEOF_VOID_P sizeof(void*)
+
+#ifdef _MSC_VER
 typedef __int64 s64;
 typedef __int32 s32;
 typedef __int16 s16;
@@ -92,6 +93,8 @@ typedef __uint8_t uint8;
 #if defined(_MSC_VER)
 	#define strncasecmp _strnicmp
 	#define NO_CLONE
+#else
+	#define NO_CLONE __attribute__((noclone))
 #endif
 
 #if defined(_MSC_VER) && _MSC_VER < 1900
@@ -126,7 +129,24 @@ char (*BLAHBLAHBLAH( UNALIGNED T (&)[N] ))[N];
 #endif
 //---------------------------------------------
 
-#ifdef EW_EXPORT
+//------------thread-local macros-------------
+//for the few pointers an export binds to the instance it was handed. initial-exec keeps them a single
+//thread-pointer-relative load even in a -fPIC library, where thread_local would call __tls_get_addr
+#if defined(_MSC_VER)
+#define EW_THREAD __declspec(thread)
+#elif defined(__GNUC__) && defined(__ELF__)
+#define EW_THREAD __thread __attribute__((tls_model("initial-exec")))
+#elif defined(__GNUC__)
+#define EW_THREAD __thread
+#else
+#error 
+#endif
+//---------------------------------------------
+
+#if !defined(_MSC_VER)
+#undef EW_EXPORT
+#define EW_EXPORT extern "C" __attribute__((visibility("default")))
+#elif defined(EW_EXPORT)
 #undef EW_EXPORT
 #define EW_EXPORT extern "C" __declspec(dllexport)
 #else
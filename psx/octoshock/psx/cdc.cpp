@@ -410,7 +410,7 @@ void PS_CDC::ResetTS(void)
 
 void PS_CDC::RecalcIRQ(void)
 {
- IRQ_Assert(IRQ_CD, (bool)(IRQBuffer & (IRQOutTestMask & 0x1F)));
+ IRQ->Assert(IRQ_CD, (bool)(IRQBuffer & (IRQOutTestMask & 0x1F)));
 }
 
 //static int32 doom_ts;
@@ -1156,6 +1156,8 @@ void PS_CDC::HandlePlayRead(void)
 
 pscpu_timestamp_t PS_CDC::Update(const pscpu_timestamp_t timestamp)
 {
+ PSX_PROFILE(PSX_PROF_CDC);
+
  int32 clocks = timestamp - lastts;
 
  if(!Cur_disc)
@@ -1383,6 +1385,8 @@ pscpu_timestamp_t PS_CDC::Update(const pscpu_timestamp_t timestamp)
 
 void PS_CDC::Write(const pscpu_timestamp_t timestamp, uint32 A, uint8 V)
 {
+ PSX_PROFILE(PSX_PROF_CDC);
+
  A &= 0x3;
 
  //printf("Write: %08x %02x\n", A, V);
@@ -1546,6 +1550,8 @@ void PS_CDC::Write(const pscpu_timestamp_t timestamp, uint32 A, uint8 V)
 
 uint8 PS_CDC::Read(const pscpu_timestamp_t timestamp, uint32 A)
 {
+ PSX_PROFILE(PSX_PROF_CDC);
+
  uint8 ret = 0;
 
  A &= 0x03;
@@ -30,12 +30,36 @@
  #define EXP_ILL_CHECK(n) {}
 #endif
 
-//not very organized, is it
-void* g_ShockTraceCallbackOpaque = NULL;
-ShockCallback_Trace g_ShockTraceCallback = NULL;
-ShockCallback_Mem g_ShockMemCallback;
-eShockMemCb g_ShockMemCbType;
-char disasm_buf[128];
+//the GPR an instruction writes, for the binary trace. 0 if none (stores, branches, mult/div, cop writes...)
+static INLINE uint8 TraceDestReg(uint32 instr)
+{
+ const uint32 op = instr >> 26;
+ const uint8 rt = (instr >> 16) & 0x1F;
+ const uint8 rd = (instr >> 11) & 0x1F;
+
+ switch(op)
+ {
+  case 0x00:
+   switch(instr & 0x3F)
+   {
+    case 0x08: case 0x0C: case 0x0D: case 0x11: case 0x13:
+    case 0x18: case 0x19: case 0x1A: case 0x1B:
+     return 0;	// JR, SYSCALL, BREAK, MTHI, MTLO, MULT(U), DIV(U)
+   }
+   return rd;
+
+  case 0x01: return ((rt & 0x1E) == 0x10) ? 31 : 0;	// BLTZAL, BGEZAL
+  case 0x03: return 31;	// JAL
+
+  case 0x10: case 0x11: case 0x12: case 0x13:	// MFCz, CFCz
+   return ((instr >> 21) & 0x1D) == 0x00 ? rt : 0;
+ }
+
+ if((op >= 0x08 && op <= 0x0F) || (op >= 0x20 && op <= 0x26))
+  return rt;
+
+ return 0;
+}
 
 /* TODO
 	Make sure load delays are correct.
@@ -73,7 +97,17 @@ PS_CPU::PS_CPU()
  CPUHook = NULL;
  ADDBT = NULL;
 
- GTE_Init();
+ TraceCallbackOpaque = NULL;
+ TraceCallback = NULL;
+ TraceBuf = NULL;
+ TraceCap = TracePos = 0;
+ TraceFlushOpaque = NULL;
+ TraceFlush = NULL;
+ MemCallback = NULL;
+ MemCbType = (eShockMemCb)0;
+ MemCbPages = NULL;
+
+ GTE.Init();
 
  for(unsigned i = 0; i < 24; i++)
  {
@@ -91,8 +125,59 @@ PS_CPU::PS_CPU()
 
 PS_CPU::~PS_CPU()
 {
+ free(MemCbPages);
+}
+
+INLINE bool PS_CPU::MemCbWatched(unsigned which, uint32 address)
+{
+ return (MemCbPages[which][address >> 17] >> ((address >> 12) & 31)) & 1;
+}
+
+//rebuilds the page bitmaps from a set of inclusive address ranges. with no ranges, every address is watched for each type in cbMask.
+void PS_CPU::SetMemCbRanges(eShockMemCb cbMask, const ShockMemCbRange* ranges, int32 count)
+{
+ static const eShockMemCb types[3] = { eShockMemCb_Read, eShockMemCb_Write, eShockMemCb_Execute };
+
+ if(!cbMask)
+ {
+  free(MemCbPages);
+  MemCbPages = NULL;
+  return;
+ }
+
+ if(!MemCbPages)
+  MemCbPages = (uint32 (*)[(1 << 20) / 32])calloc(3, sizeof(MemCbPages[0]));
+
+ for(unsigned which = 0; which < 3; which++)
+ {
+  uint32* pages = MemCbPages[which];
+
+  memset(pages, 0, sizeof(MemCbPages[which]));
+
+  if(!(cbMask & types[which]))
+   continue;
+
+  if(!ranges)
+  {
+   memset(pages, 0xFF, sizeof(MemCbPages[which]));
+   continue;
+  }
 
+  for(int32 i = 0; i < count; i++)
+  {
+   if(!(ranges[i].type & types[which]) || ranges[i].start > ranges[i].end)
+    continue;
+
+   const uint32 last = ranges[i].end >> 12;
 
+   for(uint32 page = ranges[i].start >> 12; ; page++)
+   {
+    pages[page >> 5] |= 1U << (page & 31);
+    if(page == last)
+     break;
+   }
+  }
+ }
 }
 
 void PS_CPU::SetFastMap(void *region_mem, uint32 region_address, uint32 region_size)
@@ -165,7 +250,7 @@ void PS_CPU::Power(void)
   ICache[i].Data = 0;
  }
 
- GTE_Power();
+ GTE.Power();
 }
 
 void PS_CPU::AssertIRQ(unsigned which, bool asserted)
@@ -304,8 +389,8 @@ INLINE T PS_CPU::ReadMemory(pscpu_timestamp_t &timestamp, uint32 address, bool D
   else
    ret = ScratchRAM.Read<T>(address & 0x3FF);
 
-  if (g_ShockMemCallback && (g_ShockMemCbType & eShockMemCb_Read))
-   g_ShockMemCallback(address, eShockMemCb_Read, DS24 ? 24 : sizeof(T) * 8, ret);
+  if (MemCallback && (MemCbType & eShockMemCb_Read) && MemCbWatched(0, address))
+   MemCallback(address, eShockMemCb_Read, DS24 ? 24 : sizeof(T) * 8, ret);
   return(ret);
  }
 
@@ -335,16 +420,16 @@ INLINE T PS_CPU::ReadMemory(pscpu_timestamp_t &timestamp, uint32 address, bool D
  LDAbsorb = (lts - timestamp);
  timestamp = lts;
 
- if (g_ShockMemCallback && (g_ShockMemCbType & eShockMemCb_Read))
-  g_ShockMemCallback(address, eShockMemCb_Read, DS24 ? 24 : sizeof(T) * 8, ret);
+ if (MemCallback && (MemCbType & eShockMemCb_Read) && MemCbWatched(0, address))
+  MemCallback(address, eShockMemCb_Read, DS24 ? 24 : sizeof(T) * 8, ret);
  return(ret);
 }
 
 template<typename T>
 INLINE void PS_CPU::WriteMemory(pscpu_timestamp_t &timestamp, uint32 address, uint32 value, bool DS24)
 {
-	if (g_ShockMemCallback && (g_ShockMemCbType & eShockMemCb_Write))
-		g_ShockMemCallback(address, eShockMemCb_Write, DS24 ? 24 : sizeof(T) * 8, value);
+	if (MemCallback && (MemCbType & eShockMemCb_Write) && MemCbWatched(1, address))
+		MemCallback(address, eShockMemCb_Write, DS24 ? 24 : sizeof(T) * 8, value);
 
  if(MDFN_LIKELY(!(CP0.SR & 0x10000)))
  {
@@ -494,7 +579,7 @@ uint32 NO_INLINE PS_CPU::Exception(uint32 code, uint32 PC, const uint32 NP, cons
   };
 
   PSX_DBG(PSX_DBG_WARNING, "[CPU] Exception %s(0x%02x) @ PC=0x%08x(NP=0x%08x, BDBT=0x%02x), Instr=0x%08x, IPCache=0x%02x, CAUSE=0x%08x, SR=0x%08x, IRQC_Status=0x%04x, IRQC_Mask=0x%04x\n",
-	exmne[code], code, PC, NP, BDBT, instr, IPCache, CP0.CAUSE, CP0.SR, IRQ_GetRegister(IRQ_GSREG_STATUS, NULL, 0), IRQ_GetRegister(IRQ_GSREG_MASK, NULL, 0));
+	exmne[code], code, PC, NP, BDBT, instr, IPCache, CP0.CAUSE, CP0.SR, IRQ->GetRegister(IRQ_GSREG_STATUS, NULL, 0), IRQ->GetRegister(IRQ_GSREG_MASK, NULL, 0));
  }
 
  if(CP0.SR & (1 << 22))	// BEV
@@ -628,22 +713,46 @@ pscpu_timestamp_t PS_CPU::RunReal(pscpu_timestamp_t timestamp_in)
    //for(int i = 0; i < 32; i++)
    // printf("%02x : %08x\n", i, GPR[i]);
    //printf("\n");
-   if (g_ShockTraceCallback)
+   if (TraceCallback)
    {
 	//_asm int 3;
 	shock_Util_DisassembleMIPS(PC, instr, disasm_buf, ARRAY_SIZE(disasm_buf));
-    g_ShockTraceCallback(NULL, PC, instr, disasm_buf);
+    TraceCallback(NULL, PC, instr, disasm_buf);
    }
 
-   if (g_ShockMemCallback && (g_ShockMemCbType & eShockMemCb_Execute))
-	   g_ShockMemCallback(PC, eShockMemCb_Execute, 32, instr);
+   if (TraceBuf)
+   {
+    ShockTraceRecord* rec;
 
+    if(TracePos)
+    {
+     // The previous instruction has retired by now; a load's value is still in flight in LDValue.
+     rec = &TraceBuf[TracePos - 1];
+     rec->value = (LDWhich == rec->reg) ? LDValue : GPR[rec->reg];
 
-   opf = instr & 0x3F;
+     if(TracePos == TraceCap)
+     {
+      TraceFlush(TraceFlushOpaque, TraceBuf, TracePos);
+      TracePos = 0;
+     }
+    }
 
-   if(instr & (0x3F << 26))
-    opf = 0x40 | (instr >> 26);
+    rec = &TraceBuf[TracePos++];
+    rec->PC = PC;
+    rec->instr = instr;
+    rec->timestamp = timestamp;
+    rec->reg = TraceDestReg(instr);
+   }
 
+   if (MemCallback && (MemCbType & eShockMemCb_Execute) && MemCbWatched(2, PC))
+	   MemCallback(PC, eShockMemCb_Execute, 32, instr);
+
+
+   opf = instr & 0x3F;
+
+   if(instr & (0x3F << 26))
+    opf = 0x40 | (instr >> 26);
+
    opf |= IPCache;
 
    if(ReadAbsorb[ReadAbsorbWhich])
@@ -1181,7 +1290,7 @@ pscpu_timestamp_t PS_CPU::RunReal(pscpu_timestamp_t timestamp_in)
 		 LDAbsorb = 0;
 
 		LDWhich = rt;
-		LDValue = GTE_ReadDR(rd);
+		LDValue = GTE.ReadDR(rd);
 		break;
 
 	 case 0x04:		// MTC2	- Move to Coprocessor
@@ -1190,7 +1299,7 @@ pscpu_timestamp_t PS_CPU::RunReal(pscpu_timestamp_t timestamp_in)
 	        if(timestamp < gte_ts_done)
 	         timestamp = gte_ts_done;
 
-		GTE_WriteDR(rd, val);
+		GTE.WriteDR(rd, val);
 		break;
 
 	 case 0x02:		// CFC2
@@ -1208,7 +1317,7 @@ pscpu_timestamp_t PS_CPU::RunReal(pscpu_timestamp_t timestamp_in)
 		 LDAbsorb = 0;
 
 		LDWhich = rt;
-		LDValue = GTE_ReadCR(rd);
+		LDValue = GTE.ReadCR(rd);
 		break;
 
 	 case 0x06:		// CTC2
@@ -1217,7 +1326,7 @@ pscpu_timestamp_t PS_CPU::RunReal(pscpu_timestamp_t timestamp_in)
  	        if(timestamp < gte_ts_done)
 	         timestamp = gte_ts_done;
 
-		GTE_WriteCR(rd, val);		 
+		GTE.WriteCR(rd, val);		 
 		break;
 
 	 case 0x08:
@@ -1239,7 +1348,7 @@ pscpu_timestamp_t PS_CPU::RunReal(pscpu_timestamp_t timestamp_in)
 
 	        if(timestamp < gte_ts_done)
 	         timestamp = gte_ts_done;
-		gte_ts_done = timestamp + GTE_Instruction(instr);
+		gte_ts_done = timestamp + GTE.Instruction(instr);
 		break;
 	}
     END_OPF;
@@ -1318,7 +1427,7 @@ pscpu_timestamp_t PS_CPU::RunReal(pscpu_timestamp_t timestamp_in)
          if(timestamp < gte_ts_done)
           timestamp = gte_ts_done;
 
-         GTE_WriteDR(rt, ReadMemory<uint32>(timestamp, address, false, true));
+         GTE.WriteDR(rt, ReadMemory<uint32>(timestamp, address, false, true));
 	}
 	// GTE stuff here
     END_OPF;
@@ -1368,7 +1477,7 @@ pscpu_timestamp_t PS_CPU::RunReal(pscpu_timestamp_t timestamp_in)
          if(timestamp < gte_ts_done)
           timestamp = gte_ts_done;
 
-	 WriteMemory<uint32>(timestamp, address, GTE_ReadDR(rt));
+	 WriteMemory<uint32>(timestamp, address, GTE.ReadDR(rt));
 	}
 	DO_LDS();
     END_OPF;
@@ -2426,6 +2535,42 @@ pscpu_timestamp_t PS_CPU::Run(pscpu_timestamp_t timestamp_in, bool BIOSPrintMode
  }
 }
 
+void PS_CPU::FlushBinaryTrace(void)
+{
+ if(!TraceBuf || !TracePos)
+  return;
+
+ ShockTraceRecord* rec = &TraceBuf[TracePos - 1];
+ rec->value = (BACKED_LDWhich == rec->reg) ? BACKED_LDValue : GPR[rec->reg];
+
+ TraceFlush(TraceFlushOpaque, TraceBuf, TracePos);
+ TracePos = 0;
+}
+
+void PS_CPU::SetTraceCallback(void* opaque, void (*callback)(void* opaque, uint32 PC, uint32 inst, const char* msg))
+{
+ TraceCallbackOpaque = opaque;
+ TraceCallback = callback;
+}
+
+void PS_CPU::SetBinaryTrace(ShockTraceRecord* buffer, uint32 capacity, void* opaque, void (*flush)(void* opaque, const ShockTraceRecord* records, uint32 count))
+{
+ FlushBinaryTrace();
+
+ TraceBuf = buffer;
+ TraceCap = capacity;
+ TracePos = 0;
+ TraceFlushOpaque = opaque;
+ TraceFlush = flush;
+}
+
+void PS_CPU::SetMemCb(void (*callback)(uint32 address, eShockMemCb type, uint32 size, uint32 value), eShockMemCb cbMask, const ShockMemCbRange* ranges, int32 count)
+{
+ SetMemCbRanges(cbMask, ranges, count);
+ MemCallback = callback;
+ MemCbType = cbMask;
+}
+
 void PS_CPU::SetCPUHook(void (*cpuh)(const pscpu_timestamp_t timestamp, uint32 pc), void (*addbt)(uint32 from, uint32 to, bool exception))
 {
  ADDBT = addbt;
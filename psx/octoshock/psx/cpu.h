@@ -61,6 +61,10 @@
 
 #include "gte.h"
 
+struct ShockTraceRecord;
+struct ShockMemCbRange;
+enum eShockMemCb : s32;
+
 namespace MDFN_IEN_PSX
 {
 
@@ -97,7 +101,8 @@ class PS_CPU
  void SetBIU(uint32 val);
  uint32 GetBIU(void);
 
- 
+ PS_GTE GTE;
+
 
  private:
 
@@ -197,8 +202,6 @@ class PS_CPU
 
  MultiAccessSizeMem<1024, false> ScratchRAM;
 
- //PS_GTE GTE;
-
  uintptr_t FastMap[1 << (32 - FAST_MAP_SHIFT)];
  uint8 DummyPage[FAST_MAP_PSIZE];
 
@@ -239,6 +242,14 @@ class PS_CPU
  void* debug_GetScratchRAMPtr() { return ScratchRAM.data8; }
  void* debug_GetGPRPtr() { return GPR; }
 
+ // Completes the last binary trace record and hands the pending ones to the frontend.
+ void FlushBinaryTrace(void);
+
+ // Frontend hooks; see shock_SetTraceCallback(), shock_SetBinaryTrace() and shock_SetMemCb().
+ void SetTraceCallback(void* opaque, void (*callback)(void* opaque, uint32 PC, uint32 inst, const char* msg));
+ void SetBinaryTrace(ShockTraceRecord* buffer, uint32 capacity, void* opaque, void (*flush)(void* opaque, const ShockTraceRecord* records, uint32 count));
+ void SetMemCb(void (*callback)(uint32 address, eShockMemCb type, uint32 size, uint32 value), eShockMemCb cbMask, const ShockMemCbRange* ranges, int32 count);
+
  enum
  {
   GSREG_GPR = 0,
@@ -277,6 +288,26 @@ class PS_CPU
  private:
  void (*CPUHook)(const pscpu_timestamp_t timestamp, uint32 pc);
  void (*ADDBT)(uint32 from, uint32 to, bool exception);
+
+ void* TraceCallbackOpaque;
+ void (*TraceCallback)(void* opaque, uint32 PC, uint32 inst, const char* msg);
+ char disasm_buf[128];
+
+ ShockTraceRecord* TraceBuf;
+ uint32 TraceCap, TracePos;
+ void* TraceFlushOpaque;
+ void (*TraceFlush)(void* opaque, const ShockTraceRecord* records, uint32 count);
+
+ void (*MemCallback)(uint32 address, eShockMemCb type, uint32 size, uint32 value);
+ eShockMemCb MemCbType;
+
+ //one bit per 4KB page of the 32-bit address space, for each of read/write/execute.
+ //the memory callback only fires for addresses whose page bit is set, so the frontend isnt called for every access when it only watches a few addresses.
+ //allocated the first time callbacks are turned on, since most instances never use them.
+ uint32 (*MemCbPages)[(1 << 20) / 32];
+
+ bool MemCbWatched(unsigned which, uint32 address);
+ void SetMemCbRanges(eShockMemCb cbMask, const ShockMemCbRange* ranges, int32 count);
 };
 
 }
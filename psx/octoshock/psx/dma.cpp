@@ -48,8 +48,6 @@ enum
  CH_OT = 6,
 };
 
-extern bool GpuFrameForLag;
-
 // RunChannels(128 - whatevercounter);
 //
 // GPU next event, std::max<128, wait_time>, or something similar, for handling FIFO.
@@ -57,47 +55,9 @@ extern bool GpuFrameForLag;
 namespace MDFN_IEN_PSX
 {
 
-static int32 DMACycleCounter;
-
-static uint32 DMAControl;
-static uint32 DMAIntControl;
-static uint8 DMAIntStatus;
-static bool IRQOut;
-
-struct Channel
-{
- uint32 BaseAddr;
- uint32 BlockControl;
- uint32 ChanControl;
-
- //
- //
- //
- uint32 CurAddr;
- uint16 WordCounter; 
-
- //
- //
- int32 ClockCounter;
-};
-
-static Channel DMACH[7];
-static pscpu_timestamp_t lastts;
-
-
 // static const char *PrettyChannelNames[7] = { "MDEC IN", "MDEC OUT", "GPU", "CDC", "SPU", "PIO", "OTC" };
 
-void DMA_Init(void)
-{
-
-}
-
-void DMA_Kill(void)
-{
-
-}
-
-static INLINE void RecalcIRQOut(void)
+INLINE void PS_DMA::RecalcIRQOut(void)
 {
  bool irqo;
 
@@ -106,15 +66,15 @@ static INLINE void RecalcIRQOut(void)
  irqo |= (DMAIntControl >> 15) & 1;
 
  IRQOut = irqo;
- IRQ_Assert(IRQ_DMA, irqo);
+ IRQ->Assert(IRQ_DMA, irqo);
 }
 
-void DMA_ResetTS(void)
+void PS_DMA::ResetTS(void)
 {
  lastts = 0;
 }
 
-void DMA_Power(void)
+void PS_DMA::Power(void)
 {
  lastts = 0;
 
@@ -128,7 +88,7 @@ void DMA_Power(void)
  RecalcIRQOut();
 }
 
-static INLINE bool ChCan(const unsigned ch, const uint32 CRModeCache)
+INLINE bool PS_DMA::ChCan(const unsigned ch, const uint32 CRModeCache)
 {
  switch(ch)
  {
@@ -136,14 +96,14 @@ static INLINE bool ChCan(const unsigned ch, const uint32 CRModeCache)
 	abort();
 
   case CH_MDEC_IN:
-	return(MDEC_DMACanWrite());
+	return(MDEC->DMACanWrite());
 
   case CH_MDEC_OUT:
-	return(MDEC_DMACanRead());
+	return(MDEC->DMACanRead());
   
   case CH_GPU: 
 	if(CRModeCache & 0x1)
-	 return(GPU_DMACanWrite());
+	 return(GPU->DMACanWrite());
 	else
 	 return(true);
 
@@ -161,7 +121,7 @@ static INLINE bool ChCan(const unsigned ch, const uint32 CRModeCache)
  }
 }
 
-static void RecalcHalt(void)
+void PS_DMA::RecalcHalt(void)
 {
  bool Halt = false;
  unsigned ch = 0;
@@ -200,13 +160,13 @@ static void RecalcHalt(void)
  }
 
 #if 0
- if((DMACH[0].WordCounter || (DMACH[0].ChanControl & (1 << 24))) && (DMACH[0].ChanControl & 0x200) /*&& MDEC_DMACanWrite()*/)
+ if((DMACH[0].WordCounter || (DMACH[0].ChanControl & (1 << 24))) && (DMACH[0].ChanControl & 0x200) /*&& MDEC->DMACanWrite()*/)
   Halt = true;
 
- if((DMACH[1].WordCounter || (DMACH[1].ChanControl & (1 << 24))) && (DMACH[1].ChanControl & 0x200) && (DMACH[1].WordCounter || MDEC_DMACanRead()))
+ if((DMACH[1].WordCounter || (DMACH[1].ChanControl & (1 << 24))) && (DMACH[1].ChanControl & 0x200) && (DMACH[1].WordCounter || MDEC->DMACanRead()))
   Halt = true;
 
- if((DMACH[2].WordCounter || (DMACH[2].ChanControl & (1 << 24))) && (DMACH[2].ChanControl & 0x200) && ((DMACH[2].ChanControl & 0x1) && (DMACH[2].WordCounter || GPU_DMACanWrite())))
+ if((DMACH[2].WordCounter || (DMACH[2].ChanControl & (1 << 24))) && (DMACH[2].ChanControl & 0x200) && ((DMACH[2].ChanControl & 0x1) && (DMACH[2].WordCounter || GPU->DMACanWrite())))
   Halt = true;
 
  if((DMACH[3].WordCounter || (DMACH[3].ChanControl & (1 << 24))) && !(DMACH[3].ChanControl & 0x100))
@@ -234,7 +194,7 @@ static void RecalcHalt(void)
 }
 
 
-static INLINE void ChRW(const unsigned ch, const uint32 CRModeCache, uint32 *V, uint32 *offset)
+INLINE void PS_DMA::ChRW(const unsigned ch, const uint32 CRModeCache, uint32 *V, uint32 *offset)
 {
  unsigned extra_cyc_overhead = 0;
 
@@ -246,7 +206,7 @@ static INLINE void ChRW(const unsigned ch, const uint32 CRModeCache, uint32 *V,
 
   case CH_MDEC_IN:
 	  if(CRModeCache & 0x1)
-	   MDEC_DMAWrite(*V);
+	   MDEC->DMAWrite(*V);
 	  else
 	   *V = 0;
 	  break;
@@ -256,14 +216,14 @@ static INLINE void ChRW(const unsigned ch, const uint32 CRModeCache, uint32 *V,
 	  {
 	  }
 	  else
-	   *V = MDEC_DMARead(offset);
+	   *V = MDEC->DMARead(offset);
 	  break;
 
 	case CH_GPU:
 		if(CRModeCache & 0x1)
-			GPU_WriteDMA(*V);
+			GPU->WriteDMA(*V);
 		else
-			*V = GPU_ReadDMA();
+			*V = GPU->ReadDMA();
 		break;
 
   case CH_CDC:
@@ -346,7 +306,7 @@ static INLINE void ChRW(const unsigned ch, const uint32 CRModeCache, uint32 *V,
 // otherwise RecalcHalt() might take the CPU out of a halted state before the end-of-DMA is signaled(especially a problem considering our largeish
 // DMA update timing granularity).
 //
-static INLINE void RunChannelI(const unsigned ch, const uint32 CRModeCache, int32 clocks)
+INLINE void PS_DMA::RunChannelI(const unsigned ch, const uint32 CRModeCache, int32 clocks)
 {
  //const uint32 dc = (DMAControl >> (ch * 4)) & 0xF;
 
@@ -356,7 +316,7 @@ static INLINE void RunChannelI(const unsigned ch, const uint32 CRModeCache, int3
  {
   if(DMACH[ch].WordCounter == 0)	// Begin WordCounter reload.
   {
-   if(!(DMACH[ch].ChanControl & (1 << 24)))	// Needed for the forced-DMA-stop kludge(see DMA_Write()).
+   if(!(DMACH[ch].ChanControl & (1 << 24)))	// Needed for the forced-DMA-stop kludge(see Write()).
     break;
 
    if(!ChCan(ch, CRModeCache))
@@ -376,7 +336,7 @@ static INLINE void RunChannelI(const unsigned ch, const uint32 CRModeCache, int3
      break;
     }
 
-    header = MainRAM.ReadU32(DMACH[ch].CurAddr & 0x1FFFFC);
+    header = MainRAM->ReadU32(DMACH[ch].CurAddr & 0x1FFFFC);
     DMACH[ch].CurAddr = (DMACH[ch].CurAddr + 4) & 0xFFFFFF;
 
     DMACH[ch].WordCounter = header >> 24;
@@ -431,12 +391,12 @@ static INLINE void RunChannelI(const unsigned ch, const uint32 CRModeCache, int3
    }
 
    if(CRModeCache & 0x1)
-    vtmp = MainRAM.ReadU32(DMACH[ch].CurAddr & 0x1FFFFC);
+    vtmp = MainRAM->ReadU32(DMACH[ch].CurAddr & 0x1FFFFC);
 
    ChRW(ch, CRModeCache, &vtmp, &voffs);
 
    if(!(CRModeCache & 0x1))
-    MainRAM.WriteU32((DMACH[ch].CurAddr + (voffs << 2)) & 0x1FFFFC, vtmp);
+    MainRAM->WriteU32((DMACH[ch].CurAddr + (voffs << 2)) & 0x1FFFFC, vtmp);
   }
 
   if(CRModeCache & 0x2)
@@ -463,7 +423,7 @@ static INLINE void RunChannelI(const unsigned ch, const uint32 CRModeCache, int3
   {
    bool ChannelEndTC = false;
 
-   if(!(DMACH[ch].ChanControl & (1 << 24)))	// Needed for the forced-DMA-stop kludge(see DMA_Write()).
+   if(!(DMACH[ch].ChanControl & (1 << 24)))	// Needed for the forced-DMA-stop kludge(see Write()).
     break;
 
    switch((CRModeCache >> 9) & 0x3)
@@ -502,8 +462,14 @@ static INLINE void RunChannelI(const unsigned ch, const uint32 CRModeCache, int3
   DMACH[ch].ClockCounter = 0;
 }
 
-static INLINE void RunChannel(pscpu_timestamp_t timestamp, int32 clocks, int ch)
+INLINE void PS_DMA::RunChannel(pscpu_timestamp_t timestamp, int32 clocks, int ch)
 {
+#ifdef WANT_PSX_PROFILE
+ // DMA transfers are charged to the device on the other end; idle channels aren't worth reading the clock for.
+ static const uint8 ch_prof[7] = { PSX_PROF_MDEC, PSX_PROF_MDEC, PSX_PROF_GPU, PSX_PROF_CDC, PSX_PROF_SPU, PSX_PROF_CPU, PSX_PROF_CPU };
+ PSX_PROFILE((DMACH[ch].WordCounter || (DMACH[ch].ChanControl & (1 << 24))) ? ch_prof[ch] : PSX_PROF_KEEP);
+#endif
+
  // Mask out the bits that the DMA controller will modify during the course of operation.
  const uint32 CRModeCache = DMACH[ch].ChanControl &~(0x11 << 24);
 
@@ -567,7 +533,7 @@ static INLINE void RunChannel(pscpu_timestamp_t timestamp, int32 clocks, int ch)
  }
 }
 
-static INLINE int32 CalcNextEvent(int32 next_event)
+INLINE int32 PS_DMA::CalcNextEvent(int32 next_event)
 {
  if(DMACycleCounter < next_event)
   next_event = DMACycleCounter;
@@ -575,14 +541,14 @@ static INLINE int32 CalcNextEvent(int32 next_event)
  return(next_event);
 }
 
-MDFN_FASTCALL pscpu_timestamp_t DMA_Update(const pscpu_timestamp_t timestamp)
+MDFN_FASTCALL pscpu_timestamp_t PS_DMA::Update(const pscpu_timestamp_t timestamp)
 {
 //   uint32 dc = (DMAControl >> (ch * 4)) & 0xF;
  int32 clocks = timestamp - lastts;
  lastts = timestamp;
 
- GPU_Update(timestamp);
- MDEC_Run(clocks);
+ GPU->Update(timestamp);
+ MDEC->Run(clocks);
 
  RunChannel(timestamp, clocks, 0);
  RunChannel(timestamp, clocks, 1);
@@ -614,7 +580,7 @@ static void CheckLinkedList(uint32 addr)
   }
   zoom[addr] = 1;
 
-  uint32 header = MainRAM.ReadU32(addr & 0x1FFFFC);
+  uint32 header = MainRAM->ReadU32(addr & 0x1FFFFC);
 
   addr = header & 0xFFFFFF;
 
@@ -622,7 +588,7 @@ static void CheckLinkedList(uint32 addr)
 }
 #endif
 
-MDFN_FASTCALL void DMA_Write(const pscpu_timestamp_t timestamp, uint32 A, uint32 V)
+MDFN_FASTCALL void PS_DMA::Write(const pscpu_timestamp_t timestamp, uint32 A, uint32 V)
 {
  int ch = (A & 0x7F) >> 4;
 
@@ -632,7 +598,7 @@ MDFN_FASTCALL void DMA_Write(const pscpu_timestamp_t timestamp, uint32 A, uint32
  // FIXME if we ever have "accurate" bus emulation
  V <<= (A & 3) * 8;
 
- DMA_Update(timestamp);
+ Update(timestamp);
 
  if(ch == 7)
  {
@@ -683,7 +649,7 @@ MDFN_FASTCALL void DMA_Write(const pscpu_timestamp_t timestamp, uint32 A, uint32
 	     RunChannel(timestamp, 1, ch);
 	     DMACH[ch].ClockCounter = 0;
 #endif
-	     PSX_WARNING("[DMA] Forced stop for channel %d -- scanline=%d", ch, GPU_GetScanlineNum());
+	     PSX_WARNING("[DMA] Forced stop for channel %d -- scanline=%d", ch, GPU->GetScanlineNum());
 	     //MDFN_DispMessage("[DMA] Forced stop for channel %d", ch);
 	    }
 
@@ -695,7 +661,7 @@ MDFN_FASTCALL void DMA_Write(const pscpu_timestamp_t timestamp, uint32 A, uint32
 	    if(!(OldCC & (1 << 24)) && (V & (1 << 24)))
 	    {
 	     //if(ch == 0 || ch == 1)
-	     // PSX_WARNING("[DMA] Started DMA for channel=%d --- CHCR=0x%08x --- BCR=0x%08x --- scanline=%d", ch, DMACH[ch].ChanControl, DMACH[ch].BlockControl, GPU_GetScanlineNum());
+	     // PSX_WARNING("[DMA] Started DMA for channel=%d --- CHCR=0x%08x --- BCR=0x%08x --- scanline=%d", ch, DMACH[ch].ChanControl, DMACH[ch].BlockControl, GPU->GetScanlineNum());
 
 	     DMACH[ch].WordCounter = 0;
 	     DMACH[ch].ClockCounter = 0;
@@ -719,7 +685,7 @@ MDFN_FASTCALL void DMA_Write(const pscpu_timestamp_t timestamp, uint32 A, uint32
  PSX_SetEventNT(PSX_EVENT_DMA, timestamp + CalcNextEvent(0x10000000));
 }
 
-MDFN_FASTCALL uint32 DMA_Read(const pscpu_timestamp_t timestamp, uint32 A)
+MDFN_FASTCALL uint32 PS_DMA::Read(const pscpu_timestamp_t timestamp, uint32 A)
 {
  int ch = (A & 0x7F) >> 4;
  uint32 ret = 0;
@@ -760,7 +726,7 @@ MDFN_FASTCALL uint32 DMA_Read(const pscpu_timestamp_t timestamp, uint32 A)
 }
 
 
-void DMA_SyncState(bool isReader, EW::NewState *ns)
+void PS_DMA::SyncState(bool isReader, EW::NewState *ns)
 {
   NSS(DMACycleCounter);
   NSS(DMAControl);
@@ -25,18 +25,59 @@
 namespace MDFN_IEN_PSX
 {
 
-MDFN_FASTCALL pscpu_timestamp_t DMA_Update(const pscpu_timestamp_t timestamp);
-MDFN_FASTCALL void DMA_Write(const pscpu_timestamp_t timestamp, uint32 A, uint32 V);
-MDFN_FASTCALL uint32 DMA_Read(const pscpu_timestamp_t timestamp, uint32 A);
+class PS_DMA
+{
+ public:
+
+ void SyncState(bool isReader, EW::NewState *ns);
+
+ MDFN_FASTCALL pscpu_timestamp_t Update(const pscpu_timestamp_t timestamp);
+ MDFN_FASTCALL void Write(const pscpu_timestamp_t timestamp, uint32 A, uint32 V);
+ MDFN_FASTCALL uint32 Read(const pscpu_timestamp_t timestamp, uint32 A);
+
+ void ResetTS(void);
+
+ void Power(void) MDFN_COLD;
+
+ private:
+
+ struct Channel
+ {
+  uint32 BaseAddr;
+  uint32 BlockControl;
+  uint32 ChanControl;
+
+  //
+  //
+  //
+  uint32 CurAddr;
+  uint16 WordCounter; 
+
+  //
+  //
+  int32 ClockCounter;
+ };
 
-void DMA_ResetTS(void);
+ void RecalcIRQOut(void);
+ bool ChCan(const unsigned ch, const uint32 CRModeCache);
+ void RecalcHalt(void);
+ void ChRW(const unsigned ch, const uint32 CRModeCache, uint32 *V, uint32 *offset);
+ void RunChannelI(const unsigned ch, const uint32 CRModeCache, int32 clocks);
+ void RunChannel(pscpu_timestamp_t timestamp, int32 clocks, int ch);
+ int32 CalcNextEvent(int32 next_event);
 
-void DMA_Power(void) MDFN_COLD;
+ int32 DMACycleCounter;
 
-void DMA_Init(void) MDFN_COLD;
-void DMA_Kill(void) MDFN_COLD;
+ uint32 DMAControl;
+ uint32 DMAIntControl;
+ uint8 DMAIntStatus;
+ bool IRQOut;
 
+ Channel DMACH[7];
+ pscpu_timestamp_t lastts;
+};
 
+MDFN_HIDE extern EW_THREAD PS_DMA *DMA;
 
 }
 
@@ -230,7 +230,7 @@ INLINE void FrontIO::DoDSRIRQ(void)
  {
   PSX_FIODBGINFO("[DSR] IRQ");
   istatus = true;
-  IRQ_Assert(IRQ_SIO, true);
+  IRQ->Assert(IRQ_SIO, true);
  }
 }
 
@@ -268,13 +268,13 @@ void FrontIO::Write(pscpu_timestamp_t timestamp, uint32 A, uint32 V)
 	if(V & 0x10)
         {
 	 istatus = false;
-	 IRQ_Assert(IRQ_SIO, false);
+	 IRQ->Assert(IRQ_SIO, false);
 	}
 
 	if(V & 0x40)	// Reset
 	{
 	 istatus = false;
-	 IRQ_Assert(IRQ_SIO, false);
+	 IRQ->Assert(IRQ_SIO, false);
 
 	 ClockDivider = 0;
 	 ReceivePending = false;
@@ -416,8 +416,8 @@ pscpu_timestamp_t FrontIO::Update(pscpu_timestamp_t timestamp)
   {
    //printf("Yay: %d %u\n", i, timestamp);
    irq10_pulse_ts[i] = PSX_EVENT_MAXTS;
-   IRQ_Assert(IRQ_PIO, true);
-   IRQ_Assert(IRQ_PIO, false);
+   IRQ->Assert(IRQ_PIO, true);
+   IRQ->Assert(IRQ_PIO, false);
   }
  }
 
@@ -445,7 +445,7 @@ pscpu_timestamp_t FrontIO::Update(pscpu_timestamp_t timestamp)
       if(Control & 0x400)
       {
        istatus = true;
-       IRQ_Assert(IRQ_SIO, true);
+       IRQ->Assert(IRQ_SIO, true);
       }
      }
     }
@@ -471,7 +471,7 @@ pscpu_timestamp_t FrontIO::Update(pscpu_timestamp_t timestamp)
       if(Control & 0x800)
       {
        istatus = true;
-       IRQ_Assert(IRQ_SIO, true);
+       IRQ->Assert(IRQ_SIO, true);
       }
      }
     }
@@ -683,7 +683,7 @@ SYNCFUNC(FrontIO)
 	//more of this crap....
 	if(isReader)
  {
-  IRQ_Assert(IRQ_SIO, istatus);
+  IRQ->Assert(IRQ_SIO, istatus);
  }
 
 }
@@ -708,8 +708,8 @@ void FrontIO::GPULineHook(const pscpu_timestamp_t timestamp, const pscpu_timesta
   if(irq10_pulse_ts[i] <= timestamp)
   {
    irq10_pulse_ts[i] = PSX_EVENT_MAXTS;
-   IRQ_Assert(IRQ_PIO, true);
-   IRQ_Assert(IRQ_PIO, false);
+   IRQ->Assert(IRQ_PIO, true);
+   IRQ->Assert(IRQ_PIO, false);
   }
  }
 
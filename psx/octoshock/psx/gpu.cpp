@@ -22,6 +22,10 @@
 #pragma GCC optimize ("unroll-loops")
 
 #include <assert.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 #include "psx.h"
 #include "timer.h"
@@ -69,34 +73,21 @@
 namespace MDFN_IEN_PSX
 {
 
-PS_GPU GPU;
+EW_THREAD PS_GPU* GPU = NULL;
 
-namespace PS_GPU_INTERNAL
-{
- #include "gpu_common.inc"
-}
+uint8 PS_GPU::DitherLUT[4][4][512];
+CTEntry PS_GPU::Commands[256];
+
+#include "gpu_common.inc"
 using namespace PS_GPU_INTERNAL;
 
-void GPU_Init(bool pal_clock_and_tv)
+void PS_GPU::InitTables(void)
 {
- static const int8 dither_table[4][4] =
- {
-  { -4,  0, -3,  1 },
-  {  2, -2,  3, -1 },
-  { -3,  1, -4,  0 },
-  {  3, -1,  2, -2 },
- };
-
- HardwarePALType = pal_clock_and_tv;
- //printf("%zu\n", (size_t)((uintptr_t)DitherLUT - (uintptr_t)this));
- //printf("%zu\n", (size_t)((uintptr_t)GPURAM - (uintptr_t)this));
- //
-
  for(int y = 0; y < 4; y++)
   for(int x = 0; x < 4; x++)
    for(int v = 0; v < 512; v++)
    {
-    int value = v + dither_table[y][x];
+    int value = v + DitherTable[y][x];
 
     value >>= 3;
  
@@ -109,6 +100,23 @@ void GPU_Init(bool pal_clock_and_tv)
     DitherLUT[y][x][v] = value;
    }
 
+ memcpy(&Commands[0x00], Commands_00_1F, sizeof(Commands_00_1F));
+ memcpy(&Commands[0x20], Commands_20_3F, sizeof(Commands_20_3F));
+ memcpy(&Commands[0x40], Commands_40_5F, sizeof(Commands_40_5F));
+ memcpy(&Commands[0x60], Commands_60_7F, sizeof(Commands_60_7F));
+ memcpy(&Commands[0x80], Commands_80_FF, sizeof(Commands_80_FF));
+}
+
+PS_GPU::PS_GPU(bool pal_clock_and_tv)
+{
+ static std::once_flag TablesOnce;
+
+ std::call_once(TablesOnce, InitTables);
+
+ GPURAM = new uint16[512][1024];
+
+ HardwarePALType = pal_clock_and_tv;
+
  if(HardwarePALType == false)	// NTSC clock
  {
   GPUClockRatio = 103896; // 65536 * 53693181.818 / (44100 * 768)
@@ -120,16 +128,208 @@ void GPU_Init(bool pal_clock_and_tv)
   hmc_to_visible = 560; 
  }
 
- memcpy(&Commands[0x00], Commands_00_1F, sizeof(Commands_00_1F));
- memcpy(&Commands[0x20], Commands_20_3F, sizeof(Commands_20_3F));
- memcpy(&Commands[0x40], Commands_40_5F, sizeof(Commands_40_5F));
- memcpy(&Commands[0x60], Commands_60_7F, sizeof(Commands_60_7F));
- memcpy(&Commands[0x80], Commands_80_FF, sizeof(Commands_80_FF));
+ //
+ // Everything else is set up by Power(), SetRenderOptions(), and StartFrame(); clear what they don't touch(some of it is saved in save states).
+ //
+ InCmd_CC = 0;
+ memset(InQuad_F3Vertices, 0, sizeof(InQuad_F3Vertices));
+ memset(&InPLine_PrevPoint, 0, sizeof(InPLine_PrevPoint));
+
+ dump_framebuffer = false;
+ espec = NULL;
+ surface = NULL;
+ DisplayRect = NULL;
+ LineWidths = NULL;
+ LineVisFirst = LineVisLast = 0;
+ ShowHOverscan = false;
+ CorrectAspect = false;
+ HVis = HVisOffs = NCABaseW = 0;
+ memset(OutputLUT, 0, sizeof(OutputLUT));
+ FirstLine = 0;
+
+ sl_zero_reached = false;
+ skip = false;
+
+ RenderThreads = 0;
+ RT = NULL;
+}
+
+PS_GPU::~PS_GPU()
+{
+ SetRenderThreads(0);
+
+ delete[] GPURAM;
+ GPURAM = NULL;
 }
 
-void GPU_Kill(void)
+//
+// Threaded rendering of untextured triangles.
+//
+// Jobs go into a ring in submission order, and every worker walks the whole ring, plotting only the spans that land in its own band
+// of GPURAM lines.  Since each line is only ever written by one thread, and in submission order, the result is identical to drawing
+// everything on the emulation thread.  DrawTimeAvail is always updated on the emulation thread(PASS_TIMING), so emulated timing never
+// depends on how far along the workers are.
+//
+enum { RT_MAX_THREADS = 16 };
+enum { RT_RING_SIZE = 1024 };
+
+struct RT_State
 {
+ std::thread Workers[RT_MAX_THREADS];
+ std::atomic<uint64> Done[RT_MAX_THREADS];	// Number of jobs each worker has completed.
+
+ std::mutex Lock;
+ std::condition_variable WorkCond;
+ std::condition_variable DoneCond;
+
+ uint64 Submitted;
+ bool Quit;
+
+ tri_job Ring[RT_RING_SIZE];
+};
 
+static INLINE int32 RT_BandStart(unsigned band, unsigned count)
+{
+ return (band * 512) / count;
+}
+
+// The workers only plot, and the plotting code only touches GPURAM(and the tri_job's own copy of the drawing environment).
+void PS_GPU::RT_WorkerMain(unsigned band, int32 band_y0, int32 band_y1)
+{
+ RT_State* const rt = RT;
+ uint64 done = rt->Done[band].load();
+
+ for(;;)
+ {
+  uint64 submitted;
+
+  {
+   std::unique_lock<std::mutex> lock(rt->Lock);
+
+   rt->WorkCond.wait(lock, [&]{ return rt->Quit || rt->Submitted != done; });
+
+   if(rt->Submitted == done)	// Only quit once the ring is drained.
+    return;
+
+   submitted = rt->Submitted;
+  }
+
+  while(done != submitted)
+  {
+   const tri_job& job = rt->Ring[done % RT_RING_SIZE];
+
+   (this->*job.func)(job, band_y0, band_y1);
+   done++;
+  }
+
+  {
+   std::unique_lock<std::mutex> lock(rt->Lock);
+
+   rt->Done[band].store(done);
+  }
+  rt->DoneCond.notify_all();
+ }
+}
+
+void PS_GPU::SetRenderThreads(uint32 count)
+{
+ count = std::min<uint32>(count, RT_MAX_THREADS);
+
+ if(count == RenderThreads || (count <= 1 && RenderThreads <= 1))
+  return;
+
+ if(RenderThreads > 1)
+ {
+  {
+   std::unique_lock<std::mutex> lock(RT->Lock);
+
+   RT->Quit = true;
+  }
+  RT->WorkCond.notify_all();
+
+  for(unsigned i = 0; i < RenderThreads; i++)
+   RT->Workers[i].join();
+
+  delete RT;
+  RT = NULL;
+ }
+
+ RenderThreads = count;
+
+ if(RenderThreads > 1)
+ {
+  RT = new RT_State();
+  RT->Quit = false;
+  RT->Submitted = 0;
+
+  for(unsigned i = 0; i < RenderThreads; i++)
+  {
+   RT->Done[i].store(0);
+   RT->Workers[i] = std::thread(&PS_GPU::RT_WorkerMain, this, i, RT_BandStart(i, RenderThreads), RT_BandStart(i + 1, RenderThreads));
+  }
+ }
+}
+
+void PS_GPU::QueueTri(const tri_job &job)
+{
+ {
+  std::unique_lock<std::mutex> lock(RT->Lock);
+
+  // Wait for the slowest worker to free up the slot.
+  RT->DoneCond.wait(lock, [&]
+  {
+   for(unsigned i = 0; i < RenderThreads; i++)
+    if((RT->Submitted - RT->Done[i].load()) >= RT_RING_SIZE)
+     return false;
+   return true;
+  });
+
+  RT->Ring[RT->Submitted % RT_RING_SIZE] = job;
+  RT->Submitted++;
+ }
+ RT->WorkCond.notify_all();
+}
+
+void PS_GPU::SyncRAMSlow(int32 line)
+{
+ unsigned band_first = 0;
+ unsigned band_last = RenderThreads - 1;
+
+ if(line >= 0)
+ {
+  // 24bpp display readout can run one pixel into the next line, so cover it too.
+  const int32 line_next = (line + 1) & 511;
+
+  band_first = band_last = 0;
+
+  for(unsigned i = 0; i < RenderThreads; i++)
+  {
+   if(line >= RT_BandStart(i, RenderThreads))
+    band_first = i;
+
+   if(line_next >= RT_BandStart(i, RenderThreads))
+    band_last = i;
+  }
+
+  if(band_last < band_first)
+   std::swap(band_first, band_last);
+ }
+
+ auto synced = [&]
+ {
+  for(unsigned i = band_first; i <= band_last; i++)
+   if(RT->Done[i].load() != RT->Submitted)
+    return false;
+  return true;
+ };
+
+ // RT->Submitted is only modified by this(the emulation) thread, so it can be read without the lock.
+ if(synced())
+  return;
+
+ std::unique_lock<std::mutex> lock(RT->Lock);
+
+ RT->DoneCond.wait(lock, synced);
 }
 
 /*
@@ -146,6 +346,8 @@ static const int32 FBWidthNCA = 896;
 
 void PS_GPU::SetRenderOptions(::ShockRenderOptions* opts)
 {
+	SetRenderThreads(opts->renderThreads);
+
 	dump_framebuffer = opts->renderType == eShockRenderType_Framebuffer;
 	ShowHOverscan = !(opts->renderType == eShockRenderType_ClipOverscan);
 	CorrectAspect = true;
@@ -236,23 +438,23 @@ void PS_GPU::SetRenderOptions(::ShockRenderOptions* opts)
 // gi->mouse_offs_y = LineVisFirst;
 //}
 
-static INLINE void InvalidateTexCache(void)
+INLINE void PS_GPU::InvalidateTexCache(void)
 {
  for(auto& c : TexCache)
   c.Tag = ~0U;
 }
 
-static void InvalidateCache(void)
+void PS_GPU::InvalidateCache(void)
 {
  CLUT_Cache_VB = ~0U;
 
  InvalidateTexCache();
 }
 
-static void SoftReset(void) // Control command 0x00
+void PS_GPU::SoftReset(void) // Control command 0x00
 {
  IRQPending = false;
- IRQ_Assert(IRQ_GPU, IRQPending);
+ IRQ->Assert(IRQ_GPU, IRQPending);
 
  InvalidateCache();
 
@@ -317,9 +519,10 @@ static void SoftReset(void) // Control command 0x00
  TexDisableAllowChange = false;
 }
 
-void GPU_Power(void)
+void PS_GPU::Power(void)
 {
- memset(GPURAM, 0, sizeof(GPURAM));
+ SyncRAM();
+ memset(GPURAM, 0, 512 * sizeof(GPURAM[0]));
 
  memset(CLUT_Cache, 0, sizeof(CLUT_Cache));
  CLUT_Cache_VB = ~0U;
@@ -413,17 +616,17 @@ void GPU_Power(void)
 
  SoftReset();
 
- IRQ_Assert(IRQ_VBLANK, InVBlank);
- TIMER_SetVBlank(InVBlank);
+ IRQ->Assert(IRQ_VBLANK, InVBlank);
+ TIMER->SetVBlank(InVBlank);
 }
 
-void GPU_ResetTS(void)
+void PS_GPU::ResetTS(void)
 {
  lastts = 0;
 }
 
 // Special RAM write mode(16 pixels at a time), does *not* appear to use mask drawing environment settings.
-static void Command_FBFill(const uint32 *cb)
+void PS_GPU::Command_FBFill(const uint32 *cb)
 {
  int32 r = cb[0] & 0xFF;
  int32 g = (cb[0] >> 8) & 0xFF;
@@ -457,7 +660,7 @@ static void Command_FBFill(const uint32 *cb)
  }
 }
 
-static void Command_FBCopy(const uint32 *cb)
+void PS_GPU::Command_FBCopy(const uint32 *cb)
 {
  int32 sourceX = (cb[1] >> 0) & 0x3FF;
  int32 sourceY = (cb[1] >> 16) & 0x3FF;
@@ -505,7 +708,7 @@ static void Command_FBCopy(const uint32 *cb)
  }
 }
 
-static void Command_FBWrite(const uint32 *cb)
+void PS_GPU::Command_FBWrite(const uint32 *cb)
 {
  assert(InCmd == PS_GPU::INCMD_NONE);
 
@@ -534,7 +737,7 @@ static void Command_FBWrite(const uint32 *cb)
 // FBRead: PS1 GPU in SCPH-5501 gives odd, inconsistent results when raw_height == 0, or
 // raw_height != 0x200 && (raw_height & 0x1FF) == 0
 //
-static void Command_FBRead(const uint32 *cb)
+void PS_GPU::Command_FBRead(const uint32 *cb)
 {
  assert(InCmd == PS_GPU::INCMD_NONE);
 
@@ -567,7 +770,7 @@ INLINE void PS_GPU::RecalcTexPageStuff(uint32 tpage)
 }
 */
 
-static void SetTPage(const uint32 cmdw)
+void PS_GPU::SetTPage(const uint32 cmdw)
 {
  const unsigned NewTexPageX = (cmdw & 0xF) * 64;
  const unsigned NewTexPageY = (cmdw & 0x10) * 16;
@@ -600,7 +803,7 @@ static void SetTPage(const uint32 cmdw)
  RecalcTexWindowStuff();
 }
 
-static void Command_DrawMode(const uint32 *cb)
+void PS_GPU::Command_DrawMode(const uint32 *cb)
 {
  const uint32 cmdw = *cb;
 
@@ -613,7 +816,7 @@ static void Command_DrawMode(const uint32 *cb)
  //printf("*******************DFE: %d -- scanline=%d\n", dfe, scanline);
 }
 
-static void Command_TexWindow(const uint32 *cb)
+void PS_GPU::Command_TexWindow(const uint32 *cb)
 {
  tww = (*cb & 0x1F);
  twh = ((*cb >> 5) & 0x1F);
@@ -623,7 +826,7 @@ static void Command_TexWindow(const uint32 *cb)
  RecalcTexWindowStuff();
 }
 
-static void Command_Clip0(const uint32 *cb)
+void PS_GPU::Command_Clip0(const uint32 *cb)
 {
  ClipX0 = *cb & 1023;
  ClipY0 = (*cb >> 10) & 1023;
@@ -631,7 +834,7 @@ static void Command_Clip0(const uint32 *cb)
  //fprintf(stderr, "[GPU] Clip0: x=%d y=%d, raw=0x%08x --- %d\n", ClipX0, ClipY0, *cb, scanline);
 }
 
-static void Command_Clip1(const uint32 *cb)
+void PS_GPU::Command_Clip1(const uint32 *cb)
 {
  ClipX1 = *cb & 1023;
  ClipY1 = (*cb >> 10) & 1023;
@@ -639,7 +842,7 @@ static void Command_Clip1(const uint32 *cb)
  //fprintf(stderr, "[GPU] Clip1: x=%d y=%d, raw=0x%08x --- %d\n", ClipX1, ClipY1, *cb, scanline);
 }
 
-static void Command_DrawingOffset(const uint32 *cb)
+void PS_GPU::Command_DrawingOffset(const uint32 *cb)
 {
  OffsX = sign_x_to_s32(11, (*cb & 2047));
  OffsY = sign_x_to_s32(11, ((*cb >> 11) & 2047));
@@ -647,22 +850,22 @@ static void Command_DrawingOffset(const uint32 *cb)
  //fprintf(stderr, "[GPU] Drawing offset: x=%d y=%d, raw=0x%08x --- %d\n", OffsX, OffsY, *cb, scanline);
 }
 
-static void Command_MaskSetting(const uint32 *cb)
+void PS_GPU::Command_MaskSetting(const uint32 *cb)
 {
  //printf("Mask setting: %08x\n", *cb);
  MaskSetOR = (*cb & 1) ? 0x8000 : 0x0000;
  MaskEvalAND = (*cb & 2) ? 0x8000 : 0x0000;
 }
 
-static void Command_ClearCache(const uint32 *cb)
+void PS_GPU::Command_ClearCache(const uint32 *cb)
 {
  InvalidateCache();
 }
 
-static void Command_IRQ(const uint32 *cb)
+void PS_GPU::Command_IRQ(const uint32 *cb)
 {
  IRQPending = true;
- IRQ_Assert(IRQ_GPU, IRQPending);
+ IRQ->Assert(IRQ_GPU, IRQPending);
 }
 
 namespace PS_GPU_INTERNAL
@@ -671,8 +874,8 @@ MDFN_HIDE extern const CTEntry Commands_00_1F[0x20] =
 {
  /* 0x00 */
  NULLCMD(),
- OTHER_HELPER(1, 2, false, Command_ClearCache),
- OTHER_HELPER(3, 3, false, Command_FBFill),
+ OTHER_HELPER(1, 2, false, &PS_GPU::Command_ClearCache),
+ OTHER_HELPER(3, 3, false, &PS_GPU::Command_FBFill),
 
  NULLCMD(), NULLCMD(), NULLCMD(), NULLCMD(), NULLCMD(),
  NULLCMD(), NULLCMD(), NULLCMD(), NULLCMD(), NULLCMD(), NULLCMD(), NULLCMD(), NULLCMD(),
@@ -682,29 +885,29 @@ MDFN_HIDE extern const CTEntry Commands_00_1F[0x20] =
  NULLCMD(), NULLCMD(), NULLCMD(), NULLCMD(), NULLCMD(), NULLCMD(), NULLCMD(),
 
  /* 0x1F */
- OTHER_HELPER(1, 1, false,  Command_IRQ)
+ OTHER_HELPER(1, 1, false,  &PS_GPU::Command_IRQ)
 };
 
 MDFN_HIDE extern const CTEntry Commands_80_FF[0x80] =
 {
  /* 0x80 ... 0x9F */
- OTHER_HELPER_X32(4, 2, false, Command_FBCopy),
+ OTHER_HELPER_X32(4, 2, false, &PS_GPU::Command_FBCopy),
 
  /* 0xA0 ... 0xBF */
- OTHER_HELPER_X32(3, 2, false, Command_FBWrite),
+ OTHER_HELPER_X32(3, 2, false, &PS_GPU::Command_FBWrite),
 
  /* 0xC0 ... 0xDF */
- OTHER_HELPER_X32(3, 2, false, Command_FBRead),
+ OTHER_HELPER_X32(3, 2, false, &PS_GPU::Command_FBRead),
 
  /* 0xE0 */
 
  NULLCMD(),
- OTHER_HELPER(1, 2, false, Command_DrawMode),
- OTHER_HELPER(1, 2, false, Command_TexWindow),
- OTHER_HELPER(1, 1, true,  Command_Clip0),
- OTHER_HELPER(1, 1, true,  Command_Clip1),
- OTHER_HELPER(1, 1, true,  Command_DrawingOffset),
- OTHER_HELPER(1, 2, false, Command_MaskSetting),
+ OTHER_HELPER(1, 2, false, &PS_GPU::Command_DrawMode),
+ OTHER_HELPER(1, 2, false, &PS_GPU::Command_TexWindow),
+ OTHER_HELPER(1, 1, true,  &PS_GPU::Command_Clip0),
+ OTHER_HELPER(1, 1, true,  &PS_GPU::Command_Clip1),
+ OTHER_HELPER(1, 1, true,  &PS_GPU::Command_DrawingOffset),
+ OTHER_HELPER(1, 2, false, &PS_GPU::Command_MaskSetting),
 
  NULLCMD(),
  NULLCMD(), NULLCMD(), NULLCMD(), NULLCMD(), NULLCMD(), NULLCMD(), NULLCMD(), NULLCMD(),
@@ -715,7 +918,17 @@ MDFN_HIDE extern const CTEntry Commands_80_FF[0x80] =
 };
 }
 
-static void ProcessFIFO(void)
+// Untextured triangles are queued to the render threads with their own drawing environment snapshot; every other command that reads
+// or writes GPURAM has to wait for them first.
+static INLINE bool CommandNeedsRAMSync(const uint32 cc)
+{
+ if(cc >= 0x20 && cc <= 0x3F && !(cc & 0x4))
+  return false;
+
+ return cc == 0x02 || (cc >= 0x20 && cc <= 0xDF);
+}
+
+void PS_GPU::ProcessFIFO(void)
 {
  if(!BlitterFIFO.CanRead())
   return;
@@ -737,6 +950,8 @@ static void ProcessFIFO(void)
        {
   	uint32 InData = BlitterFIFO.Read();
 
+	SyncRAM();
+
   	for(int i = 0; i < 2; i++)
   	{
    	 if(!(GPURAM[FBRW_CurY & 511][FBRW_CurX & 1023] & MaskEvalAND))
@@ -776,7 +991,10 @@ static void ProcessFIFO(void)
 	  CB[i] = BlitterFIFO.Read();
 	 }
 
-	 command->func[abr][TexMode | (MaskEvalAND ? 0x4 : 0x0)](CB);
+	 if(CommandNeedsRAMSync(cc))
+	  SyncRAM();
+
+	 (this->*command->func[abr][TexMode | (MaskEvalAND ? 0x4 : 0x0)])(CB);
 	}
 	return;
        }
@@ -806,7 +1024,9 @@ static void ProcessFIFO(void)
 	  CB[i] = BlitterFIFO.Read();
 	 }
 
-	 command->func[abr][TexMode | (MaskEvalAND ? 0x4 : 0x0)](CB);
+	 SyncRAM();
+
+	 (this->*command->func[abr][TexMode | (MaskEvalAND ? 0x4 : 0x0)])(CB);
 	}
 	return;
        }
@@ -855,12 +1075,15 @@ static void ProcessFIFO(void)
   }
   else
   {
-   command->func[abr][TexMode | (MaskEvalAND ? 0x4 : 0x0)](CB);
+   if(CommandNeedsRAMSync(cc))
+    SyncRAM();
+
+   (this->*command->func[abr][TexMode | (MaskEvalAND ? 0x4 : 0x0)])(CB);
   }
  }
 }
 
-static void WriteCB(uint32 InData)
+void PS_GPU::WriteCB(uint32 InData)
 {
  if(BlitterFIFO.CanRead() >= 0x10 && (InCmd != PS_GPU::INCMD_NONE || (BlitterFIFO.CanRead() - 0x10) >= Commands[BlitterFIFO.Peek() >> 24].fifo_fb_len))
  {
@@ -872,8 +1095,10 @@ static void WriteCB(uint32 InData)
  ProcessFIFO();
 }
 
-MDFN_FASTCALL void GPU_Write(const pscpu_timestamp_t timestamp, uint32 A, uint32 V)
+MDFN_FASTCALL void PS_GPU::Write(const pscpu_timestamp_t timestamp, uint32 A, uint32 V)
 {
+ PSX_PROFILE(PSX_PROF_GPU);
+
  V <<= (A & 3) * 8;
 
  if(A & 4)	// GP1 ("Control")
@@ -906,7 +1131,7 @@ MDFN_FASTCALL void GPU_Write(const pscpu_timestamp_t timestamp, uint32 A, uint32
 
    case 0x02: 	// Acknowledge IRQ
 	IRQPending = false;
-	IRQ_Assert(IRQ_GPU, IRQPending);
+	IRQ->Assert(IRQ_GPU, IRQPending);
    	break;
 
    case 0x03:	// Display enable
@@ -990,15 +1215,17 @@ MDFN_FASTCALL void GPU_Write(const pscpu_timestamp_t timestamp, uint32 A, uint32
 }
 
 
-MDFN_FASTCALL void GPU_WriteDMA(uint32 V)
+MDFN_FASTCALL void PS_GPU::WriteDMA(uint32 V)
 {
  WriteCB(V);
 }
 
-static INLINE uint32 ReadData(void)
+INLINE uint32 PS_GPU::ReadData(void)
 {
  if(InCmd == PS_GPU::INCMD_FBREAD)
  {
+  SyncRAM();
+
   DataReadBufferEx = 0;
   for(int i = 0; i < 2; i++)
   {
@@ -1025,13 +1252,15 @@ static INLINE uint32 ReadData(void)
  return DataReadBuffer;
 }
 
-uint32 GPU_ReadDMA(void)
+uint32 PS_GPU::ReadDMA(void)
 {
  return ReadData();
 }
 
-MDFN_FASTCALL uint32 GPU_Read(const pscpu_timestamp_t timestamp, uint32 A)
+MDFN_FASTCALL uint32 PS_GPU::Read(const pscpu_timestamp_t timestamp, uint32 A)
 {
+ PSX_PROFILE(PSX_PROF_GPU);
+
  uint32 ret = 0;
 
  if(A & 4)	// Status
@@ -1059,7 +1288,7 @@ MDFN_FASTCALL uint32 GPU_Read(const pscpu_timestamp_t timestamp, uint32 A)
   if(InCmd == PS_GPU::INCMD_FBREAD)	// Might want to more accurately emulate this in the future?
    ret |= (1 << 27);
 
-  ret |= GPU_CalcFIFOReadyBit() << 28;		// FIFO has room bit? (kinda).
+  ret |= CalcFIFOReadyBit() << 28;		// FIFO has room bit? (kinda).
 
   //
   //
@@ -1102,7 +1331,7 @@ static INLINE uint32 MDFN_NOWARN_UNUSED ShiftHelper(uint32 val, int shamt, uint3
 
 #pragma GCC push_options
 #pragma GCC optimize("no-unroll-loops,no-peel-loops,no-crossjumping")
-static INLINE void ReorderRGB_Var(uint32 out_Rshift, uint32 out_Gshift, uint32 out_Bshift, bool bpp24, const uint16 *src, uint32 *dest, const int32 dx_start, const int32 dx_end, int32 fb_x)
+INLINE void PS_GPU::ReorderRGB_Var(uint32 out_Rshift, uint32 out_Gshift, uint32 out_Bshift, bool bpp24, const uint16 *src, uint32 *dest, const int32 dx_start, const int32 dx_end, int32 fb_x)
 {
      if(bpp24)	// 24bpp
      {
@@ -1139,14 +1368,16 @@ static INLINE void ReorderRGB_Var(uint32 out_Rshift, uint32 out_Gshift, uint32 o
 }
 
 template<uint32 out_Rshift, uint32 out_Gshift, uint32 out_Bshift>
-static NO_INLINE void ReorderRGB(bool bpp24, const uint16 *src, uint32 *dest, const int32 dx_start, const int32 dx_end, int32 fb_x)
+NO_INLINE void PS_GPU::ReorderRGB(bool bpp24, const uint16 *src, uint32 *dest, const int32 dx_start, const int32 dx_end, int32 fb_x)
 {
  ReorderRGB_Var(out_Rshift, out_Gshift, out_Bshift, bpp24, src, dest, dx_start, dx_end, fb_x);
 }
 #pragma GCC pop_options
 
-MDFN_FASTCALL pscpu_timestamp_t GPU_Update(const pscpu_timestamp_t sys_timestamp)
+MDFN_FASTCALL pscpu_timestamp_t PS_GPU::Update(const pscpu_timestamp_t sys_timestamp)
 {
+ PSX_PROFILE(PSX_PROF_GPU);
+
  const uint32 dmc = (DisplayMode & 0x40) ? 4 : (DisplayMode & 0x3);
  const uint32 dmw = HVisMax / DotClockRatios[dmc];	// Must be <= (768 - drxbo)
  const uint32 dmpa = HVisOffs / DotClockRatios[dmc];	// Must be <= drxbo
@@ -1191,27 +1422,27 @@ MDFN_FASTCALL pscpu_timestamp_t GPU_Update(const pscpu_timestamp_t sys_timestamp
   dot_clocks = DotClockCounter / DotClockRatios[DisplayMode & 0x3];
   DotClockCounter -= dot_clocks * DotClockRatios[DisplayMode & 0x3];
 
-  TIMER_AddDotClocks(dot_clocks);
+  TIMER->AddDotClocks(dot_clocks);
 
 
   if(!LineClockCounter)
   {
-   PSX_SetEventNT(PSX_EVENT_TIMER, TIMER_Update(sys_timestamp));  // We could just call this at the top of GPU_Update(), but do it here for slightly less CPU usage(presumably).
+   PSX_SetEventNT(PSX_EVENT_TIMER, TIMER->Update(sys_timestamp));  // We could just call this at the top of GPU_Update(), but do it here for slightly less CPU usage(presumably).
 
    LinePhase = (LinePhase + 1) & 1;
 
    if(LinePhase)
    {
-    TIMER_SetHRetrace(true);
+    TIMER->SetHRetrace(true);
     LineClockCounter = 200;
-    TIMER_ClockHRetrace();
+    TIMER->ClockHRetrace();
    }
    else
    {
     const unsigned int FirstVisibleLine = LineVisFirst + (HardwarePALType ? 20 : 16);
     const unsigned int VisibleLineCount = LineVisLast + 1 - LineVisFirst; //HardwarePALType ? 288 : 240;
 
-    TIMER_SetHRetrace(false);
+    TIMER->SetHRetrace(false);
 
     if(DisplayMode & 0x08)
      LineClockCounter = 3405 - 200;
@@ -1375,8 +1606,8 @@ MDFN_FASTCALL pscpu_timestamp_t GPU_Update(const pscpu_timestamp_t sys_timestamp
      // DisplayFB_CurYOffset = field;
     }
 
-    IRQ_Assert(IRQ_VBLANK, InVBlank);
-    TIMER_SetVBlank(InVBlank);
+    IRQ->Assert(IRQ_VBLANK, InVBlank);
+    TIMER->SetVBlank(InVBlank);
     //
     //
     //
@@ -1437,6 +1668,8 @@ MDFN_FASTCALL pscpu_timestamp_t GPU_Update(const pscpu_timestamp_t sys_timestamp
      }
 
      {
+      SyncRAM(DisplayFB_CurLineYReadout);
+
       const uint16 *src = GPURAM[DisplayFB_CurLineYReadout];
 
       for(int32 x = 0; x < dx_start; x++)
@@ -1486,8 +1719,8 @@ MDFN_FASTCALL pscpu_timestamp_t GPU_Update(const pscpu_timestamp_t sys_timestamp
      DisplayFB_CurYOffset = (DisplayFB_CurYOffset + 1) & 0x1FF;
     }
    }
-   PSX_SetEventNT(PSX_EVENT_TIMER, TIMER_Update(sys_timestamp));  // Mostly so the next event time gets recalculated properly in regards to our calls
-								  // to TIMER_SetVBlank() and TIMER_SetHRetrace().
+   PSX_SetEventNT(PSX_EVENT_TIMER, TIMER->Update(sys_timestamp));  // Mostly so the next event time gets recalculated properly in regards to our calls
+								  // to TIMER->SetVBlank() and TIMER->SetHRetrace().
   }	// end if(!LineClockCounter)
  }	// end while(gpu_clocks > 0)
 
@@ -1510,7 +1743,7 @@ MDFN_FASTCALL pscpu_timestamp_t GPU_Update(const pscpu_timestamp_t sys_timestamp
  }
 }
 
-void GPU_GetGunXTranslation(float* scale, float* offs)
+void PS_GPU::GetGunXTranslation(float* scale, float* offs)
 {
  *scale = 1.0;
  *offs = HVisOffs;
@@ -1529,7 +1762,7 @@ void GPU_GetGunXTranslation(float* scale, float* offs)
   //printf("%f %d %d\n", *scale, lw, nca_lw);
  }
 }
-void GPU_StartFrame(EmulateSpecStruct *espec_arg)
+void PS_GPU::StartFrame(EmulateSpecStruct *espec_arg)
 {
  sl_zero_reached = false;
 
@@ -1567,7 +1800,9 @@ void GPU_StartFrame(EmulateSpecStruct *espec_arg)
 
 SYNCFUNC(PS_GPU)
 {
-	NSS(GPURAM);
+	SyncRAM();
+
+	PSS(GPURAM, 512 * sizeof(GPURAM[0]));
 
 	NSS(CLUT_Cache);
 	NSS(CLUT_Cache_VB);
@@ -1689,7 +1924,7 @@ SYNCFUNC(PS_GPU)
 		OffsX = sign_x_to_s32(11, OffsX);
 		OffsY = sign_x_to_s32(11, OffsY);
 
-		IRQ_Assert(IRQ_GPU, IRQPending);
+		IRQ->Assert(IRQ_GPU, IRQPending);
 	}
 
 }
@@ -35,14 +35,6 @@ struct ShockRenderOptions;
 namespace MDFN_IEN_PSX
 {
 
-struct CTEntry
-{
- void (*func[4][8])(const uint32 *cb);
- uint8 len;
- uint8 fifo_fb_len;
- bool ss_cmd;
-};
-
 struct tri_vertex
 {
  int32 x, y;
@@ -56,11 +48,163 @@ struct line_point
  uint8 r, g, b;
 };
 
+// Snapshot of the drawing environment a triangle is rasterized with, so a deferred triangle isn't affected by later E1-E6 commands.
+struct tri_env
+{
+ int32 ClipX0, ClipY0;
+ int32 ClipX1, ClipY1;
+ uint32 MaskSetOR;
+ int32 LineSkipParity;	// Lines with (y & 1) == LineSkipParity are skipped; -1 if none are.
+ bool dtd;
+};
+
+struct CTEntry;
+struct tri_job;
+struct i_group;
+struct i_deltas;
+struct RT_State;
+
 struct PS_GPU
 {
- 
+ PS_GPU(bool pal_clock_and_tv) MDFN_COLD;
+ ~PS_GPU() MDFN_COLD;
+
  void SetRenderOptions(ShockRenderOptions* opts);
  template<bool isReader>void SyncState(EW::NewState *ns);
+
+ void Power(void) MDFN_COLD;
+ void ResetTS(void);
+ void StartFrame(EmulateSpecStruct *espec);
+
+ MDFN_FASTCALL pscpu_timestamp_t Update(const pscpu_timestamp_t timestamp);
+
+ MDFN_FASTCALL void Write(const pscpu_timestamp_t timestamp, uint32 A, uint32 V);
+ MDFN_FASTCALL uint32 Read(const pscpu_timestamp_t timestamp, uint32 A);
+
+ MDFN_FASTCALL void WriteDMA(uint32 V);
+ uint32 ReadDMA(void);
+
+ INLINE bool CalcFIFOReadyBit(void);
+
+ INLINE bool DMACanWrite(void)
+ {
+  return CalcFIFOReadyBit();
+ }
+
+ void GetGunXTranslation(float* scale, float* offs);
+
+ // Waits until all queued triangles touching GPURAM line "line"(or all lines, if line < 0) have been drawn.
+ INLINE void SyncRAM(int32 line = -1)
+ {
+  if(RenderThreads > 1)
+   SyncRAMSlow(line);
+ }
+
+ INLINE int32 GetScanlineNum(void)
+ {
+  return scanline;
+ }
+
+ INLINE uint16 PeekRAM(uint32 A)
+ {
+  SyncRAM();
+  return GPURAM[(A >> 10) & 0x1FF][A & 0x3FF];
+ }
+
+ INLINE void PokeRAM(uint32 A, uint16 V)
+ {
+  SyncRAM();
+  GPURAM[(A >> 10) & 0x1FF][A & 0x3FF] = V;
+ }
+
+ //
+ // Internals
+ //
+ static void InitTables(void) MDFN_COLD;
+
+ void SetRenderThreads(uint32 count);
+ void RT_WorkerMain(unsigned band, int32 band_y0, int32 band_y1);
+ void QueueTri(const tri_job &job);
+ void SyncRAMSlow(int32 line);
+
+ void InvalidateTexCache(void);
+ void InvalidateCache(void);
+ void SoftReset(void);
+ void SetTPage(const uint32 cmdw);
+ void ProcessFIFO(void);
+ void WriteCB(uint32 InData);
+ uint32 ReadData(void);
+
+ void ReorderRGB_Var(uint32 out_Rshift, uint32 out_Gshift, uint32 out_Bshift, bool bpp24, const uint16 *src, uint32 *dest, const int32 dx_start, const int32 dx_end, int32 fb_x);
+
+ template<uint32 out_Rshift, uint32 out_Gshift, uint32 out_Bshift>
+ void ReorderRGB(bool bpp24, const uint16 *src, uint32 *dest, const int32 dx_start, const int32 dx_end, int32 fb_x);
+
+ //
+ // Rendering helpers(gpu_common.inc)
+ //
+ template<int BlendMode, bool MaskEval_TA, bool textured>
+ void PlotPixel(uint32 x, uint32 y, uint16 fore_pix, const uint32 mask_set_or);
+
+ static uint16 ModTexel(uint16 texel, int32 r, int32 g, int32 b, const int32 dither_x, const int32 dither_y);
+
+ template<uint32 TexMode_TA>
+ void Update_CLUT_Cache(uint16 raw_clut);
+
+ void RecalcTexWindowStuff(void);
+
+ template<uint32 TexMode_TA>
+ uint16 GetTexel(uint32 u_arg, uint32 v_arg);
+
+ bool LineSkipTest(unsigned y);
+ void MakeTriEnv(tri_env* env);
+
+ //
+ // Commands; the command table(Commands[]) points at these.
+ //
+ void Command_FBFill(const uint32 *cb);
+ void Command_FBCopy(const uint32 *cb);
+ void Command_FBWrite(const uint32 *cb);
+ void Command_FBRead(const uint32 *cb);
+ void Command_DrawMode(const uint32 *cb);
+ void Command_TexWindow(const uint32 *cb);
+ void Command_Clip0(const uint32 *cb);
+ void Command_Clip1(const uint32 *cb);
+ void Command_DrawingOffset(const uint32 *cb);
+ void Command_MaskSetting(const uint32 *cb);
+ void Command_ClearCache(const uint32 *cb);
+ void Command_IRQ(const uint32 *cb);
+
+ // gpu_polygon.cpp
+ template<bool goraud, int BlendMode, bool MaskEval_TA>
+ int32 DrawSpan_SSE2(const tri_env &env, const int32 x, const int32 y, const int32 w, const i_group &ig, const i_deltas &idl);
+
+ template<bool goraud, bool textured, int BlendMode, bool TexMult, uint32 TexMode_TA, bool MaskEval_TA, unsigned Pass>
+ void DrawSpan(const tri_env &env, int y, const int32 x_start, const int32 x_bound, i_group ig, const i_deltas &idl, const int32 band_y0, const int32 band_y1);
+
+ template<bool goraud, bool textured, int BlendMode, bool TexMult, uint32 TexMode_TA, bool MaskEval_TA, unsigned Pass>
+ void DrawTriangle(tri_vertex *vertices, const tri_env &env, const int32 band_y0 = 0, const int32 band_y1 = 512);
+
+ template<bool goraud, int BlendMode, bool MaskEval_TA>
+ void DrawTriangleJob(const tri_job &job, const int32 band_y0, const int32 band_y1);
+
+ template<int numvertices, bool goraud, bool textured, int BlendMode, bool TexMult, uint32 TexMode_TA, bool MaskEval_TA>
+ void Command_DrawPolygon(const uint32 *cb);
+
+ // gpu_sprite.cpp
+ template<bool textured, int BlendMode, bool TexMult, uint32 TexMode_TA, bool MaskEval_TA, bool FlipX, bool FlipY>
+ void DrawSprite(int32 x_arg, int32 y_arg, int32 w, int32 h, uint8 u_arg, uint8 v_arg, uint32 color);
+
+ template<uint8 raw_size, bool textured, int BlendMode, bool TexMult, uint32 TexMode_TA, bool MaskEval_TA>
+ void Command_DrawSprite(const uint32 *cb);
+
+ // gpu_line.cpp
+ template<bool goraud, int BlendMode, bool MaskEval_TA>
+ void DrawLine(line_point *points);
+
+ template<bool polyline, bool goraud, int BlendMode, bool MaskEval_TA>
+ void Command_DrawLine(const uint32 *cb);
+
  uint16 CLUT_Cache[256];
  uint32 CLUT_Cache_VB;	// Don't try to be clever and reduce it to 16 bits... ~0U is value for invalidated state.
 
@@ -190,9 +334,9 @@ struct PS_GPU
 
  pscpu_timestamp_t lastts;
 
- uint8 DitherLUT[4][4][512];	// Y, X, 8-bit source value(256 extra for saturation)
+ static uint8 DitherLUT[4][4][512];	// Y, X, 8-bit source value(256 extra for saturation); shared by all instances.
 
- CTEntry Commands[256];
+ static CTEntry Commands[256];	// Shared by all instances.
  //
  //
  //
@@ -215,73 +359,56 @@ struct PS_GPU
  uint32 OutputLUT[384];
  //
  //
- // Y, X
- uint16 GPURAM[512][1024];
+ // Y, X; [512][1024], allocated by the constructor
+ uint16 (*GPURAM)[1024];
 
  public:
 	 uint32 GetVertStart() { return VertStart; }
 	 uint32 GetVertEnd() { return VertEnd; }
 	 int FirstLine;
-};
-
- extern PS_GPU GPU;
-
- void GPU_Init(bool pal_clock_and_tv) MDFN_COLD;
- void GPU_Kill(void) MDFN_COLD;
-
- 
- void GPU_GetGunXTranslation(float* scale, float* offs);
 
- void GPU_Power(void) MDFN_COLD;
-
- void GPU_ResetTS(void);
-
- void GPU_StartFrame(EmulateSpecStruct *espec);
+	 //
+	 // Threaded rendering(not saved in save states).  When RenderThreads > 1, untextured triangles are timed on the emulation thread
+	 // and plotted by RenderThreads worker threads, each owning a horizontal band of GPURAM.  Anything else that reads or writes GPURAM
+	 // first waits for the workers(SyncRAM()).
+	 //
+	 uint32 RenderThreads;
+	 RT_State* RT;
+};
 
- MDFN_FASTCALL pscpu_timestamp_t GPU_Update(const pscpu_timestamp_t timestamp);
+// Defined after PS_GPU, so the member pointers have the complete class's representation.
+struct CTEntry
+{
+ void (PS_GPU::*func[4][8])(const uint32 *cb);
+ uint8 len;
+ uint8 fifo_fb_len;
+ bool ss_cmd;
+};
 
- MDFN_FASTCALL void GPU_Write(const pscpu_timestamp_t timestamp, uint32 A, uint32 V);
+struct tri_job
+{
+ void (PS_GPU::*func)(const tri_job &job, const int32 band_y0, const int32 band_y1);
+ tri_vertex vertices[3];
+ tri_env env;
+};
 
- static INLINE bool GPU_CalcFIFOReadyBit(void)
+ INLINE bool PS_GPU::CalcFIFOReadyBit(void)
  {
-  if(GPU.InCmd & (PS_GPU::INCMD_PLINE | PS_GPU::INCMD_QUAD))
+  if(InCmd & (INCMD_PLINE | INCMD_QUAD))
    return false;
 
-  if(GPU.BlitterFIFO.CanRead() == 0)
+  if(BlitterFIFO.CanRead() == 0)
    return true;
 
-  if(GPU.InCmd & (PS_GPU::INCMD_FBREAD | PS_GPU::INCMD_FBWRITE))
+  if(InCmd & (INCMD_FBREAD | INCMD_FBWRITE))
    return false;
 
-  if(GPU.BlitterFIFO.CanRead() >= GPU.Commands[GPU.BlitterFIFO.Peek() >> 24].fifo_fb_len)
+  if(BlitterFIFO.CanRead() >= Commands[BlitterFIFO.Peek() >> 24].fifo_fb_len)
    return false;
 
   return true;
  }
 
- static INLINE bool GPU_DMACanWrite(void)
- {
-  return GPU_CalcFIFOReadyBit();
- }
-
- MDFN_FASTCALL void GPU_WriteDMA(uint32 V);
- uint32 GPU_ReadDMA(void);
-
- MDFN_FASTCALL uint32 GPU_Read(const pscpu_timestamp_t timestamp, uint32 A);
-
- static INLINE int32 GPU_GetScanlineNum(void)
- {
-  return GPU.scanline;
- } 
-
- static INLINE uint16 GPU_PeekRAM(uint32 A)
- {
-  return GPU.GPURAM[(A >> 10) & 0x1FF][A & 0x3FF];
- }
-
- static INLINE void GPU_PokeRAM(uint32 A, uint16 V)
- {
-  GPU.GPURAM[(A >> 10) & 0x1FF][A & 0x3FF] = V;
- }
+ extern EW_THREAD PS_GPU* GPU;
 }
 #endif
@@ -24,10 +24,8 @@
 
 namespace MDFN_IEN_PSX
 {
-namespace PS_GPU_INTERNAL
-{
-
 #include "gpu_common.inc"
+using namespace PS_GPU_INTERNAL;
 
 struct line_fxp_coord
 {
@@ -118,7 +116,7 @@ static INLINE void AddLineStep(line_fxp_coord &point, const line_fxp_step &step)
 }
 
 template<bool goraud, int BlendMode, bool MaskEval_TA>
-static void DrawLine(line_point *points)
+void PS_GPU::DrawLine(line_point *points)
 {
  int32 i_dx;
  int32 i_dy;
@@ -195,7 +193,7 @@ static void DrawLine(line_point *points)
 
    // FIXME: There has to be a faster way than checking for being inside the drawing area for each pixel.
    if(x >= ClipX0 && x <= ClipX1 && y >= ClipY0 && y <= ClipY1)
-    PlotPixel<BlendMode, MaskEval_TA, false>(x, y, pix);
+    PlotPixel<BlendMode, MaskEval_TA, false>(x, y, pix, MaskSetOR);
   }
 
   AddLineStep<goraud>(cur_point, step);
@@ -203,7 +201,7 @@ static void DrawLine(line_point *points)
 }
 
 template<bool polyline, bool goraud, int BlendMode, bool MaskEval_TA>
-static void Command_DrawLine(const uint32 *cb)
+void PS_GPU::Command_DrawLine(const uint32 *cb)
 {
  const uint8 cc = cb[0] >> 24; // For pline handling later.
  line_point points[2];
@@ -259,6 +257,8 @@ static void Command_DrawLine(const uint32 *cb)
  DrawLine<goraud, BlendMode, MaskEval_TA>(points);
 }
 
+namespace PS_GPU_INTERNAL
+{
 MDFN_HIDE extern const CTEntry Commands_40_5F[0x20] =
 {
  LINE_HELPER(0x40),
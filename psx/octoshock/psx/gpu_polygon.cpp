@@ -24,11 +24,15 @@
 #include "psx.h"
 #include "gpu.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+ #define GPU_SPAN_SSE2 1
+ #include <emmintrin.h>
+#endif
+
 namespace MDFN_IEN_PSX
 {
-namespace PS_GPU_INTERNAL
-{
 #include "gpu_common.inc"
+using namespace PS_GPU_INTERNAL;
 
 #define COORD_FBS 12
 #define COORD_MF_INT(n) ((n) << COORD_FBS)
@@ -143,41 +147,171 @@ static INLINE void AddIDeltas_DY(i_group &ig, const i_deltas &idl, uint32 count
  }
 }
 
-template<bool goraud, bool textured, int BlendMode, bool TexMult, uint32 TexMode_TA, bool MaskEval_TA>
-static INLINE void DrawSpan(int y, const int32 x_start, const int32 x_bound, i_group ig, const i_deltas &idl)
+//
+// Triangle drawing passes; PASS_TIMING and PASS_PLOT split PASS_ALL in two for the threaded renderer(untextured triangles only).
+//
+enum
+{
+ PASS_ALL = 0,		// Update DrawTimeAvail and plot.
+ PASS_TIMING = 1,	// Only update DrawTimeAvail.
+ PASS_PLOT = 2		// Only plot, and only into GPU RAM lines [band_y0, band_y1).
+};
+
+#ifdef GPU_SPAN_SSE2
+//
+// Untextured spans, 8 pixels at a time.  Same results as the per-pixel loop in DrawSpan() + PlotPixel(); blending is done per
+// 5-bit channel instead of with the packed 15bpp math, which works out the same.
+//
+static INLINE __m128i SpanChannel_SSE2(const __m128i lo, const __m128i hi, const __m128i dither, const bool dtd)
+{
+ __m128i c = _mm_packs_epi32(_mm_srli_epi32(lo, COORD_FBS + COORD_POST_PADDING), _mm_srli_epi32(hi, COORD_FBS + COORD_POST_PADDING));
+
+ if(dtd)	// DitherLUT[][][]
+  return _mm_min_epi16(_mm_srli_epi16(_mm_max_epi16(_mm_add_epi16(c, dither), _mm_setzero_si128()), 3), _mm_set1_epi16(0x1F));
+
+ return _mm_srli_epi16(c, 3);
+}
+
+template<int BlendMode>
+static INLINE __m128i BlendChannel_SSE2(const __m128i fore, const __m128i back)
+{
+ switch(BlendMode)
+ {
+  default:
+  case 0: return _mm_srli_epi16(_mm_add_epi16(fore, back), 1);
+  case 1: return _mm_min_epi16(_mm_add_epi16(fore, back), _mm_set1_epi16(0x1F));
+  case 2: return _mm_max_epi16(_mm_sub_epi16(back, fore), _mm_setzero_si128());
+  case 3: return _mm_min_epi16(_mm_add_epi16(_mm_srli_epi16(fore, 2), back), _mm_set1_epi16(0x1F));
+ }
+}
+
+// Returns the number of pixels drawn, a multiple of 8.
+template<bool goraud, int BlendMode, bool MaskEval_TA>
+INLINE int32 PS_GPU::DrawSpan_SSE2(const tri_env &env, const int32 x, const int32 y, const int32 w, const i_group &ig, const i_deltas &idl)
+{
+ uint16* fb = &GPURAM[y & 511][x];
+ const int32 count = w &~ 7;
+ const bool dtd = goraud && env.dtd;
+ const __m128i c1F = _mm_set1_epi16(0x1F);
+ const __m128i mask_set_or = _mm_set1_epi16((int16)env.MaskSetOR);
+ const __m128i dither = _mm_setr_epi16(DitherTable[y & 3][(x + 0) & 3], DitherTable[y & 3][(x + 1) & 3], DitherTable[y & 3][(x + 2) & 3], DitherTable[y & 3][(x + 3) & 3],
+				       DitherTable[y & 3][(x + 0) & 3], DitherTable[y & 3][(x + 1) & 3], DitherTable[y & 3][(x + 2) & 3], DitherTable[y & 3][(x + 3) & 3]);
+ __m128i rgb[3][2];	// Interpolants for pixels 0-3 and 4-7.
+ __m128i step[3];
+ __m128i fore[3];
+ const uint32 ig_c[3] = { ig.r, ig.g, ig.b };
+ const uint32 d_c[3] = { idl.dr_dx, idl.dg_dx, idl.db_dx };
+
+ for(unsigned c = 0; c < 3; c++)
+ {
+  const uint32 d = goraud ? d_c[c] : 0;
+
+  rgb[c][0] = _mm_add_epi32(_mm_set1_epi32(ig_c[c]), _mm_setr_epi32(0, d, d * 2, d * 3));
+  rgb[c][1] = _mm_add_epi32(rgb[c][0], _mm_set1_epi32(d * 4));
+  step[c] = _mm_set1_epi32(d * 8);
+  fore[c] = SpanChannel_SSE2(rgb[c][0], rgb[c][1], dither, dtd);
+ }
+
+ for(int32 i = 0; i < count; i += 8)
+ {
+  const __m128i bg_pix = _mm_loadu_si128((__m128i*)&fb[i]);
+  __m128i pix;
+
+  if(goraud)
+  {
+   for(unsigned c = 0; c < 3; c++)
+   {
+    fore[c] = SpanChannel_SSE2(rgb[c][0], rgb[c][1], dither, dtd);
+    rgb[c][0] = _mm_add_epi32(rgb[c][0], step[c]);
+    rgb[c][1] = _mm_add_epi32(rgb[c][1], step[c]);
+   }
+  }
+
+  if(BlendMode >= 0)
+  {
+   const __m128i r = BlendChannel_SSE2<BlendMode>(fore[0], _mm_and_si128(bg_pix, c1F));
+   const __m128i g = BlendChannel_SSE2<BlendMode>(fore[1], _mm_and_si128(_mm_srli_epi16(bg_pix, 5), c1F));
+   const __m128i b = BlendChannel_SSE2<BlendMode>(fore[2], _mm_and_si128(_mm_srli_epi16(bg_pix, 10), c1F));
+
+   pix = _mm_or_si128(_mm_or_si128(r, _mm_slli_epi16(g, 5)), _mm_slli_epi16(b, 10));
+  }
+  else
+   pix = _mm_or_si128(_mm_or_si128(fore[0], _mm_slli_epi16(fore[1], 5)), _mm_slli_epi16(fore[2], 10));
+
+  pix = _mm_or_si128(pix, mask_set_or);
+
+  if(MaskEval_TA)
+  {
+   const __m128i keep = _mm_srai_epi16(bg_pix, 15);
+
+   pix = _mm_or_si128(_mm_and_si128(keep, bg_pix), _mm_andnot_si128(keep, pix));
+  }
+
+  _mm_storeu_si128((__m128i*)&fb[i], pix);
+ }
+
+ return count;
+}
+#endif
+
+template<bool goraud, bool textured, int BlendMode, bool TexMult, uint32 TexMode_TA, bool MaskEval_TA, unsigned Pass>
+INLINE void PS_GPU::DrawSpan(const tri_env &env, int y, const int32 x_start, const int32 x_bound, i_group ig, const i_deltas &idl, const int32 band_y0, const int32 band_y1)
 {
-  if(LineSkipTest(y))
+  if((int32)(y & 1) == env.LineSkipParity)
+   return;
+
+  if(Pass == PASS_PLOT && ((int32)(y & 511) < band_y0 || (int32)(y & 511) >= band_y1))
    return;
 
   int32 x_ig_adjust = x_start;
   int32 w = x_bound - x_start;
   int32 x = sign_x_to_s32(11, x_start);
 
-  if(x < ClipX0)
+  if(x < env.ClipX0)
   {
-   int32 delta = ClipX0 - x;
+   int32 delta = env.ClipX0 - x;
    x_ig_adjust += delta;
    x += delta;
    w -= delta;
   }
 
-  if((x + w) > (ClipX1 + 1))
-   w = ClipX1 + 1 - x;
+  if((x + w) > (env.ClipX1 + 1))
+   w = env.ClipX1 + 1 - x;
 
   if(w <= 0)
    return;
 
   //printf("%d %d %d %d\n", x, w, ClipX0, ClipX1);
 
+  if(Pass != PASS_PLOT)
+  {
+   if(goraud || textured)
+    DrawTimeAvail -= w * 2;
+   else if((BlendMode >= 0) || MaskEval_TA)
+    DrawTimeAvail -= w + ((w + 1) >> 1);
+   else
+    DrawTimeAvail -= w;
+  }
+
+  if(Pass == PASS_TIMING)
+   return;
+
   AddIDeltas_DX<goraud, textured>(ig, idl, x_ig_adjust);
   AddIDeltas_DY<goraud, textured>(ig, idl, y);
 
-  if(goraud || textured)
-   DrawTimeAvail -= w * 2;
-  else if((BlendMode >= 0) || MaskEval_TA)
-   DrawTimeAvail -= w + ((w + 1) >> 1);
-  else
-   DrawTimeAvail -= w;
+#ifdef GPU_SPAN_SSE2
+  if(!textured && w >= 8)
+  {
+   const int32 count = DrawSpan_SSE2<goraud, BlendMode, MaskEval_TA>(env, x, y, w, ig, idl);
+
+   x += count;
+   w -= count;
+   AddIDeltas_DX<goraud, textured>(ig, idl, count);
+
+   if(!w)
+    return;
+  }
+#endif
 
   do
   {
@@ -198,7 +332,7 @@ static INLINE void DrawSpan(int y, const int32 x_start, const int32 x_bound, i_g
       uint32 dither_x = x & 3;
       uint32 dither_y = y & 3;
 
-      if(!dtd)
+      if(!env.dtd)
       {
        dither_x = 3;
        dither_y = 2;
@@ -206,14 +340,14 @@ static INLINE void DrawSpan(int y, const int32 x_start, const int32 x_bound, i_g
 
       fbw = ModTexel(fbw, r, g, b, dither_x, dither_y);
      }
-     PlotPixel<BlendMode, MaskEval_TA, true>(x, y, fbw);
+     PlotPixel<BlendMode, MaskEval_TA, true>(x, y, fbw, env.MaskSetOR);
     }
    }
    else
    {
     uint16 pix = 0x8000;
 
-    if(goraud && dtd)
+    if(goraud && env.dtd)
     {
      pix |= DitherLUT[y & 3][x & 3][r] << 0;
      pix |= DitherLUT[y & 3][x & 3][g] << 5;
@@ -226,7 +360,7 @@ static INLINE void DrawSpan(int y, const int32 x_start, const int32 x_bound, i_g
      pix |= (b >> 3) << 10;
     }
     
-    PlotPixel<BlendMode, MaskEval_TA, false>(x, y, pix);
+    PlotPixel<BlendMode, MaskEval_TA, false>(x, y, pix, env.MaskSetOR);
    }
 
    x++;
@@ -234,8 +368,8 @@ static INLINE void DrawSpan(int y, const int32 x_start, const int32 x_bound, i_g
   } while(MDFN_LIKELY(--w > 0));
 }
 
-template<bool goraud, bool textured, int BlendMode, bool TexMult, uint32 TexMode_TA, bool MaskEval_TA>
-static INLINE void DrawTriangle(tri_vertex *vertices)
+template<bool goraud, bool textured, int BlendMode, bool TexMult, uint32 TexMode_TA, bool MaskEval_TA, unsigned Pass>
+INLINE void PS_GPU::DrawTriangle(tri_vertex *vertices, const tri_env &env, const int32 band_y0, const int32 band_y1)
 {
  i_deltas idl;
  unsigned core_vertex;
@@ -455,16 +589,17 @@ static INLINE void DrawTriangle(tri_vertex *vertices)
     //
     int32 y = sign_x_to_s32(11, yi);
 
-    if(y < ClipY0)
+    if(y < env.ClipY0)
      break;
 
-    if(y > ClipY1)
+    if(y > env.ClipY1)
     {
-     DrawTimeAvail -= 2;
+     if(Pass != PASS_PLOT)
+      DrawTimeAvail -= 2;
      continue;
     }
 
-    DrawSpan<goraud, textured, BlendMode, TexMult, TexMode_TA, MaskEval_TA>(yi, GetPolyXFP_Int(lc), GetPolyXFP_Int(rc), ig, idl);
+    DrawSpan<goraud, textured, BlendMode, TexMult, TexMode_TA, MaskEval_TA, Pass>(env, yi, GetPolyXFP_Int(lc), GetPolyXFP_Int(rc), ig, idl, band_y0, band_y1);
    }
   }
   else
@@ -473,16 +608,17 @@ static INLINE void DrawTriangle(tri_vertex *vertices)
    {
     int32 y = sign_x_to_s32(11, yi);
 
-    if(y > ClipY1)
+    if(y > env.ClipY1)
      break;
 
-    if(y < ClipY0)
+    if(y < env.ClipY0)
     {
-     DrawTimeAvail -= 2;
+     if(Pass != PASS_PLOT)
+      DrawTimeAvail -= 2;
      goto skipit;
     }
 
-    DrawSpan<goraud, textured, BlendMode, TexMult, TexMode_TA, MaskEval_TA>(yi, GetPolyXFP_Int(lc), GetPolyXFP_Int(rc), ig, idl);
+    DrawSpan<goraud, textured, BlendMode, TexMult, TexMode_TA, MaskEval_TA, Pass>(env, yi, GetPolyXFP_Int(lc), GetPolyXFP_Int(rc), ig, idl, band_y0, band_y1);
     //
     //
     //
@@ -504,8 +640,21 @@ static INLINE void DrawTriangle(tri_vertex *vertices)
 #endif
 }
 
+//
+// Worker-thread side of a deferred untextured triangle; see QueueTri().
+//
+template<bool goraud, int BlendMode, bool MaskEval_TA>
+void PS_GPU::DrawTriangleJob(const tri_job &job, const int32 band_y0, const int32 band_y1)
+{
+ tri_vertex vertices[3];
+
+ memcpy(vertices, job.vertices, sizeof(vertices));
+
+ DrawTriangle<goraud, false, BlendMode, false, 0, MaskEval_TA, PASS_PLOT>(vertices, job.env, band_y0, band_y1);
+}
+
 template<int numvertices, bool goraud, bool textured, int BlendMode, bool TexMult, uint32 TexMode_TA, bool MaskEval_TA>
-static void Command_DrawPolygon(const uint32 *cb)
+void PS_GPU::Command_DrawPolygon(const uint32 *cb)
 {
  const unsigned cb0 = cb[0];
  tri_vertex vertices[3] = {0}; //zero 04-oct-2020 - zero initialize for more deterministic results (sometimes UV arent set)
@@ -587,13 +736,32 @@ static void Command_DrawPolygon(const uint32 *cb)
   }
  }
 
- DrawTriangle<goraud, textured, BlendMode, TexMult, TexMode_TA, MaskEval_TA>(vertices);
+ tri_env env;
+
+ MakeTriEnv(&env);
+
+ if(!textured && RenderThreads > 1)
+ {
+  tri_job job;
+
+  job.func = &PS_GPU::DrawTriangleJob<goraud, BlendMode, MaskEval_TA>;
+  memcpy(job.vertices, vertices, sizeof(vertices));
+  job.env = env;
+
+  // DrawTriangle() sorts the vertices in place, so the timing pass gets the local copy and the job keeps the original order.
+  DrawTriangle<goraud, textured, BlendMode, TexMult, TexMode_TA, MaskEval_TA, PASS_TIMING>(vertices, env);
+  QueueTri(job);
+ }
+ else
+  DrawTriangle<goraud, textured, BlendMode, TexMult, TexMode_TA, MaskEval_TA, PASS_ALL>(vertices, env);
 }
 
 #undef COORD_POST_PADDING
 #undef COORD_FBS
 #undef COORD_MF_INT
 
+namespace PS_GPU_INTERNAL
+{
 MDFN_HIDE extern const CTEntry Commands_20_3F[0x20] =
 {
  /* 0x20 */
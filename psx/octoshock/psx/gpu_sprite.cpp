@@ -24,12 +24,11 @@
 
 namespace MDFN_IEN_PSX
 {
-namespace PS_GPU_INTERNAL
-{
 #include "gpu_common.inc"
+using namespace PS_GPU_INTERNAL;
 
 template<bool textured, int BlendMode, bool TexMult, uint32 TexMode_TA, bool MaskEval_TA, bool FlipX, bool FlipY>
-static void DrawSprite(int32 x_arg, int32 y_arg, int32 w, int32 h, uint8 u_arg, uint8 v_arg, uint32 color)
+void PS_GPU::DrawSprite(int32 x_arg, int32 y_arg, int32 w, int32 h, uint8 u_arg, uint8 v_arg, uint32 color)
 {
  const int32 r = color & 0xFF;
  const int32 g = (color >> 8) & 0xFF;
@@ -132,11 +131,11 @@ static void DrawSprite(int32 x_arg, int32 y_arg, int32 w, int32 h, uint8 u_arg,
       {
        fbw = ModTexel(fbw, r, g, b, 3, 2);
       }
-      PlotPixel<BlendMode, MaskEval_TA, true>(x, y, fbw);
+      PlotPixel<BlendMode, MaskEval_TA, true>(x, y, fbw, MaskSetOR);
      }
     }
     else
-     PlotPixel<BlendMode, MaskEval_TA, false>(x, y, fill_color);
+     PlotPixel<BlendMode, MaskEval_TA, false>(x, y, fill_color, MaskSetOR);
 
     if(textured)
      u_r += u_inc;
@@ -148,7 +147,7 @@ static void DrawSprite(int32 x_arg, int32 y_arg, int32 w, int32 h, uint8 u_arg,
 }
 
 template<uint8 raw_size, bool textured, int BlendMode, bool TexMult, uint32 TexMode_TA, bool MaskEval_TA>
-static void Command_DrawSprite(const uint32 *cb)
+void PS_GPU::Command_DrawSprite(const uint32 *cb)
 {
  int32 x, y;
  int32 w, h;
@@ -234,6 +233,8 @@ static void Command_DrawSprite(const uint32 *cb)
  }
 }
 
+namespace PS_GPU_INTERNAL
+{
 MDFN_HIDE extern const CTEntry Commands_60_7F[0x20] =
 {
  SPR_HELPER(0x60),
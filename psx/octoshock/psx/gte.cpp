@@ -26,6 +26,8 @@
 #include "gte.h"
 #endif
 
+#include <mutex>
+
 /* Notes:
 
  AVSZ3/AVSZ4:
@@ -49,101 +51,11 @@ namespace MDFN_IEN_PSX
 {
 #endif
 
-typedef struct
-{
- int16 MX[3][3];
- int16 dummy;
-} gtematrix;
-#ifndef PSXDEV_GTE_TESTING
-static_assert(sizeof(gtematrix) == 20, "gtematrix wrong size!");
-#endif
-
-typedef struct
-{
- union
- {
-  struct
-  {
-   uint8 R;
-   uint8 G;
-   uint8 B;
-   uint8 CD;
-  };
-  uint8 Raw8[4];
- };
-} gtergb;
-
-typedef struct
-{
- int16 X;
- int16 Y;
-} gtexy;
-
-static uint32 CR[32];
-static uint32 FLAGS;	// Temporary for instruction execution, copied into CR[31] at end of instruction execution.
-
-typedef union
-{
- gtematrix All[4];
- int32 Raw[4][5];	// Don't read from this(Raw[][]), only write(and when writing, if running on a big-endian platform, swap the upper 16-bits with the lower 16-bits)
- int16 Raw16[4][10];
-
- struct
- {
-  gtematrix Rot;
-  gtematrix Light;
-  gtematrix Color;
-  gtematrix AbbyNormal;
- };
-} Matrices_t;
-
-static Matrices_t Matrices;
-
-static union
-{
- int32 All[4][4];	// Really only [4][3], but [4] to ease address calculation.
-  
- struct
- {
-  int32 T[4];
-  int32 B[4];
-  int32 FC[4];
-  int32 Null[4];
- };
-} CRVectors;
-
-static int32 OFX;
-static int32 OFY;
-static uint16 H;
-static int16 DQA;
-static int32 DQB;
- 
-static int16 ZSF3;
-static int16 ZSF4;
-
-
-// Begin DR
-static int16 Vectors[3][4];
-static gtergb RGB;
-static uint16 OTZ;
-
-static int16 IR[4];
-
 #define IR0 IR[0]
 #define IR1 IR[1]
 #define IR2 IR[2]
 #define IR3 IR[3]
 
-static gtexy XY_FIFO[4];
-static uint16 Z_FIFO[4];
-static gtergb RGB_FIFO[3];
-static int32 MAC[4];
-static uint32 LZCS;
-static uint32 LZCR;
-
-static uint32 Reg23;
-// end DR
-
 static INLINE uint8 Sat5(int16 cc)
 {
  if(cc < 0)
@@ -154,7 +66,7 @@ static INLINE uint8 Sat5(int16 cc)
 }
 
 //
-// Newton-Raphson division table.  (Initialized at startup; do NOT save in save states!)
+// Newton-Raphson division table.  (Initialized at startup, and shared by every instance; do NOT save in save states!)
 //
 static uint8 DivTable[0x100 + 1];
 static INLINE uint32 CalcRecip(uint16 divisor)
@@ -166,7 +78,7 @@ static INLINE uint32 CalcRecip(uint16 divisor)
  return(tmp2);
 }
 
-void GTE_Init(void)
+static void InitDivTable(void)
 {
  for(uint32_t divisor = 0x8000; divisor < 0x10000; divisor += 0x80)
  {
@@ -186,7 +98,14 @@ void GTE_Init(void)
  DivTable[0x100] = DivTable[0xFF];
 }
 
-void GTE_Power(void)
+void PS_GTE::Init(void)
+{
+ static std::once_flag DivTableOnce;
+
+ std::call_once(DivTableOnce, InitDivTable);
+}
+
+void PS_GTE::Power(void)
 {
  memset(CR, 0, sizeof(CR));
  //memset(DR, 0, sizeof(DR));
@@ -220,7 +139,7 @@ void GTE_Power(void)
  Reg23 = 0;
 }
 
-void GTE_WriteCR(unsigned int which, uint32 value)
+void PS_GTE::WriteCR(unsigned int which, uint32 value)
 {
  static const uint32 mask_table[32] = {
 	/* 0x00 */
@@ -296,7 +215,7 @@ void GTE_WriteCR(unsigned int which, uint32 value)
  }
 }
 
-uint32 GTE_ReadCR(unsigned int which)
+uint32 PS_GTE::ReadCR(unsigned int which)
 {
  uint32 ret = 0;
 
@@ -344,7 +263,7 @@ uint32 GTE_ReadCR(unsigned int which)
  return(ret);
 }
 
-void GTE_WriteDR(unsigned int which, uint32 value)
+void PS_GTE::WriteDR(unsigned int which, uint32 value)
 {
  switch(which & 0x1F)
  {
@@ -504,7 +423,7 @@ void GTE_WriteDR(unsigned int which, uint32 value)
  }
 }
 
-uint32 GTE_ReadDR(unsigned int which)
+uint32 PS_GTE::ReadDR(unsigned int which)
 {
  uint32 ret = 0;
 
@@ -639,7 +558,7 @@ uint32 GTE_ReadDR(unsigned int which)
 }
 
 #define sign_x_to_s64(_bits, _value) (((int64)((uint64)(_value) << (64 - _bits))) >> (64 - _bits))
-static INLINE int64 A_MV(unsigned which, int64 value)
+INLINE int64 PS_GTE::A_MV(unsigned which, int64 value)
 {
  if(value >= (1LL << 43))
   FLAGS |= 1 << (30 - which);
@@ -650,7 +569,7 @@ static INLINE int64 A_MV(unsigned which, int64 value)
  return sign_x_to_s64(44, value);
 }
 
-static INLINE int64 F(int64 value)
+INLINE int64 PS_GTE::F(int64 value)
 {
  if(value < -2147483648LL)
  {
@@ -667,7 +586,7 @@ static INLINE int64 F(int64 value)
 }
 
 
-static INLINE int16 Lm_B(unsigned int which, int32 value, int lm)
+INLINE int16 PS_GTE::Lm_B(unsigned int which, int32 value, int lm)
 {
  int32 tmp = lm << 15;
 
@@ -689,7 +608,7 @@ static INLINE int16 Lm_B(unsigned int which, int32 value, int lm)
 }
 
 
-static INLINE int16 Lm_B_PTZ(unsigned int which, int32 value, int32 ftv_value, int lm)
+INLINE int16 PS_GTE::Lm_B_PTZ(unsigned int which, int32 value, int32 ftv_value, int lm)
 {
  int32 tmp = lm << 15;
 
@@ -716,7 +635,7 @@ static INLINE int16 Lm_B_PTZ(unsigned int which, int32 value, int32 ftv_value, i
  return(value);
 }
 
-static INLINE uint8 Lm_C(unsigned int which, int32 value)
+INLINE uint8 PS_GTE::Lm_C(unsigned int which, int32 value)
 {
  if(value & ~0xFF)
  {
@@ -733,7 +652,7 @@ static INLINE uint8 Lm_C(unsigned int which, int32 value)
  return(value);
 }
 
-static INLINE int32 Lm_D(int32 value, int unchained)
+INLINE int32 PS_GTE::Lm_D(int32 value, int unchained)
 {
  // Not sure if we should have it as int64, or just chain on to and special case when the F flags are set.
  if(!unchained)
@@ -767,7 +686,7 @@ static INLINE int32 Lm_D(int32 value, int unchained)
  return(value);
 }
 
-static INLINE int32 Lm_G(unsigned int which, int32 value)
+INLINE int32 PS_GTE::Lm_G(unsigned int which, int32 value)
 {
  if(value < -1024)
  {
@@ -787,7 +706,7 @@ static INLINE int32 Lm_G(unsigned int which, int32 value)
 }
 
 // limit to 4096, not 4095
-static INLINE int32 Lm_H(int32 value)
+INLINE int32 PS_GTE::Lm_H(int32 value)
 {
  if(value < 0)
  {
@@ -804,7 +723,7 @@ static INLINE int32 Lm_H(int32 value)
  return(value);
 }
 
-static INLINE void MAC_to_RGB_FIFO(void)
+INLINE void PS_GTE::MAC_to_RGB_FIFO(void)
 {
  RGB_FIFO[0] = RGB_FIFO[1];
  RGB_FIFO[1] = RGB_FIFO[2];
@@ -815,14 +734,14 @@ static INLINE void MAC_to_RGB_FIFO(void)
 }
 
 
-static INLINE void MAC_to_IR(int lm)
+INLINE void PS_GTE::MAC_to_IR(int lm)
 {
  IR1 = Lm_B(0, MAC[1], lm);
  IR2 = Lm_B(1, MAC[2], lm);
  IR3 = Lm_B(2, MAC[3], lm);
 }
 
-static INLINE void MultiplyMatrixByVector(const gtematrix *matrix, const int16 *v, const int32 *crv, uint32 sf, int lm)
+INLINE void PS_GTE::MultiplyMatrixByVector(const gtematrix *matrix, const int16 *v, const int32 *crv, uint32 sf, int lm)
 {
  unsigned i;
 
@@ -873,7 +792,7 @@ static INLINE void MultiplyMatrixByVector(const gtematrix *matrix, const int16 *
 }
 
 
-static INLINE void MultiplyMatrixByVector_PT(const gtematrix *matrix, const int16 *v, const int32 *crv, uint32 sf, int lm)
+INLINE void PS_GTE::MultiplyMatrixByVector_PT(const gtematrix *matrix, const int16 *v, const int32 *crv, uint32 sf, int lm)
 {
  int64 tmp[3];
  unsigned i;
@@ -928,7 +847,7 @@ static INLINE void MultiplyMatrixByVector_PT(const gtematrix *matrix, const int1
  }
 
 
-static INLINE int32 SQR(uint32 instr)
+INLINE int32 PS_GTE::SQR(uint32 instr)
 {
  DECODE_FIELDS;
 
@@ -941,7 +860,7 @@ static INLINE int32 SQR(uint32 instr)
  return(5);
 }
 
-static INLINE int32 MVMVA(uint32 instr)
+INLINE int32 PS_GTE::MVMVA(uint32 instr)
 {
  DECODE_FIELDS;
 
@@ -963,7 +882,7 @@ static INLINE unsigned CountLeadingZeroU16(uint16 val)
  return ret;
 }
 
-static INLINE uint32 Divide(uint32 dividend, uint32 divisor)
+INLINE uint32 PS_GTE::Divide(uint32 dividend, uint32 divisor)
 {
  //if((Z_FIFO[3] * 2) > H)
  if((divisor * 2) > dividend)
@@ -982,7 +901,7 @@ static INLINE uint32 Divide(uint32 dividend, uint32 divisor)
  }
 }
 
-static INLINE void TransformXY(int64 h_div_sz)
+INLINE void PS_GTE::TransformXY(int64 h_div_sz)
 {
  MAC[0] = F((int64)OFX + IR1 * h_div_sz) >> 16;
  XY_FIFO[3].X = Lm_G(0, MAC[0]);
@@ -995,13 +914,13 @@ static INLINE void TransformXY(int64 h_div_sz)
  XY_FIFO[2] = XY_FIFO[3];
 }
 
-static INLINE void TransformDQ(int64 h_div_sz)
+INLINE void PS_GTE::TransformDQ(int64 h_div_sz)
 {
  MAC[0] = F((int64)DQB + DQA * h_div_sz);
  IR0 = Lm_H(((int64)DQB + DQA * h_div_sz) >> 12);
 }
 
-static INLINE int32 RTPS(uint32 instr)
+INLINE int32 PS_GTE::RTPS(uint32 instr)
 {
  DECODE_FIELDS;
  int64 h_div_sz;
@@ -1015,7 +934,7 @@ static INLINE int32 RTPS(uint32 instr)
  return(15);
 }
 
-static INLINE int32 RTPT(uint32 instr)
+INLINE int32 PS_GTE::RTPT(uint32 instr)
 {
  DECODE_FIELDS;
  int i;
@@ -1036,7 +955,7 @@ static INLINE int32 RTPT(uint32 instr)
  return(23);
 }
 
-static INLINE void NormColor(uint32 sf, int lm, uint32 v)
+INLINE void PS_GTE::NormColor(uint32 sf, int lm, uint32 v)
 {
  int16 tmp_vector[3];
 
@@ -1048,7 +967,7 @@ static INLINE void NormColor(uint32 sf, int lm, uint32 v)
  MAC_to_RGB_FIFO();
 }
 
-static INLINE int32 NCS(uint32 instr)
+INLINE int32 PS_GTE::NCS(uint32 instr)
 {
  DECODE_FIELDS;
 
@@ -1057,7 +976,7 @@ static INLINE int32 NCS(uint32 instr)
  return(14);
 }
 
-static int32 NCT(uint32 instr)
+int32 PS_GTE::NCT(uint32 instr)
 {
  DECODE_FIELDS;
  int i;
@@ -1068,7 +987,7 @@ static int32 NCT(uint32 instr)
  return(30);
 }
 
-static INLINE void NormColorColor(uint32 v, uint32 sf, int lm)
+INLINE void PS_GTE::NormColorColor(uint32 v, uint32 sf, int lm)
 {
  int16 tmp_vector[3];
 
@@ -1086,7 +1005,7 @@ static INLINE void NormColorColor(uint32 v, uint32 sf, int lm)
  MAC_to_RGB_FIFO();
 }
 
-static INLINE int32 NCCS(uint32 instr)
+INLINE int32 PS_GTE::NCCS(uint32 instr)
 {
  DECODE_FIELDS;
 
@@ -1095,7 +1014,7 @@ static INLINE int32 NCCS(uint32 instr)
 }
 
 
-static INLINE int32 NCCT(uint32 instr)
+INLINE int32 PS_GTE::NCCT(uint32 instr)
 {
  int i;
  DECODE_FIELDS;
@@ -1106,7 +1025,7 @@ static INLINE int32 NCCT(uint32 instr)
  return(39);
 }
 
-static INLINE void DepthCue(int mult_IR123, int RGB_from_FIFO, uint32 sf, int lm)
+INLINE void PS_GTE::DepthCue(int mult_IR123, int RGB_from_FIFO, uint32 sf, int lm)
 {
  int32 RGB_temp[3];
  int32 IR_temp[3] = { IR1, IR2, IR3 };
@@ -1150,7 +1069,7 @@ static INLINE void DepthCue(int mult_IR123, int RGB_from_FIFO, uint32 sf, int lm
 }
 
 
-static INLINE int32 DCPL(uint32 instr)
+INLINE int32 PS_GTE::DCPL(uint32 instr)
 {
  DECODE_FIELDS;
 
@@ -1160,7 +1079,7 @@ static INLINE int32 DCPL(uint32 instr)
 }
 
 
-static INLINE int32 DPCS(uint32 instr)
+INLINE int32 PS_GTE::DPCS(uint32 instr)
 {
  DECODE_FIELDS;
 
@@ -1169,7 +1088,7 @@ static INLINE int32 DPCS(uint32 instr)
  return(8);
 }
 
-static INLINE int32 DPCT(uint32 instr)
+INLINE int32 PS_GTE::DPCT(uint32 instr)
 {
  int i;
  DECODE_FIELDS;
@@ -1182,7 +1101,7 @@ static INLINE int32 DPCT(uint32 instr)
  return(17);
 }
 
-static INLINE int32 INTPL(uint32 instr)
+INLINE int32 PS_GTE::INTPL(uint32 instr)
 {
  DECODE_FIELDS;
 
@@ -1202,7 +1121,7 @@ static INLINE int32 INTPL(uint32 instr)
 }
 
 
-static INLINE void NormColorDepthCue(uint32 v, uint32 sf, int lm)
+INLINE void PS_GTE::NormColorDepthCue(uint32 v, uint32 sf, int lm)
 {
  int16 tmp_vector[3];
 
@@ -1214,7 +1133,7 @@ static INLINE void NormColorDepthCue(uint32 v, uint32 sf, int lm)
  DepthCue(true, false, sf, lm);
 }
 
-static INLINE int32 NCDS(uint32 instr)
+INLINE int32 PS_GTE::NCDS(uint32 instr)
 {
  DECODE_FIELDS;
 
@@ -1223,7 +1142,7 @@ static INLINE int32 NCDS(uint32 instr)
  return(19);
 }
 
-static INLINE int32 NCDT(uint32 instr)
+INLINE int32 PS_GTE::NCDT(uint32 instr)
 {
  int i;
  DECODE_FIELDS;
@@ -1236,7 +1155,7 @@ static INLINE int32 NCDT(uint32 instr)
  return(44);
 }
 
-static INLINE int32 CC(uint32 instr)
+INLINE int32 PS_GTE::CC(uint32 instr)
 {
  DECODE_FIELDS;
  int16 tmp_vector[3];
@@ -1255,7 +1174,7 @@ static INLINE int32 CC(uint32 instr)
  return(11);
 }
 
-static INLINE int32 CDP(uint32 instr)
+INLINE int32 PS_GTE::CDP(uint32 instr)
 {
  DECODE_FIELDS;
  int16 tmp_vector[3];
@@ -1268,7 +1187,7 @@ static INLINE int32 CDP(uint32 instr)
  return(13);
 }
 
-static INLINE int32 NCLIP(uint32 instr)
+INLINE int32 PS_GTE::NCLIP(uint32 instr)
 {
  DECODE_FIELDS;
 
@@ -1278,7 +1197,7 @@ static INLINE int32 NCLIP(uint32 instr)
  return(8);
 }
 
-static INLINE int32 AVSZ3(uint32 instr)
+INLINE int32 PS_GTE::AVSZ3(uint32 instr)
 {
  DECODE_FIELDS;
 
@@ -1289,7 +1208,7 @@ static INLINE int32 AVSZ3(uint32 instr)
  return(5);
 }
 
-static INLINE int32 AVSZ4(uint32 instr)
+INLINE int32 PS_GTE::AVSZ4(uint32 instr)
 {
  DECODE_FIELDS;
 
@@ -1303,7 +1222,7 @@ static INLINE int32 AVSZ4(uint32 instr)
 
 // -32768 * -32768 - 32767 * -32768 = 2147450880
 // (2 ^ 31) - 1 =		      2147483647
-static INLINE int32 OP(uint32 instr)
+INLINE int32 PS_GTE::OP(uint32 instr)
 {
  DECODE_FIELDS;
 
@@ -1316,7 +1235,7 @@ static INLINE int32 OP(uint32 instr)
  return(6);
 }
 
-static INLINE int32 GPF(uint32 instr)
+INLINE int32 PS_GTE::GPF(uint32 instr)
 {
  DECODE_FIELDS;
 
@@ -1331,7 +1250,7 @@ static INLINE int32 GPF(uint32 instr)
  return(5);
 }
 
-static INLINE int32 GPL(uint32 instr)
+INLINE int32 PS_GTE::GPL(uint32 instr)
 {
  DECODE_FIELDS;
 
@@ -1372,7 +1291,7 @@ static INLINE int32 GPL(uint32 instr)
  opcode = operation code 
 */
 
-int32 GTE_Instruction(uint32 instr)
+int32 PS_GTE::Instruction(uint32 instr)
 {
  const unsigned code = instr & 0x3F;
  int32 ret = 1;
@@ -1631,7 +1550,7 @@ int32 GTE_Instruction(uint32 instr)
  return(ret - 1);
 }
 
-void GTE_SyncState(bool isReader, EW::NewState *ns)
+void PS_GTE::SyncState(bool isReader, EW::NewState *ns)
 {
 	NSS(CR);
 	NSS(FLAGS);
@@ -25,17 +25,153 @@
 namespace MDFN_IEN_PSX
 {
 
-void GTE_Init(void) MDFN_COLD;
-void GTE_Power(void) MDFN_COLD;
+typedef struct
+{
+ int16 MX[3][3];
+ int16 dummy;
+} gtematrix;
+static_assert(sizeof(gtematrix) == 20, "gtematrix wrong size!");
+
+typedef struct
+{
+ union
+ {
+  struct
+  {
+   uint8 R;
+   uint8 G;
+   uint8 B;
+   uint8 CD;
+  };
+  uint8 Raw8[4];
+ };
+} gtergb;
+
+typedef struct
+{
+ int16 X;
+ int16 Y;
+} gtexy;
+
+typedef union
+{
+ gtematrix All[4];
+ int32 Raw[4][5];	// Don't read from this(Raw[][]), only write(and when writing, if running on a big-endian platform, swap the upper 16-bits with the lower 16-bits)
+ int16 Raw16[4][10];
+
+ struct
+ {
+  gtematrix Rot;
+  gtematrix Light;
+  gtematrix Color;
+  gtematrix AbbyNormal;
+ };
+} Matrices_t;
+class PS_GTE
+{
+ public:
+
+ void SyncState(bool isReader, EW::NewState *ns);
+
+ void Init(void) MDFN_COLD;
+ void Power(void) MDFN_COLD;
+
+ int32 Instruction(uint32 instr);
+
+ void WriteCR(unsigned int which, uint32 value);
+ void WriteDR(unsigned int which, uint32 value);
+
+ uint32 ReadCR(unsigned int which);
+ uint32 ReadDR(unsigned int which);
+
+ private:
+
+ int64 A_MV(unsigned which, int64 value);
+ int64 F(int64 value);
+ int16 Lm_B(unsigned int which, int32 value, int lm);
+ int16 Lm_B_PTZ(unsigned int which, int32 value, int32 ftv_value, int lm);
+ uint8 Lm_C(unsigned int which, int32 value);
+ int32 Lm_D(int32 value, int unchained);
+ int32 Lm_G(unsigned int which, int32 value);
+ int32 Lm_H(int32 value);
+ void MAC_to_RGB_FIFO(void);
+ void MAC_to_IR(int lm);
+ void MultiplyMatrixByVector(const gtematrix *matrix, const int16 *v, const int32 *crv, uint32 sf, int lm);
+ void MultiplyMatrixByVector_PT(const gtematrix *matrix, const int16 *v, const int32 *crv, uint32 sf, int lm);
+ int32 SQR(uint32 instr);
+ int32 MVMVA(uint32 instr);
+ uint32 Divide(uint32 dividend, uint32 divisor);
+ void TransformXY(int64 h_div_sz);
+ void TransformDQ(int64 h_div_sz);
+ int32 RTPS(uint32 instr);
+ int32 RTPT(uint32 instr);
+ void NormColor(uint32 sf, int lm, uint32 v);
+ int32 NCS(uint32 instr);
+ int32 NCT(uint32 instr);
+ void NormColorColor(uint32 v, uint32 sf, int lm);
+ int32 NCCS(uint32 instr);
+ int32 NCCT(uint32 instr);
+ void DepthCue(int mult_IR123, int RGB_from_FIFO, uint32 sf, int lm);
+ int32 DCPL(uint32 instr);
+ int32 DPCS(uint32 instr);
+ int32 DPCT(uint32 instr);
+ int32 INTPL(uint32 instr);
+ void NormColorDepthCue(uint32 v, uint32 sf, int lm);
+ int32 NCDS(uint32 instr);
+ int32 NCDT(uint32 instr);
+ int32 CC(uint32 instr);
+ int32 CDP(uint32 instr);
+ int32 NCLIP(uint32 instr);
+ int32 AVSZ3(uint32 instr);
+ int32 AVSZ4(uint32 instr);
+ int32 OP(uint32 instr);
+ int32 GPF(uint32 instr);
+ int32 GPL(uint32 instr);
+
+ uint32 CR[32];
+ uint32 FLAGS;	// Temporary for instruction execution, copied into CR[31] at end of instruction execution.
+
+ Matrices_t Matrices;
+
+ union
+ {
+  int32 All[4][4];	// Really only [4][3], but [4] to ease address calculation.
+  
+  struct
+  {
+   int32 T[4];
+   int32 B[4];
+   int32 FC[4];
+   int32 Null[4];
+  };
+ } CRVectors;
+
+ int32 OFX;
+ int32 OFY;
+ uint16 H;
+ int16 DQA;
+ int32 DQB;
+ 
+ int16 ZSF3;
+ int16 ZSF4;
 
-int32 GTE_Instruction(uint32 instr);
+ // Begin DR
+ int16 Vectors[3][4];
+ gtergb RGB;
+ uint16 OTZ;
 
-void GTE_WriteCR(unsigned int which, uint32 value);
-void GTE_WriteDR(unsigned int which, uint32 value);
+ int16 IR[4];
 
-uint32 GTE_ReadCR(unsigned int which);
-uint32 GTE_ReadDR(unsigned int which);
+ gtexy XY_FIFO[4];
+ uint16 Z_FIFO[4];
+ gtergb RGB_FIFO[3];
+ int32 MAC[4];
+ uint32 LZCS;
+ uint32 LZCR;
 
+ uint32 Reg23;
+ // end DR
+};
 
 }
 
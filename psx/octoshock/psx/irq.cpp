@@ -24,16 +24,12 @@
 namespace MDFN_IEN_PSX
 {
 
-static uint16 Asserted;
-static uint16 Mask;
-static uint16 Status;
-
-static INLINE void Recalc(void)
+INLINE void PS_IRQ::Recalc(void)
 {
  CPU->AssertIRQ(0, (bool)(Status & Mask));
 }
 
-void IRQ_SyncState(bool isReader, EW::NewState *ns)
+void PS_IRQ::SyncState(bool isReader, EW::NewState *ns)
 {
   NSS(Asserted);
   NSS(Mask);
@@ -46,7 +42,7 @@ void IRQ_SyncState(bool isReader, EW::NewState *ns)
 	}
 }
 
-void IRQ_Assert(int which, bool status)
+void PS_IRQ::Assert(int which, bool status)
 {
  uint32 old_Asserted = Asserted;
  //PSX_WARNING("[IRQ] Assert: %d %d", which, status);
@@ -67,7 +63,7 @@ void IRQ_Assert(int which, bool status)
 }
 
 
-MDFN_FASTCALL void IRQ_Write(uint32 A, uint32 V)
+MDFN_FASTCALL void PS_IRQ::Write(uint32 A, uint32 V)
 {
  // FIXME if we ever have "accurate" bus emulation
  V <<= (A & 3) * 8;
@@ -86,7 +82,7 @@ MDFN_FASTCALL void IRQ_Write(uint32 A, uint32 V)
 }
 
 
-MDFN_FASTCALL uint32 IRQ_Read(uint32 A)
+MDFN_FASTCALL uint32 PS_IRQ::Read(uint32 A)
 {
  uint32 ret = 0;
 
@@ -105,7 +101,7 @@ MDFN_FASTCALL uint32 IRQ_Read(uint32 A)
  return(ret);
 }
 
-void IRQ_Power(void)
+void PS_IRQ::Power(void)
 {
  Asserted = 0;
  Status = 0;
@@ -114,7 +110,7 @@ void IRQ_Power(void)
  Recalc();
 }
 
-void IRQ_Reset(void)
+void PS_IRQ::Reset(void)
 {
  Asserted = 0;
  Status = 0; 
@@ -124,7 +120,7 @@ void IRQ_Reset(void)
 }
 
 
-uint32 IRQ_GetRegister(unsigned int which, char *special, const uint32 special_len)
+uint32 PS_IRQ::GetRegister(unsigned int which, char *special, const uint32 special_len)
 {
  uint32 ret = 0;
 
@@ -145,7 +141,7 @@ uint32 IRQ_GetRegister(unsigned int which, char *special, const uint32 special_l
  return(ret);
 }
 
-void IRQ_SetRegister(unsigned int which, uint32 value)
+void PS_IRQ::SetRegister(unsigned int which, uint32 value)
 {
  switch(which)
  {
@@ -40,13 +40,6 @@ enum
  IRQ_PIO		= 10,	// Probably
 };
 
-void IRQ_Power(void) MDFN_COLD;
-void IRQ_Assert(int which, bool asserted);
-
-MDFN_FASTCALL void IRQ_Write(uint32 A, uint32 V);
-MDFN_FASTCALL uint32 IRQ_Read(uint32 A);
-
-
 enum
 {
  IRQ_GSREG_ASSERTED = 0,
@@ -54,8 +47,32 @@ enum
  IRQ_GSREG_MASK = 2
 };
 
-uint32 IRQ_GetRegister(unsigned int which, char *special, const uint32 special_len);
-void IRQ_SetRegister(unsigned int which, uint32 value);
+class PS_IRQ
+{
+ public:
+
+ void SyncState(bool isReader, EW::NewState *ns);
+
+ void Power(void) MDFN_COLD;
+ void Reset(void);
+ void Assert(int which, bool asserted);
+
+ MDFN_FASTCALL void Write(uint32 A, uint32 V);
+ MDFN_FASTCALL uint32 Read(uint32 A);
+
+ uint32 GetRegister(unsigned int which, char *special, const uint32 special_len);
+ void SetRegister(unsigned int which, uint32 value);
+
+ private:
+
+ void Recalc(void);
+
+ uint16 Asserted;
+ uint16 Mask;
+ uint16 Status;
+};
+
+MDFN_HIDE extern EW_THREAD PS_IRQ *IRQ;
 
 }
 
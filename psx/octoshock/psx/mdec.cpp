@@ -22,7 +22,7 @@
 #pragma GCC optimize ("unroll-loops")
 
 /*
- MDEC_READ_FIFO(tfr) vs InCounter vs MDEC_DMACanRead() is a bit fragile right now.  Actually, the entire horrible state machine monstrosity is fragile.
+ MDEC_READ_FIFO(tfr) vs InCounter vs DMACanRead() is a bit fragile right now.  Actually, the entire horrible state machine monstrosity is fragile.
 
  TODO: OutFIFOReady, so <16bpp works right.
 
@@ -68,7 +68,11 @@
 
 #include "masmem.h"
 
-#if defined(__SSE2__) || (defined(ARCH_X86) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)))
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MDEC_SSE2 1
+#endif
+
+#if defined(MDEC_SSE2) || (defined(ARCH_X86) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)))
 #include <xmmintrin.h>
 #include <emmintrin.h>
 #endif
@@ -88,46 +92,6 @@
 namespace MDFN_IEN_PSX
 {
 
-static int32 ClockCounter;
-static unsigned MDRPhase;
-static FastFIFO<uint32, 0x20> InFIFO;
-static FastFIFO<uint32, 0x20> OutFIFO;
-
-static int8 block_y[8][8];
-static int8 block_cb[8][8];	// [y >> 1][x >> 1]
-static int8 block_cr[8][8];	// [y >> 1][x >> 1]
-
-static uint32 Control;
-static uint32 Command;
-static bool InCommand;
-
-static uint8 QMatrix[2][64];
-static uint32 QMIndex;
-
-static EW_VAR_ALIGN(16) int16 IDCTMatrix[64];
-static uint32 IDCTMIndex;
-
-static uint8 QScale;
-
-static EW_VAR_ALIGN(16) int16 Coeff[64];
-static uint32 CoeffIndex;
-static uint32 DecodeWB;
-
-static union
-{
- uint32 pix32[48];
- uint16 pix16[96];
- uint8   pix8[192];
-} PixelBuffer;
-static uint32 PixelBufferReadOffset;
-static uint32 PixelBufferCount32;
-
-static uint16 InCounter;
-
-static uint8 RAMOffsetY;
-static uint8 RAMOffsetCounter;
-static uint8 RAMOffsetWWS;
-
 static const uint8 ZigZag[64] =
 {
  0x00, 0x08, 0x01, 0x02, 0x09, 0x10, 0x18, 0x11, 
@@ -140,7 +104,7 @@ static const uint8 ZigZag[64] =
  0x2e, 0x27, 0x2f, 0x36, 0x3d, 0x3e, 0x37, 0x3f, 
 };
 
-void MDEC_Power(void)
+void PS_MDEC::Power(void)
 {
  ClockCounter = 0;
  MDRPhase = 0;
@@ -179,7 +143,7 @@ void MDEC_Power(void)
  RAMOffsetWWS = 0;
 }
 
-template<bool isReader> void MDEC_SyncState(EW::NewState *ns)
+template<bool isReader> void PS_MDEC::SyncState(EW::NewState *ns)
 {
 	NSS(ClockCounter);
 	NSS(MDRPhase);
@@ -223,10 +187,10 @@ template<bool isReader> void MDEC_SyncState(EW::NewState *ns)
 	}
 }
 
-void MDEC_SyncState(bool isReader, EW::NewState *ns)
+void PS_MDEC::SyncState(bool isReader, EW::NewState *ns)
 {
-	if(isReader) MDEC_SyncState<true>(ns);
-	else MDEC_SyncState<false>(ns);
+	if(isReader) SyncState<true>(ns);
+	else SyncState<false>(ns);
 }
 
 static INLINE int8 Mask9ClampS8(int32 v)
@@ -247,37 +211,114 @@ static INLINE int8 Mask9ClampS8(int32 v)
 //
 #pragma GCC push_options
 
-#if defined(__SSE2__) || (defined(ARCH_X86) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)))
+#if defined(MDEC_SSE2) || (defined(ARCH_X86) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)))
 //
 //
 //
 #pragma GCC target("sse2")
+//
+// Each pass is done as a matrix multiply: an input row is multiplied against (u, u + 1) pairs of every
+// IDCTMatrix row at once with pmaddwd, giving all 8 outputs for that row without any horizontal adds.
+// The 32-bit sums wrap exactly as the scalar version's do.
+//
+static INLINE void IDCT_Row_SSE2(const __m128i (&mp)[4][2], const __m128i c, __m128i& lo, __m128i& hi)
+{
+ // _mm_shuffle_epi32() needs an immediate, which a loop counter isn't without optimization.
+ const __m128i c0 = _mm_shuffle_epi32(c, 0x00);
+ const __m128i c1 = _mm_shuffle_epi32(c, 0x55);
+ const __m128i c2 = _mm_shuffle_epi32(c, 0xAA);
+ const __m128i c3 = _mm_shuffle_epi32(c, 0xFF);
+
+ lo = _mm_madd_epi16(c0, mp[0][0]);
+ hi = _mm_madd_epi16(c0, mp[0][1]);
+ lo = _mm_add_epi32(lo, _mm_madd_epi16(c1, mp[1][0]));
+ hi = _mm_add_epi32(hi, _mm_madd_epi16(c1, mp[1][1]));
+ lo = _mm_add_epi32(lo, _mm_madd_epi16(c2, mp[2][0]));
+ hi = _mm_add_epi32(hi, _mm_madd_epi16(c2, mp[2][1]));
+ lo = _mm_add_epi32(lo, _mm_madd_epi16(c3, mp[3][0]));
+ hi = _mm_add_epi32(hi, _mm_madd_epi16(c3, mp[3][1]));
+
+ lo = _mm_srai_epi32(_mm_add_epi32(lo, _mm_set1_epi32(0x4000)), 15);
+ hi = _mm_srai_epi32(_mm_add_epi32(hi, _mm_set1_epi32(0x4000)), 15);
+}
+
 template<typename T>
-static INLINE void IDCT_1D_Multi(int16 *in_coeff, T *out_coeff)
+INLINE void PS_MDEC::IDCT_1D_Multi(int16 *in_coeff, T *out_coeff)
 {
- for(unsigned col = 0; col < 8; col++)
- {
-  __m128i c =  _mm_load_si128((__m128i *)&in_coeff[(col * 8)]);
+ __m128i mp[4][2];	// [u >> 1][x >> 2], (IDCTMatrix[x][u], IDCTMatrix[x][u + 1]) for 4 x
+ __m128i rows[8];
 
-  for(unsigned x = 0; x < 8; x++)
-  {
-   __m128i sum;
-   __m128i m;
-   alignas(16) int32 tmp[4];
+ for(unsigned h = 0; h < 2; h++)
+ {
+  const __m128i a0 = _mm_load_si128((__m128i *)&IDCTMatrix[(h * 4 + 0) * 8]);
+  const __m128i a1 = _mm_load_si128((__m128i *)&IDCTMatrix[(h * 4 + 1) * 8]);
+  const __m128i a2 = _mm_load_si128((__m128i *)&IDCTMatrix[(h * 4 + 2) * 8]);
+  const __m128i a3 = _mm_load_si128((__m128i *)&IDCTMatrix[(h * 4 + 3) * 8]);
+  const __m128i t0 = _mm_unpacklo_epi32(a0, a1);
+  const __m128i t1 = _mm_unpacklo_epi32(a2, a3);
+  const __m128i t2 = _mm_unpackhi_epi32(a0, a1);
+  const __m128i t3 = _mm_unpackhi_epi32(a2, a3);
+
+  mp[0][h] = _mm_unpacklo_epi64(t0, t1);
+  mp[1][h] = _mm_unpackhi_epi64(t0, t1);
+  mp[2][h] = _mm_unpacklo_epi64(t2, t3);
+  mp[3][h] = _mm_unpackhi_epi64(t2, t3);
+ }
 
-   m = _mm_load_si128((__m128i *)&IDCTMatrix[(x * 8)]);
-   sum = _mm_madd_epi16(m, c);
-   sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, (3 << 0) | (2 << 2) | (1 << 4) | (0 << 6)));
-   sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, (1 << 0) | (0 << 2)));
+ for(unsigned col = 0; col < 8; col++)
+ {
+  __m128i lo, hi;
 
-   //_mm_store_ss((float *)&tmp[0], (__m128)sum);
-   _mm_store_si128((__m128i*)tmp, sum);
+  IDCT_Row_SSE2(mp, _mm_load_si128((__m128i *)&in_coeff[(col * 8)]), lo, hi);
 
-   if(sizeof(T) == 1)
-    out_coeff[(col * 8) + x] = Mask9ClampS8((tmp[0] + 0x4000) >> 15);
-   else
-    out_coeff[(x * 8) + col] = (tmp[0] + 0x4000) >> 15;
+  if(sizeof(T) == 1)
+  {
+   // Mask9ClampS8(): sign-extend from 9 bits, then let the saturating packs do the clamping.
+   lo = _mm_srai_epi32(_mm_slli_epi32(lo, 23), 23);
+   hi = _mm_srai_epi32(_mm_slli_epi32(hi, 23), 23);
   }
+  else
+  {
+   // Truncate to 16 bits, like the store to int16 does.
+   lo = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16);
+   hi = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16);
+  }
+  rows[col] = _mm_packs_epi32(lo, hi);
+ }
+
+ if(sizeof(T) == 1)
+ {
+  for(unsigned col = 0; col < 8; col += 2)
+   _mm_storeu_si128((__m128i *)&out_coeff[(col * 8)], _mm_packs_epi16(rows[col + 0], rows[col + 1]));
+ }
+ else
+ {
+  // Transposed output.
+  const __m128i a0 = _mm_unpacklo_epi16(rows[0], rows[1]);
+  const __m128i a1 = _mm_unpacklo_epi16(rows[2], rows[3]);
+  const __m128i a2 = _mm_unpacklo_epi16(rows[4], rows[5]);
+  const __m128i a3 = _mm_unpacklo_epi16(rows[6], rows[7]);
+  const __m128i a4 = _mm_unpackhi_epi16(rows[0], rows[1]);
+  const __m128i a5 = _mm_unpackhi_epi16(rows[2], rows[3]);
+  const __m128i a6 = _mm_unpackhi_epi16(rows[4], rows[5]);
+  const __m128i a7 = _mm_unpackhi_epi16(rows[6], rows[7]);
+  const __m128i b0 = _mm_unpacklo_epi32(a0, a1);
+  const __m128i b1 = _mm_unpacklo_epi32(a2, a3);
+  const __m128i b2 = _mm_unpackhi_epi32(a0, a1);
+  const __m128i b3 = _mm_unpackhi_epi32(a2, a3);
+  const __m128i b4 = _mm_unpacklo_epi32(a4, a5);
+  const __m128i b5 = _mm_unpacklo_epi32(a6, a7);
+  const __m128i b6 = _mm_unpackhi_epi32(a4, a5);
+  const __m128i b7 = _mm_unpackhi_epi32(a6, a7);
+
+  _mm_store_si128((__m128i *)&out_coeff[0 * 8], _mm_unpacklo_epi64(b0, b1));
+  _mm_store_si128((__m128i *)&out_coeff[1 * 8], _mm_unpackhi_epi64(b0, b1));
+  _mm_store_si128((__m128i *)&out_coeff[2 * 8], _mm_unpacklo_epi64(b2, b3));
+  _mm_store_si128((__m128i *)&out_coeff[3 * 8], _mm_unpackhi_epi64(b2, b3));
+  _mm_store_si128((__m128i *)&out_coeff[4 * 8], _mm_unpacklo_epi64(b4, b5));
+  _mm_store_si128((__m128i *)&out_coeff[5 * 8], _mm_unpackhi_epi64(b4, b5));
+  _mm_store_si128((__m128i *)&out_coeff[6 * 8], _mm_unpacklo_epi64(b6, b7));
+  _mm_store_si128((__m128i *)&out_coeff[7 * 8], _mm_unpackhi_epi64(b6, b7));
  }
 }
 //
@@ -288,7 +329,7 @@ static INLINE void IDCT_1D_Multi(int16 *in_coeff, T *out_coeff)
 //
 //
 template<typename T>
-static INLINE void IDCT_1D_Multi(int16 *in_coeff, T *out_coeff)
+INLINE void PS_MDEC::IDCT_1D_Multi(int16 *in_coeff, T *out_coeff)
 {
  for(unsigned col = 0; col < 8; col++)
  {
@@ -326,7 +367,7 @@ static INLINE void IDCT_1D_Multi(int16 *in_coeff, T *out_coeff)
 //
 //
 template<typename T>
-static INLINE void IDCT_1D_Multi(int16 *in_coeff, T *out_coeff)
+INLINE void PS_MDEC::IDCT_1D_Multi(int16 *in_coeff, T *out_coeff)
 {
  for(unsigned col = 0; col < 8; col++)
  {
@@ -351,7 +392,7 @@ static INLINE void IDCT_1D_Multi(int16 *in_coeff, T *out_coeff)
 //
 #endif
 
-static NO_INLINE void IDCT(int16 *in_coeff, int8 *out_coeff)
+NO_INLINE void PS_MDEC::IDCT(int16 *in_coeff, int8 *out_coeff)
 {
  alignas(16) int16 tmpbuf[64];
 
@@ -397,7 +438,52 @@ static INLINE uint16 RGB_to_RGB555(uint8 r, uint8 g, uint8 b)
  return((r << 0) | (g << 5) | (b << 10));
 }
 
-static void EncodeImage(const unsigned ybn)
+#ifdef MDEC_SSE2
+//
+// YCbCr_to_RGB() for one 8-pixel block row, results(already XOR'd with 0x80) in 16-bit lanes.
+//
+static INLINE void YCbCr_to_RGB_SSE2(const int8* by, const int8* cb, const int8* cr, __m128i& r, __m128i& g, __m128i& b)
+{
+ int32 cb4, cr4;
+ __m128i y, cbv, crv;
+
+ memcpy(&cb4, cb, 4);
+ memcpy(&cr4, cr, 4);
+
+ y = _mm_loadl_epi64((const __m128i*)by);
+ y = _mm_srai_epi16(_mm_unpacklo_epi8(y, y), 8);
+ cbv = _mm_cvtsi32_si128(cb4);
+ cbv = _mm_unpacklo_epi8(cbv, cbv);
+ cbv = _mm_srai_epi16(_mm_unpacklo_epi8(cbv, cbv), 8);
+ crv = _mm_cvtsi32_si128(cr4);
+ crv = _mm_unpacklo_epi8(crv, crv);
+ crv = _mm_srai_epi16(_mm_unpacklo_epi8(crv, crv), 8);
+
+ // 359 * cr and 454 * cb don't fit in 16 bits, so split off the 256 * c part, which passes through the >> 8 exactly.
+ const __m128i rnd = _mm_set1_epi16(0x80);
+ const __m128i rt = _mm_add_epi16(crv, _mm_srai_epi16(_mm_add_epi16(_mm_mullo_epi16(crv, _mm_set1_epi16(359 - 256)), rnd), 8));
+ const __m128i bt = _mm_add_epi16(cbv, _mm_srai_epi16(_mm_add_epi16(_mm_mullo_epi16(cbv, _mm_set1_epi16(454 - 256)), rnd), 8));
+
+ // Both green terms are multiples of 8, so sum them in units of 8 instead.
+ const __m128i ga = _mm_and_si128(_mm_srai_epi16(_mm_mullo_epi16(cbv, _mm_set1_epi16(-88)), 3), _mm_set1_epi16(~0x3));
+ const __m128i gb = _mm_srai_epi16(_mm_mullo_epi16(crv, _mm_set1_epi16(-183)), 3);
+ const __m128i gt = _mm_srai_epi16(_mm_add_epi16(_mm_add_epi16(ga, gb), _mm_set1_epi16(0x80 >> 3)), 5);
+
+ const __m128i smin = _mm_set1_epi16(-128);
+ const __m128i smax = _mm_set1_epi16(127);
+ const __m128i bias = _mm_set1_epi16(0x80);
+
+ r = _mm_add_epi16(y, rt);
+ g = _mm_add_epi16(y, gt);
+ b = _mm_add_epi16(y, bt);
+
+ r = _mm_add_epi16(_mm_max_epi16(_mm_min_epi16(_mm_srai_epi16(_mm_slli_epi16(r, 7), 7), smax), smin), bias);
+ g = _mm_add_epi16(_mm_max_epi16(_mm_min_epi16(_mm_srai_epi16(_mm_slli_epi16(g, 7), 7), smax), smin), bias);
+ b = _mm_add_epi16(_mm_max_epi16(_mm_min_epi16(_mm_srai_epi16(_mm_slli_epi16(b, 7), 7), smax), smin), bias);
+}
+#endif
+
+void PS_MDEC::EncodeImage(const unsigned ybn)
 {
  //printf("ENCODE, %d\n", (Command & 0x08000000) ? 256 : 384);
 
@@ -453,7 +539,23 @@ static void EncodeImage(const unsigned ybn)
     const int8* by = &block_y[y][0];
     const int8* cb = &block_cb[(y >> 1) | ((ybn & 2) << 1)][(ybn & 1) << 2];
     const int8* cr = &block_cr[(y >> 1) | ((ybn & 2) << 1)][(ybn & 1) << 2];
-    
+#ifdef MDEC_SSE2
+    alignas(16) uint8 rgb[3][16];
+    __m128i r, g, b;
+
+    YCbCr_to_RGB_SSE2(by, cb, cr, r, g, b);
+    _mm_store_si128((__m128i*)rgb[0], _mm_packus_epi16(r, r));
+    _mm_store_si128((__m128i*)rgb[1], _mm_packus_epi16(g, g));
+    _mm_store_si128((__m128i*)rgb[2], _mm_packus_epi16(b, b));
+
+    for(int x = 0; x < 8; x++)
+    {
+     pix_out[0] = rgb[0][x] ^ rgb_xor;
+     pix_out[1] = rgb[1][x] ^ rgb_xor;
+     pix_out[2] = rgb[2][x] ^ rgb_xor;
+     pix_out += 3;
+    }
+#else
     for(int x = 0; x < 8; x++)
     {
      int r, g, b;
@@ -465,6 +567,7 @@ static void EncodeImage(const unsigned ybn)
      pix_out[2] = b ^ rgb_xor;
      pix_out += 3;
     }
+#endif
    }
    PixelBufferCount32 = 48;
   }
@@ -480,7 +583,22 @@ static void EncodeImage(const unsigned ybn)
     const int8* by = &block_y[y][0];
     const int8* cb = &block_cb[(y >> 1) | ((ybn & 2) << 1)][(ybn & 1) << 2];
     const int8* cr = &block_cr[(y >> 1) | ((ybn & 2) << 1)][(ybn & 1) << 2];
-
+#ifdef MDEC_SSE2
+    // RGB_to_RGB555(), on the 0...255 channel values.
+    const __m128i c4 = _mm_set1_epi16(4);
+    const __m128i c1f = _mm_set1_epi16(0x1F);
+    __m128i r, g, b, p;
+
+    YCbCr_to_RGB_SSE2(by, cb, cr, r, g, b);
+    r = _mm_min_epi16(_mm_srli_epi16(_mm_add_epi16(r, c4), 3), c1f);
+    g = _mm_min_epi16(_mm_srli_epi16(_mm_add_epi16(g, c4), 3), c1f);
+    b = _mm_min_epi16(_mm_srli_epi16(_mm_add_epi16(b, c4), 3), c1f);
+    p = _mm_or_si128(r, _mm_or_si128(_mm_slli_epi16(g, 5), _mm_slli_epi16(b, 10)));
+    p = _mm_xor_si128(p, _mm_set1_epi16(pixel_xor));
+
+    _mm_storeu_si128((__m128i*)pix_out, p);	// x86 is little-endian, as MDFN_en16lsb() wants.
+    pix_out += 8;
+#else
     for(int x = 0; x < 8; x++)
     {
      int r, g, b;
@@ -490,6 +608,7 @@ static void EncodeImage(const unsigned ybn)
      MDFN_en16lsb<true>(pix_out, pixel_xor ^ RGB_to_RGB555(r, g, b));
      pix_out++;
     }
+#endif
    }
    PixelBufferCount32 = 32;
   }
@@ -498,7 +617,7 @@ static void EncodeImage(const unsigned ybn)
  }
 }
 
-static INLINE void WriteImageData(uint16 V, int32* eat_cycles)
+INLINE void PS_MDEC::WriteImageData(uint16 V, int32* eat_cycles)
 {
  const uint32 qmw = (bool)(DecodeWB < 2);
 
@@ -608,8 +727,10 @@ static INLINE void WriteImageData(uint16 V, int32* eat_cycles)
 #define MDEC_READ_FIFO(n)  { MDEC_WAIT_COND(InFIFO.CanRead()); n = InFIFO.Read(); }
 #define MDEC_EAT_CLOCKS(n) { ClockCounter -= (n); MDEC_WAIT_COND(ClockCounter > 0); }
 
-MDFN_FASTCALL void MDEC_Run(int32 clocks)
+MDFN_FASTCALL void PS_MDEC::Run(int32 clocks)
 {
+ PSX_PROFILE((InCommand || InFIFO.CanRead()) ? PSX_PROF_MDEC : PSX_PROF_KEEP);	// Called all the time from DMA->Update(), usually with nothing to do.
+
  static const unsigned MDRPhaseBias = __COUNTER__ + 1;
 
  //MDFN_DispMessage("%u", OutFIFO.CanRead());
@@ -746,12 +867,12 @@ MDFN_FASTCALL void MDEC_Run(int32 clocks)
 }
 #endif
 
-MDFN_FASTCALL void MDEC_DMAWrite(uint32 V)
+MDFN_FASTCALL void PS_MDEC::DMAWrite(uint32 V)
 {
  if(InFIFO.CanWrite())
  {
   InFIFO.Write(V);
-  MDEC_Run(0);
+  Run(0);
  }
  else
  {
@@ -759,7 +880,7 @@ MDFN_FASTCALL void MDEC_DMAWrite(uint32 V)
  }
 }
 
-MDFN_FASTCALL uint32 MDEC_DMARead(uint32* offs)
+MDFN_FASTCALL uint32 PS_MDEC::DMARead(uint32* offs)
 {
  uint32 V = 0;
 
@@ -783,7 +904,7 @@ MDFN_FASTCALL uint32 MDEC_DMARead(uint32* offs)
    RAMOffsetY++;
   }
 
-  MDEC_Run(0);
+  Run(0);
  }
  else
  {
@@ -793,18 +914,20 @@ MDFN_FASTCALL uint32 MDEC_DMARead(uint32* offs)
  return(V);
 }
 
-bool MDEC_DMACanWrite(void)
+bool PS_MDEC::DMACanWrite(void)
 {
  return((InFIFO.CanWrite() >= 0x20) && (Control & (1U << 30)) && InCommand && InCounter != 0xFFFF);
 }
 
-bool MDEC_DMACanRead(void)
+bool PS_MDEC::DMACanRead(void)
 {
  return((OutFIFO.CanRead() >= 0x20) && (Control & (1U << 29)));
 }
 
-MDFN_FASTCALL void MDEC_Write(const pscpu_timestamp_t timestamp, uint32 A, uint32 V)
+MDFN_FASTCALL void PS_MDEC::Write(const pscpu_timestamp_t timestamp, uint32 A, uint32 V)
 {
+ PSX_PROFILE(PSX_PROF_MDEC);
+
  //PSX_WARNING("[MDEC] Write: 0x%08x 0x%08x, %d  --- %u %u", A, V, timestamp, InFIFO.CanRead(), OutFIFO.CanRead());
  if(A & 4)
  {
@@ -842,7 +965,7 @@ MDFN_FASTCALL void MDEC_Write(const pscpu_timestamp_t timestamp, uint32 A, uint3
     if(ClockCounter < 1)
      ClockCounter = 1;
    }
-   MDEC_Run(0);
+   Run(0);
   }
   else
   {
@@ -851,8 +974,10 @@ MDFN_FASTCALL void MDEC_Write(const pscpu_timestamp_t timestamp, uint32 A, uint3
  }
 }
 
-MDFN_FASTCALL uint32 MDEC_Read(const pscpu_timestamp_t timestamp, uint32 A)
+MDFN_FASTCALL uint32 PS_MDEC::Read(const pscpu_timestamp_t timestamp, uint32 A)
 {
+ PSX_PROFILE(PSX_PROF_MDEC);
+
  uint32 ret = 0;
 
  if(A & 4)
@@ -863,8 +988,8 @@ MDFN_FASTCALL uint32 MDEC_Read(const pscpu_timestamp_t timestamp, uint32 A)
   ret |= (InFIFO.CanWrite() == 0) << 30;
   ret |= InCommand << 29;
 
-  ret |= MDEC_DMACanWrite() << 28;
-  ret |= MDEC_DMACanRead() << 27;
+  ret |= DMACanWrite() << 28;
+  ret |= DMACanRead() << 27;
 
   ret |= ((Command >> 25) & 0xF) << 23;
 
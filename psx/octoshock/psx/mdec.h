@@ -22,22 +22,81 @@
 #ifndef __MDFN_PSX_MDEC_H
 #define __MDFN_PSX_MDEC_H
 
+#include "FastFIFO.h"
+
 namespace MDFN_IEN_PSX
 {
 
-MDFN_FASTCALL void MDEC_DMAWrite(uint32 V);
+class PS_MDEC
+{
+ public:
+
+ template<bool isReader> void SyncState(EW::NewState *ns);
+ void SyncState(bool isReader, EW::NewState *ns);
+
+ MDFN_FASTCALL void DMAWrite(uint32 V);
+
+ MDFN_FASTCALL uint32 DMARead(uint32* offs);
+
+ MDFN_FASTCALL void Write(const pscpu_timestamp_t timestamp, uint32 A, uint32 V);
+ MDFN_FASTCALL uint32 Read(const pscpu_timestamp_t timestamp, uint32 A);
+
+
+ void Power(void) MDFN_COLD;
+
+ bool DMACanWrite(void);
+ bool DMACanRead(void);
+ MDFN_FASTCALL void Run(int32 clocks);
+
+ private:
+
+ template<typename T> void IDCT_1D_Multi(int16 *in_coeff, T *out_coeff);
+ NO_INLINE void IDCT(int16 *in_coeff, int8 *out_coeff);
+ void EncodeImage(const unsigned ybn);
+ void WriteImageData(uint16 V, int32* eat_cycles);
+
+ int32 ClockCounter;
+ unsigned MDRPhase;
+ FastFIFO<uint32, 0x20> InFIFO;
+ FastFIFO<uint32, 0x20> OutFIFO;
+
+ int8 block_y[8][8];
+ int8 block_cb[8][8];	// [y >> 1][x >> 1]
+ int8 block_cr[8][8];	// [y >> 1][x >> 1]
+
+ uint32 Control;
+ uint32 Command;
+ bool InCommand;
+
+ uint8 QMatrix[2][64];
+ uint32 QMIndex;
+
+ EW_VAR_ALIGN(16) int16 IDCTMatrix[64];
+ uint32 IDCTMIndex;
+
+ uint8 QScale;
 
-MDFN_FASTCALL uint32 MDEC_DMARead(uint32* offs);
+ EW_VAR_ALIGN(16) int16 Coeff[64];
+ uint32 CoeffIndex;
+ uint32 DecodeWB;
 
-MDFN_FASTCALL void MDEC_Write(const pscpu_timestamp_t timestamp, uint32 A, uint32 V);
-MDFN_FASTCALL uint32 MDEC_Read(const pscpu_timestamp_t timestamp, uint32 A);
+ union
+ {
+  uint32 pix32[48];
+  uint16 pix16[96];
+  uint8   pix8[192];
+ } PixelBuffer;
+ uint32 PixelBufferReadOffset;
+ uint32 PixelBufferCount32;
 
+ uint16 InCounter;
 
-void MDEC_Power(void) MDFN_COLD;
+ uint8 RAMOffsetY;
+ uint8 RAMOffsetCounter;
+ uint8 RAMOffsetWWS;
+};
 
-bool MDEC_DMACanWrite(void);
-bool MDEC_DMACanRead(void);
-MDFN_FASTCALL void MDEC_Run(int32 clocks);
+MDFN_HIDE extern EW_THREAD PS_MDEC *MDEC;
 
 }
 
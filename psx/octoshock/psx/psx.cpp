@@ -41,9 +41,22 @@
 #include "input/multitap.h"
 
 #include <array>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
 #include <stdarg.h>
 #include <ctype.h>
 
+#ifdef WANT_PSX_PROFILE
+ #if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+  #include <intrin.h>
+ #elif defined(__i386__) || defined(__x86_64__)
+  #include <x86intrin.h>
+ #endif
+#endif
+
 //I apologize for the absolute madness of the resolution management and framebuffer management and normalizing in here.
 //It's grown entirely out of control. The main justification for the original design was not wrecking mednafen internals too much.
 
@@ -55,14 +68,7 @@
 
 //extern MDFNGI EmulatedPSX;
 
-int16 soundbuf[1024 * 1024]; //how big? big enough.
-int VTBackBuffer = 0;
-bool GpuFrameForLag = false;
-static MDFN_Rect VTDisplayRects[2];
 #include	"video/Deinterlacer.h"
-static bool PrevInterlaced;
-static Deinterlacer deint;
-static EmulateSpecStruct espec;
 
 template<typename T> inline void reconstruct(T* t) {
 	t->~T();
@@ -169,31 +175,18 @@ struct MDFN_PseudoRNG	// Based off(but not the same as) public-domain "JKISS" PR
  uint64 lcgo;
 };
 
-static MDFN_PseudoRNG PSX_PRNG;
-
-uint32 PSX_GetRandU32(uint32 mina, uint32 maxa)
-{
- return PSX_PRNG.RandU32(mina, maxa);
-}
-
-static std::vector<CDIF*> *cdifs = NULL;
-static std::vector<const char *> cdifs_scex_ids;
+//the devices of the instance the current export was handed (see PSXBinding)
+EW_THREAD PS_CPU *CPU = NULL;
+EW_THREAD PS_SPU *SPU = NULL;
+EW_THREAD PS_CDC *CDC = NULL;
+EW_THREAD FrontIO *FIO = NULL;
+EW_THREAD PS_IRQ *IRQ = NULL;
+EW_THREAD PS_DMA *DMA = NULL;
+EW_THREAD PS_TIMER *TIMER = NULL;
+EW_THREAD PS_SIO *SIO = NULL;
+EW_THREAD PS_MDEC *MDEC = NULL;
 
-static uint64 Memcard_PrevDC[8];
-static int64 Memcard_SaveDelay[8];
-
-PS_CPU *CPU = NULL;
-PS_SPU *SPU = NULL;
-PS_CDC *CDC = NULL;
-FrontIO *FIO = NULL;
-
-static MultiAccessSizeMem<512 * 1024, false> *BIOSROM = NULL;
-static MultiAccessSizeMem<65536, false> *PIOMem = NULL;
-
-MultiAccessSizeMem<2048 * 1024, false> MainRAM;
-
-static uint32 TextMem_Start;
-static std::vector<uint8> TextMem;
+EW_THREAD MultiAccessSizeMem<2048 * 1024, false> *MainRAM = NULL;
 
 static const uint32 SysControl_Mask[9] = { 0x00ffffff, 0x00ffffff, 0xffffffff, 0x2f1fffff,
 					   0xffffffff, 0x2f1fffff, 0x2f1fffff, 0xffffffff,
@@ -203,7 +196,7 @@ static const uint32 SysControl_OR[9] = { 0x1f000000, 0x1f000000, 0x00000000, 0x0
 					 0x00000000, 0x00000000, 0x00000000, 0x00000000,
 					 0x00000000 };
 
-static struct
+struct SysControlRegs
 {
  union
  {
@@ -222,25 +215,12 @@ static struct
   };
   uint32 Regs[9];
  };
-} SysControl;
-
-static unsigned DMACycleSteal = 0;	// Doesn't need to be saved in save states, since it's recalculated in the ForceEventUpdates() call chain.
-
-void PSX_SetDMACycleSteal(unsigned stealage)
-{
- if(stealage > 200)	// Due to 8-bit limitations in the CPU core.
-  stealage = 200;
-
- DMACycleSteal = stealage;
-}
-
+};
 
 //
 // Event stuff
 //
 
-static pscpu_timestamp_t Running;	// Set to -1 when not desiring exit, and 0 when we are.
-
 struct event_list_entry
 {
  uint32 which;
@@ -249,114 +229,617 @@ struct event_list_entry
  event_list_entry *next;
 };
 
-static event_list_entry events[PSX_EVENT__COUNT];
+#ifdef WANT_PSX_PROFILE
+//
+// Switches happen on nearly every register access, so on x86 count TSC ticks(a few ns) rather than asking the OS clock(~50ns),
+// and scale the totals to nanoseconds against steady_clock in shock_GetProfile().
+//
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
+static INLINE uint64 ProfileTicks(void) { return __rdtsc(); }
+#else
+static INLINE uint64 ProfileTicks(void) { return std::chrono::steady_clock::now().time_since_epoch().count(); }
+#endif
+#endif
 
-static void EventReset(void)
+struct ShockConfig
 {
- for(unsigned i = 0; i < PSX_EVENT__COUNT; i++)
- {
-  events[i].which = i;
+	//// multires is a hint that, if set, indicates that the system has fairly programmable video modes(particularly, the ability
+	//// to display multiple horizontal resolutions, such as the PCE, PC-FX, or Genesis).  In practice, it will cause the driver
+	//// code to set the linear interpolation on by default. (TRUE for psx)
+	//// lcm_width and lcm_height are the least common multiples of all possible
+	//// resolutions in the frame buffer as specified by DisplayRect/LineWidths(Ex for PCE: widths of 256, 341.333333, 512,
+	//// lcm = 1024)
+	//// nominal_width and nominal_height specify the resolution that Mednafen should display
+	//// the framebuffer image in at 1x scaling, scaled from the dimensions of DisplayRect, and optionally the LineWidths array
+	//// passed through espec to the Emulate() function.
+	//int lcm_width;
+	//int lcm_height;
+	//int nominal_width;
+	//int nominal_height;
+	int fb_width;		// Width of the framebuffer(not necessarily width of the image).  MDFN_Surface width should be >= this.
+	int fb_height;		// Height of the framebuffer passed to the Emulate() function(not necessarily height of the image)
 
-  if(i == PSX_EVENT__SYNFIRST)
-   events[i].event_time = (int32)0x80000000;
-  else if(i == PSX_EVENT__SYNLAST)
-   events[i].event_time = 0x7FFFFFFF;
-  else
-   events[i].event_time = PSX_EVENT_MAXTS;
+	//last used render options
+	ShockRenderOptions opts;
+};
 
-  events[i].prev = (i > 0) ? &events[i - 1] : NULL;
-  events[i].next = (i < (PSX_EVENT__COUNT - 1)) ? &events[i + 1] : NULL;
- }
-}
 
-//static void RemoveEvent(event_list_entry *e)
-//{
-// e->prev->next = e->next;
-// e->next->prev = e->prev;
-//}
+struct ShockState
+{
+	bool power;
+	bool eject;
+};
+
 
-static void RebaseTS(const pscpu_timestamp_t timestamp)
+struct ShockPeripheral
 {
- for(unsigned i = 0; i < PSX_EVENT__COUNT; i++)
- {
-  if(i == PSX_EVENT__SYNFIRST || i == PSX_EVENT__SYNLAST)
-   continue;
+	ePeripheralType type = ePeripheralType_None;
+	u8 buffer[32]; //must be larger than 16+3+1 or thereabouts because the dualshock writes some rumble data into it. bleck, ill fix it later
+	//TODO: test for multitap. does it need to be as large as 4 of whatever the single largest port would be?
+	//well, it must manage its own stuff.. its not like we feed in external data, right?
+	InputDevice* device = nullptr;
 
-  assert(events[i].event_time > timestamp);
-  events[i].event_time -= timestamp;
- }
+	~ShockPeripheral()
+	{
+		//do not do this! FIO takes care of finishing this off
+		//I know, it's all a mess
+		//delete device;
+	}
+};
 
- CPU->SetEventNT(events[PSX_EVENT__SYNFIRST].next->event_time);
+static int addressToPortNum(int address)
+{
+	int portnum = SHOCK_INVALID_ADDRESS;
+	//WHY did I choose 1 indexed? I dunno, let's roll with it
+	if (address == 0x01) portnum = 0;
+	else if (address == 0x02) portnum = 1;
+	else if (address == 0x11) portnum = 2;
+	else if (address == 0x21) portnum = 3;
+	else if (address == 0x31) portnum = 4;
+	else if (address == 0x41) portnum = 5;
+	else if (address == 0x12) portnum = 6;
+	else if (address == 0x22) portnum = 7;
+	else if (address == 0x32) portnum = 8;
+	else if (address == 0x42) portnum = 9;
+	return portnum;
 }
 
-void PSX_SetEventNT(const int type, const pscpu_timestamp_t next_timestamp)
+struct ShockPeripheralState
 {
- event_list_entry *e = &events[type];
 
- if(next_timestamp < e->event_time)
- {
-  event_list_entry *fe = e;
+	//"This is kind of redundant with the frontIO code, and should be merged with it eventually, when the configurability gets more advanced"
+	//I dunno.
 
-  do
-  {
-   fe = fe->prev;
-  }
-  while(next_timestamp < fe->event_time);
+	std::array<ShockPeripheral,10> ports;
 
-  // Remove this event from the list, temporarily of course.
-  e->prev->next = e->next;
-  e->next->prev = e->prev;
+	void Initialize()
+	{
+		reconstruct(&ports);
+		for(int i=0;i<10;i++)
+			memset(ports[i].buffer,0,sizeof(ports[i].buffer));
+		reconstruct(FIO);
+	}
 
-  // Insert into the list, just after "fe".
-  e->prev = fe;
-  e->next = fe->next;
-  fe->next->prev = e;
-  fe->next = e;
+	//TODO: "Take care to call ->Power() only if the device actually changed."
+	//(like, is this about savestates? seems silly"
+	s32 Connect(s32 address, s32 type)
+	{
+		int portnum = addressToPortNum(address);
+		if(portnum == SHOCK_INVALID_ADDRESS) return SHOCK_INVALID_ADDRESS;
 
-  e->event_time = next_timestamp;
- }
- else if(next_timestamp > e->event_time)
- {
-  event_list_entry *fe = e;
+		//check whats already there
+		if(ports[portnum].type == ePeripheralType_None && type == ePeripheralType_None) return SHOCK_OK; //NOP
+		if(ports[portnum].type != ePeripheralType_None && type != ePeripheralType_None) return SHOCK_NOCANDO; //cant re-connect something without disconnecting first
 
-  do
-  {
-   fe = fe->next;
-  } while(next_timestamp > fe->event_time);
+		//disconnecting:
+		if(type == ePeripheralType_None) {
+			ports[portnum].type = ePeripheralType_None;
+			memset(ports[portnum].buffer,0,sizeof(ports[portnum].buffer));
+			
+			//fall through to setup a nonexistent `next` for disconnecting, instead of returning now
+		}
 
-  // Remove this event from the list, temporarily of course
-  e->prev->next = e->next;
-  e->next->prev = e->prev;
+		//connecting:
+		InputDevice* next = nullptr;
+		switch(type)
+		{
+		case ePeripheralType_Pad: next = Device_Gamepad_Create(); break;
+		case ePeripheralType_DualShock: next = Device_DualShock_Create(); break;
+		case ePeripheralType_DualAnalog: next = Device_DualAnalog_Create(false); break;
+		case ePeripheralType_Multitap: next = new InputDevice_Multitap(); break;
+		case ePeripheralType_NegCon: next = Device_neGcon_Create(); break;
+		case ePeripheralType_None: next = new InputDevice(); break; //dummy
+			break;
+		default:
+			return SHOCK_ERROR;
+		}
+		ports[portnum].type = (ePeripheralType)type;
+		if(ports[portnum].device) delete ports[portnum].device;
+		ports[portnum].device = next;
+		memset(ports[portnum].buffer,0,sizeof(ports[portnum].buffer));
 
-  // Insert into the list, just BEFORE "fe".
-  e->prev = fe->prev;
-  e->next = fe;
-  fe->prev->next = e;
-  fe->prev = e;
+		if (portnum == 0 || portnum == 1)
+		{
+			FIO->Ports[portnum] = next;
+			FIO->PortData[portnum] = ports[portnum].buffer;
+		}
+		else {
+			//must be multitap child device
+			int portidx = (address & 0xF) - 1;
+			int subidx = (address >> 4) - 1;
+			auto tap = (InputDevice_Multitap*)FIO->Ports[portidx];
+			auto mcdummy = new InputDevice();
+			//next->
+			tap->SetSubDevice(subidx, next, mcdummy);
+		}
 
-  e->event_time = next_timestamp;
- }
+		return SHOCK_OK;
+	}
 
- CPU->SetEventNT(events[PSX_EVENT__SYNFIRST].next->event_time & Running);
-}
+	s32 PollActive(s32 address, bool clear)
+	{
+		int portnum = addressToPortNum(address);
+		if (portnum == SHOCK_INVALID_ADDRESS) return SHOCK_INVALID_ADDRESS;
 
-// Called from debug.cpp too.
-void ForceEventUpdates(const pscpu_timestamp_t timestamp)
-{
- PSX_SetEventNT(PSX_EVENT_GPU, GPU_Update(timestamp));
- PSX_SetEventNT(PSX_EVENT_CDC, CDC->Update(timestamp));
+		s32 ret = SHOCK_FALSE;
 
- PSX_SetEventNT(PSX_EVENT_TIMER, TIMER_Update(timestamp));
+		u8* buf = ports[portnum].buffer;
+		switch(ports[portnum].type)
+		{
+		case ePeripheralType_DualShock:
+			{
+				IO_Dualshock* io_dualshock = (IO_Dualshock*)buf;
+				if(io_dualshock->active) ret = SHOCK_TRUE;
+				if(clear) io_dualshock->active = 0;
+				return ret;
+				break;
+			}
+		case ePeripheralType_DualAnalog:
+			{
+				IO_DualAnalog* io_dualanalog = (IO_DualAnalog*)buf;
+				if(io_dualanalog->active) ret = SHOCK_TRUE;
+				if(clear) io_dualanalog->active = 0;
+				return ret;
+				break;
+			}
+		case ePeripheralType_Pad:
+			{
+				IO_Gamepad* io_gamepad = (IO_Gamepad*)buf;
+				if(io_gamepad->active) ret = SHOCK_TRUE;
+				if(clear) io_gamepad->active = 0;
+				return ret;
+				break;
+			}
+		case ePeripheralType_NegCon:
+		{
+			IO_NegCon* io_negcon = (IO_NegCon*)buf;
+			if (io_negcon->active) ret = SHOCK_TRUE;
+			if (clear) io_negcon->active = 0;
+			return ret;
+			break;
+		}
 
- PSX_SetEventNT(PSX_EVENT_DMA, DMA_Update(timestamp));
+		case ePeripheralType_None:
+			return SHOCK_NOCANDO;
 
- PSX_SetEventNT(PSX_EVENT_FIO, FIO->Update(timestamp));
+		default:
+			return SHOCK_ERROR;
+		}
+	}
 
- CPU->SetEventNT(events[PSX_EVENT__SYNFIRST].next->event_time);
-}
+	s32 SetPadInput(s32 address, u32 buttons, u8 left_x, u8 left_y, u8 right_x, u8 right_y)
+	{
+		int portnum = addressToPortNum(address);
+		if (portnum == SHOCK_INVALID_ADDRESS) return SHOCK_INVALID_ADDRESS;
 
-bool MDFN_FASTCALL PSX_EventHandler(const pscpu_timestamp_t timestamp)
-{
+		u8* buf = ports[portnum].buffer;
+		switch(ports[portnum].type)
+		{
+		case ePeripheralType_DualShock:
+			{
+				IO_Dualshock* io_dualshock = (IO_Dualshock*)buf;
+				io_dualshock->buttons[0] = (buttons>>0)&0xFF;
+				io_dualshock->buttons[1] = (buttons>>8)&0xFF;
+				io_dualshock->buttons[2] = (buttons>>16)&0xFF; //this is only the analog mode button
+				io_dualshock->right_x = right_x;
+				io_dualshock->right_y = right_y;
+				io_dualshock->left_x = left_x;
+				io_dualshock->left_y = left_y;
+				return SHOCK_OK;
+			}
+		case ePeripheralType_Pad:
+			{
+				IO_Gamepad* io_gamepad = (IO_Gamepad*)buf;
+				io_gamepad->buttons[0] = (buttons>>0)&0xFF;
+				io_gamepad->buttons[1] = (buttons>>8)&0xFF;
+				return SHOCK_OK;
+			}
+		case ePeripheralType_DualAnalog:
+			{
+				IO_DualAnalog* io_dualanalog = (IO_DualAnalog*)buf;
+				io_dualanalog->buttons[0] = (buttons>>0)&0xFF;
+				io_dualanalog->buttons[1] = (buttons>>8)&0xFF;
+				io_dualanalog->right_x = right_x;
+				io_dualanalog->right_y = right_y;
+				io_dualanalog->left_x = left_x;
+				io_dualanalog->left_y = left_y;
+				return SHOCK_OK;
+			}
+		case ePeripheralType_NegCon:
+			{
+				IO_NegCon* io_negcon = (IO_NegCon*)buf;
+				io_negcon->buttons[0] = (buttons >> 0) & 0xFF;
+				io_negcon->buttons[1] = (buttons >> 8) & 0xFF;
+				io_negcon->twist = left_x;
+				io_negcon->anabuttons[0] = left_y;
+				io_negcon->anabuttons[1] = right_x;
+				io_negcon->anabuttons[2] = right_y;
+				return SHOCK_OK;
+			}
+		
+		default:
+			return SHOCK_ERROR;
+		}
+	}
+
+	s32 MemcardTransact(s32 address, ShockMemcardTransaction* transaction)
+	{
+		int portnum = addressToPortNum(address);
+		if (portnum == SHOCK_INVALID_ADDRESS) return SHOCK_INVALID_ADDRESS;
+
+		//TODO - once we get flexible here, do some extra condition checks.. whether memcards exist, etc. much like devices.
+		switch(transaction->transaction)
+		{
+			case eShockMemcardTransaction_Connect: 
+				//cant connect when a memcard is already connected
+				if(!strcmp(FIO->MCPorts[portnum]->GetName(),"InputDevice_Memcard"))
+					return SHOCK_NOCANDO;
+				delete FIO->MCPorts[portnum]; //delete dummy
+				FIO->MCPorts[portnum] = Device_Memcard_Create();
+			
+			case eShockMemcardTransaction_Disconnect: 
+				return SHOCK_ERROR; //not supported yet
+
+			case eShockMemcardTransaction_Write:
+				FIO->MCPorts[portnum]->WriteNV((uint8*)transaction->buffer128k,0,128*1024);
+				FIO->MCPorts[portnum]->ResetNVDirtyCount();
+				return SHOCK_OK;
+
+			case eShockMemcardTransaction_Read:
+			{
+				const u8* ptr = FIO->MCPorts[portnum]->ReadNV();
+				memcpy(transaction->buffer128k,ptr,128*1024);
+				FIO->MCPorts[portnum]->ResetNVDirtyCount();
+				return SHOCK_OK;
+			}
+
+			case eShockMemcardTransaction_CheckDirty:
+				if(FIO->GetMemcardDirtyCount(portnum))
+					return SHOCK_TRUE;
+				else return SHOCK_FALSE;
+
+			default:
+				return SHOCK_ERROR;
+		}
+	}
+
+	void UpdateInput()
+	{
+		for(int i=0;i<ports.size();i++)
+		{
+			if(ports[i].device)
+				ports[i].device->UpdateInput(ports[i].buffer);
+		}
+	}
+
+};
+
+struct FramebufferCropInfo
+{
+	int width, height, xo, yo;
+};
+
+//everything one emulated PSX owns. the handle shock_Create gives out points at one of these, and the exports
+//bind it (see PSXBinding) before calling through it, so any number of instances can live on any threads.
+class PSX
+{
+public:
+	~PSX();
+
+	static void Bind(PSX* psx);
+
+	s32 Create(s32 region, void* firmware512k);
+	s32 Peripheral_Connect(s32 address, s32 type);
+	s32 Peripheral_SetPadInput(s32 address, u32 buttons, u8 left_x, u8 left_y, u8 right_x, u8 right_y);
+	s32 Peripheral_PollActive(s32 address, s32 clear);
+	s32 Peripheral_MemcardTransact(s32 address, ShockMemcardTransaction* transaction);
+	s32 PowerOn();
+	s32 SoftReset();
+	s32 PowerOff();
+	s32 Step(eShockStep step);
+	s32 GetSamples(void* buffer);
+	s32 GetFramebuffer(ShockFramebufferInfo* fb);
+	s32 GetFramebufferView(ShockFramebufferView* fb);
+	s32 MountEXE(void* exebuf, s32 size, s32 ignore_pcsp);
+	s32 SetDisc(ShockDiscRef* disc);
+	s32 PokeDisc(ShockDiscRef* disc);
+	s32 OpenTray();
+	s32 CloseTray();
+	s32 GetMemData(void** ptr, s32* size, s32 memType);
+	s32 StateTransaction(ShockStateTransaction* transaction);
+	s32 GetRegisters_CPU(ShockRegisters_CPU* buffer);
+	s32 SetRegister_CPU(s32 index, u32 value);
+	s32 SetRenderOptions(ShockRenderOptions* opts);
+	s32 SetTraceCallback(void* opaque, ShockCallback_Trace callback);
+	s32 SetBinaryTrace(ShockTraceRecord* buffer, s32 capacity, void* opaque, ShockCallback_TraceFlush flush);
+	s32 SetMemCb(ShockCallback_Mem callback, eShockMemCb cbMask, const ShockMemCbRange* ranges, s32 nranges);
+	s32 SetLEC(bool enabled);
+	s32 GetGPUUnlagged();
+	s32 GetProfile(ShockProfile* profile);
+	s32 PeekMemory(u32 address, u8* value);
+	s32 PokeMemory(u32 address, u8 value);
+
+	template<bool isReader>void SyncState(EW::NewState *ns);
+
+	INLINE pscpu_timestamp_t EventNextTS(void);
+	void EventReset(void);
+	void RebaseTS(const pscpu_timestamp_t timestamp);
+	void SetEventNT(const int type, const pscpu_timestamp_t next_timestamp);
+	void ForceEventUpdates(const pscpu_timestamp_t timestamp);
+	bool EventHandler(const pscpu_timestamp_t timestamp);
+	void RequestMLExit(void);
+	void SetDMACycleSteal(unsigned stealage);
+#ifdef WANT_PSX_PROFILE
+	unsigned ProfileSwitch(unsigned which);
+#endif
+
+	template<typename T, bool IsWrite, bool Access24> INLINE void MemRW(pscpu_timestamp_t &timestamp, uint32 A, uint32 &V);
+	template<typename T, bool Access24> INLINE uint32 MemPeek(pscpu_timestamp_t timestamp, uint32 A);
+	template<typename T, bool Access24> INLINE void MemPoke(pscpu_timestamp_t timestamp, uint32 A, T V);
+
+	void Power(bool powering_up);
+	void MountCPUAddressSpace();
+	void _shock_AnalyzeFramebufferCropInfo(int fbIndex, FramebufferCropInfo* info);
+	void NormalizeFramebuffer();
+	void PrepareFramebuffer(s32 flags, ShockFramebufferView* view);
+	MDFN_COLD void LoadEXE(const uint8 *data, const uint32 size, bool ignore_pcsp = false);
+	s32 _shock_SetOrPokeDisc(ShockDiscRef* disc, bool poke);
+
+	PS_CPU *CPU;
+	PS_SPU *SPU;
+	PS_CDC *CDC;
+	PS_GPU *GPU;
+	FrontIO *FIO;
+	PS_IRQ *IRQ;
+	PS_DMA *DMA;
+	PS_TIMER *TIMER;
+	PS_SIO *SIO;
+	PS_MDEC *MDEC;
+
+	MultiAccessSizeMem<512 * 1024, false> *BIOSROM;
+	MultiAccessSizeMem<65536, false> *PIOMem;
+	MultiAccessSizeMem<2048 * 1024, false> *MainRAM;
+
+	uint32 TextMem_Start;
+	std::vector<uint8> TextMem;
+
+	SysControlRegs SysControl;
+	unsigned DMACycleSteal;	// Doesn't need to be saved in save states, since it's recalculated in the ForceEventUpdates() call chain.
+
+	MDFN_PseudoRNG PSX_PRNG;
+
+	std::vector<CDIF*> *cdifs;
+	std::vector<const char *> cdifs_scex_ids;
+
+	uint64 Memcard_PrevDC[8];
+	int64 Memcard_SaveDelay[8];
+
+	pscpu_timestamp_t Running;	// Set to -1 when not desiring exit, and 0 when we are.
+
+	event_list_entry events[PSX_EVENT__COUNT];
+
+#ifdef WANT_PSX_PROFILE
+	uint64 ProfileTime[PSX_PROF__COUNT];
+	unsigned ProfileCur;
+	uint64 ProfileLast;
+	uint64 ProfileCalibTicks;
+	std::chrono::steady_clock::time_point ProfileCalibTime;
+#endif
+
+	int16* soundbuf; //1024 * 1024 samples. how big? big enough.
+	int VTBackBuffer;
+	bool GpuFrameForLag;
+	MDFN_Rect VTDisplayRects[2];
+	bool PrevInterlaced;
+	Deinterlacer deint;
+	EmulateSpecStruct espec;
+
+	MDFN_Surface *VTBuffer[2];
+	int *VTLineWidths[2];
+	bool s_FramebufferNormalized;
+	int s_FramebufferCurrent;
+	int s_FramebufferCurrentWidth;
+
+	ShockConfig s_ShockConfig;
+	ShockState s_ShockState;
+	ShockPeripheralState s_ShockPeripheralState;
+
+	//cached eShockStateTransaction_BinarySize; the layout only changes when peripherals are (dis)connected
+	s32 s_StateSize;
+
+	ShockDiscRef* s_CurrDisc;
+	ShockDiscInfo s_CurrDiscInfo;
+};
+
+//the instance the current export was handed; NULL outside of one
+static EW_THREAD PSX* s_PSX = NULL;
+
+//points s_PSX and the device pointers the cores share (CPU, GPU, IRQ, ...) at an instance for the length of an export.
+//the previous binding is put back afterwards, so a frontend callback can safely call into another instance
+struct PSXBinding
+{
+	PSXBinding(void* psx) : prev(s_PSX) { PSX::Bind((PSX*)psx); }
+	~PSXBinding() { PSX::Bind(prev); }
+	PSX* operator->() const { return s_PSX; }
+
+	PSX* const prev;
+};
+
+void PSX::Bind(PSX* psx)
+{
+	s_PSX = psx;
+
+	MDFN_IEN_PSX::CPU = psx ? psx->CPU : NULL;
+	MDFN_IEN_PSX::SPU = psx ? psx->SPU : NULL;
+	MDFN_IEN_PSX::CDC = psx ? psx->CDC : NULL;
+	MDFN_IEN_PSX::GPU = psx ? psx->GPU : NULL;
+	MDFN_IEN_PSX::FIO = psx ? psx->FIO : NULL;
+	MDFN_IEN_PSX::IRQ = psx ? psx->IRQ : NULL;
+	MDFN_IEN_PSX::DMA = psx ? psx->DMA : NULL;
+	MDFN_IEN_PSX::TIMER = psx ? psx->TIMER : NULL;
+	MDFN_IEN_PSX::SIO = psx ? psx->SIO : NULL;
+	MDFN_IEN_PSX::MDEC = psx ? psx->MDEC : NULL;
+	MDFN_IEN_PSX::MainRAM = psx ? psx->MainRAM : NULL;
+}
+
+uint32 PSX_GetRandU32(uint32 mina, uint32 maxa)
+{
+ return s_PSX->PSX_PRNG.RandU32(mina, maxa);
+}
+
+void PSX::SetDMACycleSteal(unsigned stealage)
+{
+ if(stealage > 200)	// Due to 8-bit limitations in the CPU core.
+  stealage = 200;
+
+ DMACycleSteal = stealage;
+}
+
+void PSX_SetDMACycleSteal(unsigned stealage)
+{
+ s_PSX->SetDMACycleSteal(stealage);
+}
+
+INLINE pscpu_timestamp_t PSX::EventNextTS(void)
+{
+ return events[PSX_EVENT__SYNFIRST].next->event_time;
+}
+
+void PSX::EventReset(void)
+{
+ for(unsigned i = 0; i < PSX_EVENT__COUNT; i++)
+ {
+  events[i].which = i;
+
+  if(i == PSX_EVENT__SYNFIRST)
+   events[i].event_time = (int32)0x80000000;
+  else if(i == PSX_EVENT__SYNLAST)
+   events[i].event_time = 0x7FFFFFFF;
+  else
+   events[i].event_time = PSX_EVENT_MAXTS;
+
+  events[i].prev = (i > 0) ? &events[i - 1] : NULL;
+  events[i].next = (i < (PSX_EVENT__COUNT - 1)) ? &events[i + 1] : NULL;
+ }
+}
+
+void PSX::RebaseTS(const pscpu_timestamp_t timestamp)
+{
+ for(unsigned i = 0; i < PSX_EVENT__COUNT; i++)
+ {
+  if(i == PSX_EVENT__SYNFIRST || i == PSX_EVENT__SYNLAST)
+   continue;
+
+  assert(events[i].event_time > timestamp);
+  events[i].event_time -= timestamp;
+ }
+
+ CPU->SetEventNT(EventNextTS());
+}
+
+void PSX::SetEventNT(const int type, const pscpu_timestamp_t next_timestamp)
+{
+ event_list_entry *e = &events[type];
+
+ if(next_timestamp < e->event_time)
+ {
+  event_list_entry *fe = e;
+
+  do
+  {
+   fe = fe->prev;
+  }
+  while(next_timestamp < fe->event_time);
+
+  // Remove this event from the list, temporarily of course.
+  e->prev->next = e->next;
+  e->next->prev = e->prev;
+
+  // Insert into the list, just after "fe".
+  e->prev = fe;
+  e->next = fe->next;
+  fe->next->prev = e;
+  fe->next = e;
+
+  e->event_time = next_timestamp;
+ }
+ else if(next_timestamp > e->event_time)
+ {
+  event_list_entry *fe = e;
+
+  do
+  {
+   fe = fe->next;
+  } while(next_timestamp > fe->event_time);
+
+  // Remove this event from the list, temporarily of course
+  e->prev->next = e->next;
+  e->next->prev = e->prev;
+
+  // Insert into the list, just BEFORE "fe".
+  e->prev = fe->prev;
+  e->next = fe;
+  fe->prev->next = e;
+  fe->prev = e;
+
+  e->event_time = next_timestamp;
+ }
+
+ CPU->SetEventNT(EventNextTS() & Running);
+}
+
+void PSX_SetEventNT(const int type, const pscpu_timestamp_t next_timestamp)
+{
+ s_PSX->SetEventNT(type, next_timestamp);
+}
+
+void PSX_CancelEvent(const int type)
+{
+ PSX_SetEventNT(type, PSX_EVENT_MAXTS);
+}
+
+void PSX::ForceEventUpdates(const pscpu_timestamp_t timestamp)
+{
+ SetEventNT(PSX_EVENT_GPU, GPU->Update(timestamp));
+ SetEventNT(PSX_EVENT_CDC, CDC->Update(timestamp));
+
+ SetEventNT(PSX_EVENT_TIMER, TIMER->Update(timestamp));
+
+ SetEventNT(PSX_EVENT_DMA, DMA->Update(timestamp));
+
+ SetEventNT(PSX_EVENT_FIO, FIO->Update(timestamp));
+
+ CPU->SetEventNT(EventNextTS());
+}
+
+// Called from debug.cpp too.
+void ForceEventUpdates(const pscpu_timestamp_t timestamp)
+{
+ s_PSX->ForceEventUpdates(timestamp);
+}
+
+bool PSX::EventHandler(const pscpu_timestamp_t timestamp)
+{
  event_list_entry *e = events[PSX_EVENT__SYNFIRST].next;
 
  while(timestamp >= e->event_time)	// If Running = 0, PSX_EventHandler() may be called even if there isn't an event per-se, so while() instead of do { ... } while
@@ -369,7 +852,7 @@ bool MDFN_FASTCALL PSX_EventHandler(const pscpu_timestamp_t timestamp)
    default: abort();
 
    case PSX_EVENT_GPU:
-	nt = GPU_Update(e->event_time);
+	nt = GPU->Update(e->event_time);
 	break;
 
    case PSX_EVENT_CDC:
@@ -377,11 +860,11 @@ bool MDFN_FASTCALL PSX_EventHandler(const pscpu_timestamp_t timestamp)
 	break;
 
    case PSX_EVENT_TIMER:
-	nt = TIMER_Update(e->event_time);
+	nt = TIMER->Update(e->event_time);
 	break;
 
    case PSX_EVENT_DMA:
-	nt = DMA_Update(e->event_time);
+	nt = DMA->Update(e->event_time);
 	break;
 
    case PSX_EVENT_FIO:
@@ -392,29 +875,61 @@ bool MDFN_FASTCALL PSX_EventHandler(const pscpu_timestamp_t timestamp)
   assert(nt > e->event_time);
 #endif
 
-  PSX_SetEventNT(e->which, nt);
+  SetEventNT(e->which, nt);
 
-  // Order of events can change due to calling PSX_SetEventNT(), this prev business ensures we don't miss an event due to reordering.
+  // Order of events can change due to calling SetEventNT(), this prev business ensures we don't miss an event due to reordering.
   e = prev->next;
  }
 
  return(Running);
 }
 
+bool MDFN_FASTCALL PSX_EventHandler(const pscpu_timestamp_t timestamp)
+{
+ return s_PSX->EventHandler(timestamp);
+}
 
-void PSX_RequestMLExit(void)
+void PSX::RequestMLExit(void)
 {
  Running = 0;
  CPU->SetEventNT(0);
 }
 
+void PSX_RequestMLExit(void)
+{
+ s_PSX->RequestMLExit();
+}
+
+
+#ifdef WANT_PSX_PROFILE
+unsigned PSX::ProfileSwitch(unsigned which)
+{
+ const unsigned prev = ProfileCur;
+
+ if(which == PSX_PROF_KEEP || which == prev)
+  return prev;
+
+ const uint64 now = ProfileTicks();
+
+ ProfileTime[prev] += now - ProfileLast;
+ ProfileLast = now;
+ ProfileCur = which;
+
+ return prev;
+}
+
+unsigned PSX_ProfileSwitch(unsigned which)
+{
+ return s_PSX->ProfileSwitch(which);
+}
+#endif
 
 //
 // End event stuff
 //
 
 // Remember to update MemPeek<>() and MemPoke<>() when we change address decoding in MemRW()
-template<typename T, bool IsWrite, bool Access24> static INLINE void MemRW(pscpu_timestamp_t &timestamp, uint32 A, uint32 &V)
+template<typename T, bool IsWrite, bool Access24> INLINE void PSX::MemRW(pscpu_timestamp_t &timestamp, uint32 A, uint32 &V)
 {
  #if 0
  if(IsWrite)
@@ -440,16 +955,16 @@ template<typename T, bool IsWrite, bool Access24> static INLINE void MemRW(pscpu
   if(Access24)
   {
    if(IsWrite)
-    MainRAM.WriteU24(A & 0x1FFFFF, V);
+    MainRAM->WriteU24(A & 0x1FFFFF, V);
    else
-    V = MainRAM.ReadU24(A & 0x1FFFFF);
+    V = MainRAM->ReadU24(A & 0x1FFFFF);
   }
   else
   {
    if(IsWrite)
-    MainRAM.Write<T>(A & 0x1FFFFF, V);
+    MainRAM->Write<T>(A & 0x1FFFFF, V);
    else
-    V = MainRAM.Read<T>(A & 0x1FFFFF);
+    V = MainRAM->Read<T>(A & 0x1FFFFF);
   }
 
   return;
@@ -468,8 +983,8 @@ template<typename T, bool IsWrite, bool Access24> static INLINE void MemRW(pscpu
   return;
  }
 
- if(timestamp >= events[PSX_EVENT__SYNFIRST].next->event_time)
-  PSX_EventHandler(timestamp);
+ if(timestamp >= EventNextTS())
+  EventHandler(timestamp);
 
  if(A >= 0x1F801000 && A <= 0x1F802FFF)
  {
@@ -486,7 +1001,7 @@ template<typename T, bool IsWrite, bool Access24> static INLINE void MemRW(pscpu
     {
      //timestamp += 15;
 
-     //if(timestamp >= events[PSX_EVENT__SYNFIRST].next->event_time)
+     //if(timestamp >= EventNextTS())
      // PSX_EventHandler(timestamp);
 
      SPU->Write(timestamp, A | 0, V);
@@ -496,8 +1011,8 @@ template<typename T, bool IsWrite, bool Access24> static INLINE void MemRW(pscpu
     {
      timestamp += 36;
 
-     if(timestamp >= events[PSX_EVENT__SYNFIRST].next->event_time)
-      PSX_EventHandler(timestamp);
+     if(timestamp >= EventNextTS())
+      EventHandler(timestamp);
 
      V = SPU->Read(timestamp, A);
      V |= SPU->Read(timestamp, A | 2) << 16;
@@ -509,7 +1024,7 @@ template<typename T, bool IsWrite, bool Access24> static INLINE void MemRW(pscpu
     {
      //timestamp += 8;
 
-     //if(timestamp >= events[PSX_EVENT__SYNFIRST].next->event_time)
+     //if(timestamp >= EventNextTS())
      // PSX_EventHandler(timestamp);
 
      SPU->Write(timestamp, A & ~1, V);
@@ -518,8 +1033,8 @@ template<typename T, bool IsWrite, bool Access24> static INLINE void MemRW(pscpu
     {
      timestamp += 16; // Just a guess, need to test.
 
-     if(timestamp >= events[PSX_EVENT__SYNFIRST].next->event_time)
-      PSX_EventHandler(timestamp);
+     if(timestamp >= EventNextTS())
+      EventHandler(timestamp);
 
      V = SPU->Read(timestamp, A & ~1);
     }
@@ -550,9 +1065,9 @@ template<typename T, bool IsWrite, bool Access24> static INLINE void MemRW(pscpu
     timestamp++;
 
    if(IsWrite)
-    GPU_Write(timestamp, A, V);
+    GPU->Write(timestamp, A, V);
    else
-    V = GPU_Read(timestamp, A);
+    V = GPU->Read(timestamp, A);
 
    return;
   }
@@ -563,9 +1078,9 @@ template<typename T, bool IsWrite, bool Access24> static INLINE void MemRW(pscpu
     timestamp++;
 
    if(IsWrite)
-    MDEC_Write(timestamp, A, V);
+    MDEC->Write(timestamp, A, V);
    else
-    V = MDEC_Read(timestamp, A);
+    V = MDEC->Read(timestamp, A);
 
    return;
   }
@@ -622,9 +1137,9 @@ template<typename T, bool IsWrite, bool Access24> static INLINE void MemRW(pscpu
 #endif
 
    if(IsWrite)
-    SIO_Write(timestamp, A, V);
+    SIO->Write(timestamp, A, V);
    else
-    V = SIO_Read(timestamp, A);
+    V = SIO->Read(timestamp, A);
    return;
   }
 
@@ -650,9 +1165,9 @@ template<typename T, bool IsWrite, bool Access24> static INLINE void MemRW(pscpu
     timestamp++;
 
    if(IsWrite)
-    IRQ_Write(A, V);
+    IRQ->Write(A, V);
    else
-    V = IRQ_Read(A);
+    V = IRQ->Read(A);
    return;
   }
 
@@ -662,9 +1177,9 @@ template<typename T, bool IsWrite, bool Access24> static INLINE void MemRW(pscpu
     timestamp++;
 
    if(IsWrite)
-    DMA_Write(timestamp, A, V);
+    DMA->Write(timestamp, A, V);
    else
-    V = DMA_Read(timestamp, A);
+    V = DMA->Read(timestamp, A);
 
    return;
   }
@@ -675,9 +1190,9 @@ template<typename T, bool IsWrite, bool Access24> static INLINE void MemRW(pscpu
     timestamp++;
 
    if(IsWrite)
-    TIMER_Write(timestamp, A, V);
+    TIMER->Write(timestamp, A, V);
    else
-    V = TIMER_Read(timestamp, A);
+    V = TIMER->Read(timestamp, A);
 
    return;
   }
@@ -741,29 +1256,29 @@ template<typename T, bool IsWrite, bool Access24> static INLINE void MemRW(pscpu
 
 void MDFN_FASTCALL PSX_MemWrite8(pscpu_timestamp_t timestamp, uint32 A, uint32 V)
 {
- MemRW<uint8, true, false>(timestamp, A, V);
+ s_PSX->MemRW<uint8, true, false>(timestamp, A, V);
 }
 
 void MDFN_FASTCALL PSX_MemWrite16(pscpu_timestamp_t timestamp, uint32 A, uint32 V)
 {
- MemRW<uint16, true, false>(timestamp, A, V);
+ s_PSX->MemRW<uint16, true, false>(timestamp, A, V);
 }
 
 void MDFN_FASTCALL PSX_MemWrite24(pscpu_timestamp_t timestamp, uint32 A, uint32 V)
 {
- MemRW<uint32, true, true>(timestamp, A, V);
+ s_PSX->MemRW<uint32, true, true>(timestamp, A, V);
 }
 
 void MDFN_FASTCALL PSX_MemWrite32(pscpu_timestamp_t timestamp, uint32 A, uint32 V)
 {
- MemRW<uint32, true, false>(timestamp, A, V);
+ s_PSX->MemRW<uint32, true, false>(timestamp, A, V);
 }
 
 uint8 MDFN_FASTCALL PSX_MemRead8(pscpu_timestamp_t &timestamp, uint32 A)
 {
  uint32 V;
 
- MemRW<uint8, false, false>(timestamp, A, V);
+ s_PSX->MemRW<uint8, false, false>(timestamp, A, V);
 
  return(V);
 }
@@ -772,7 +1287,7 @@ uint16 MDFN_FASTCALL PSX_MemRead16(pscpu_timestamp_t &timestamp, uint32 A)
 {
  uint32 V;
 
- MemRW<uint16, false, false>(timestamp, A, V);
+ s_PSX->MemRW<uint16, false, false>(timestamp, A, V);
 
  return(V);
 }
@@ -781,7 +1296,7 @@ uint32 MDFN_FASTCALL PSX_MemRead24(pscpu_timestamp_t &timestamp, uint32 A)
 {
  uint32 V;
 
- MemRW<uint32, false, true>(timestamp, A, V);
+ s_PSX->MemRW<uint32, false, true>(timestamp, A, V);
 
  return(V);
 }
@@ -790,19 +1305,19 @@ uint32 MDFN_FASTCALL PSX_MemRead32(pscpu_timestamp_t &timestamp, uint32 A)
 {
  uint32 V;
 
- MemRW<uint32, false, false>(timestamp, A, V);
+ s_PSX->MemRW<uint32, false, false>(timestamp, A, V);
 
  return(V);
 }
 
-template<typename T, bool Access24> static INLINE uint32 MemPeek(pscpu_timestamp_t timestamp, uint32 A)
+template<typename T, bool Access24> INLINE uint32 PSX::MemPeek(pscpu_timestamp_t timestamp, uint32 A)
 {
  if(A < 0x00800000)
  {
   if(Access24)
-   return(MainRAM.ReadU24(A & 0x1FFFFF));
+   return(MainRAM->ReadU24(A & 0x1FFFFF));
   else
-   return(MainRAM.Read<T>(A & 0x1FFFFF));
+   return(MainRAM->Read<T>(A & 0x1FFFFF));
  }
 
  if(A >= 0x1FC00000 && A <= 0x1FC7FFFF)
@@ -914,27 +1429,27 @@ template<typename T, bool Access24> static INLINE uint32 MemPeek(pscpu_timestamp
 
 uint8 PSX_MemPeek8(uint32 A)
 {
- return MemPeek<uint8, false>(0, A);
+ return s_PSX->MemPeek<uint8, false>(0, A);
 }
 
 uint16 PSX_MemPeek16(uint32 A)
 {
- return MemPeek<uint16, false>(0, A);
+ return s_PSX->MemPeek<uint16, false>(0, A);
 }
 
 uint32 PSX_MemPeek32(uint32 A)
 {
- return MemPeek<uint32, false>(0, A);
+ return s_PSX->MemPeek<uint32, false>(0, A);
 }
 
-template<typename T, bool Access24> static INLINE void MemPoke(pscpu_timestamp_t timestamp, uint32 A, T V)
+template<typename T, bool Access24> INLINE void PSX::MemPoke(pscpu_timestamp_t timestamp, uint32 A, T V)
 {
  if(A < 0x00800000)
  {
   if(Access24)
-   MainRAM.WriteU24(A & 0x1FFFFF, V);
+   MainRAM->WriteU24(A & 0x1FFFFF, V);
   else
-   MainRAM.Write<T>(A & 0x1FFFFF, V);
+   MainRAM->Write<T>(A & 0x1FFFFF, V);
 
   return;
  }
@@ -954,393 +1469,139 @@ template<typename T, bool Access24> static INLINE void MemPoke(pscpu_timestamp_t
   if(A >= 0x1F801000 && A <= 0x1F801023)
   {
    unsigned index = (A & 0x1F) >> 2;
-   SysControl.Regs[index] = (V << ((A & 3) * 8)) & SysControl_Mask[index];
-   return;
-  }
- }
-
- if(A == 0xFFFE0130)
- {
-  CPU->SetBIU(V);
-  return;
- }
-}
-
-void PSX_MemPoke8(uint32 A, uint8 V)
-{
- MemPoke<uint8, false>(0, A, V);
-}
-
-void PSX_MemPoke16(uint32 A, uint16 V)
-{
- MemPoke<uint16, false>(0, A, V);
-}
-
-void PSX_MemPoke32(uint32 A, uint32 V)
-{
- MemPoke<uint32, false>(0, A, V);
-}
-
-static void PSX_Power(bool powering_up)
-{
- PSX_PRNG.ResetState();	// Should occur first!
-
- memset(MainRAM.data8, 0, 2048 * 1024);
-
- for(unsigned i = 0; i < 9; i++)
-  SysControl.Regs[i] = 0;
-
- CPU->Power();
-
- EventReset();
-
- TIMER_Power();
-
- DMA_Power();
-
- FIO->Reset(powering_up);
- SIO_Power();
-
- MDEC_Power();
- CDC->Power();
- GPU_Power();
- //SPU->Power();	// Called from CDC->Power()
- IRQ_Power();
-
- ForceEventUpdates(0);
-
- deint.ClearState();
-}
-
-
-void PSX_GPULineHook(const pscpu_timestamp_t timestamp, const pscpu_timestamp_t line_timestamp, bool vsync, uint32 *pixels, const MDFN_PixelFormat* const format, const unsigned width, const unsigned pix_clock_offset, const unsigned pix_clock, const unsigned pix_clock_divider)
-{
- FIO->GPULineHook(timestamp, line_timestamp, vsync, pixels, format, width, pix_clock_offset, pix_clock, pix_clock_divider);
-}
-
-}
-
-using namespace MDFN_IEN_PSX;
-
-struct ShockConfig
-{
-	//// multires is a hint that, if set, indicates that the system has fairly programmable video modes(particularly, the ability
-	//// to display multiple horizontal resolutions, such as the PCE, PC-FX, or Genesis).  In practice, it will cause the driver
-	//// code to set the linear interpolation on by default. (TRUE for psx)
-	//// lcm_width and lcm_height are the least common multiples of all possible
-	//// resolutions in the frame buffer as specified by DisplayRect/LineWidths(Ex for PCE: widths of 256, 341.333333, 512,
-	//// lcm = 1024)
-	//// nominal_width and nominal_height specify the resolution that Mednafen should display
-	//// the framebuffer image in at 1x scaling, scaled from the dimensions of DisplayRect, and optionally the LineWidths array
-	//// passed through espec to the Emulate() function.
-	//int lcm_width;
-	//int lcm_height;
-	//int nominal_width;
-	//int nominal_height;
-	int fb_width;		// Width of the framebuffer(not necessarily width of the image).  MDFN_Surface width should be >= this.
-	int fb_height;		// Height of the framebuffer passed to the Emulate() function(not necessarily height of the image)
-
-	//last used render options
-	ShockRenderOptions opts;
-} s_ShockConfig;
-
-
-struct ShockState
-{
-	bool power;
-	bool eject;
-} s_ShockState;
-
-
-struct ShockPeripheral
-{
-	ePeripheralType type = ePeripheralType_None;
-	u8 buffer[32]; //must be larger than 16+3+1 or thereabouts because the dualshock writes some rumble data into it. bleck, ill fix it later
-	//TODO: test for multitap. does it need to be as large as 4 of whatever the single largest port would be?
-	//well, it must manage its own stuff.. its not like we feed in external data, right?
-	InputDevice* device = nullptr;
-
-	~ShockPeripheral()
-	{
-		//do not do this! FIO takes care of finishing this off
-		//I know, it's all a mess
-		//delete device;
-	}
-};
-
-static int addressToPortNum(int address)
-{
-	int portnum = SHOCK_INVALID_ADDRESS;
-	//WHY did I choose 1 indexed? I dunno, let's roll with it
-	if (address == 0x01) portnum = 0;
-	else if (address == 0x02) portnum = 1;
-	else if (address == 0x11) portnum = 2;
-	else if (address == 0x21) portnum = 3;
-	else if (address == 0x31) portnum = 4;
-	else if (address == 0x41) portnum = 5;
-	else if (address == 0x12) portnum = 6;
-	else if (address == 0x22) portnum = 7;
-	else if (address == 0x32) portnum = 8;
-	else if (address == 0x42) portnum = 9;
-	return portnum;
-}
-
-struct {
-
-	//"This is kind of redundant with the frontIO code, and should be merged with it eventually, when the configurability gets more advanced"
-	//I dunno.
-
-	std::array<ShockPeripheral,10> ports;
-
-	void Initialize()
-	{
-		reconstruct(&ports);
-		for(int i=0;i<10;i++)
-			memset(ports[i].buffer,0,sizeof(ports[i].buffer));
-		reconstruct(FIO);
-	}
-
-	//TODO: "Take care to call ->Power() only if the device actually changed."
-	//(like, is this about savestates? seems silly"
-	s32 Connect(s32 address, s32 type)
-	{
-		int portnum = addressToPortNum(address);
-		if(portnum == SHOCK_INVALID_ADDRESS) return SHOCK_INVALID_ADDRESS;
-
-		//check whats already there
-		if(ports[portnum].type == ePeripheralType_None && type == ePeripheralType_None) return SHOCK_OK; //NOP
-		if(ports[portnum].type != ePeripheralType_None && type != ePeripheralType_None) return SHOCK_NOCANDO; //cant re-connect something without disconnecting first
-
-		//disconnecting:
-		if(type == ePeripheralType_None) {
-			ports[portnum].type = ePeripheralType_None;
-			memset(ports[portnum].buffer,0,sizeof(ports[portnum].buffer));
-			
-			//fall through to setup a nonexistent `next` for disconnecting, instead of returning now
-		}
-
-		//connecting:
-		InputDevice* next = nullptr;
-		switch(type)
-		{
-		case ePeripheralType_Pad: next = Device_Gamepad_Create(); break;
-		case ePeripheralType_DualShock: next = Device_DualShock_Create(); break;
-		case ePeripheralType_DualAnalog: next = Device_DualAnalog_Create(false); break;
-		case ePeripheralType_Multitap: next = new InputDevice_Multitap(); break;
-		case ePeripheralType_NegCon: next = Device_neGcon_Create(); break;
-		case ePeripheralType_None: next = new InputDevice(); break; //dummy
-			break;
-		default:
-			return SHOCK_ERROR;
-		}
-		ports[portnum].type = (ePeripheralType)type;
-		if(ports[portnum].device) delete ports[portnum].device;
-		ports[portnum].device = next;
-		memset(ports[portnum].buffer,0,sizeof(ports[portnum].buffer));
+   SysControl.Regs[index] = (V << ((A & 3) * 8)) & SysControl_Mask[index];
+   return;
+  }
+ }
 
-		if (portnum == 0 || portnum == 1)
-		{
-			FIO->Ports[portnum] = next;
-			FIO->PortData[portnum] = ports[portnum].buffer;
-		}
-		else {
-			//must be multitap child device
-			int portidx = (address & 0xF) - 1;
-			int subidx = (address >> 4) - 1;
-			auto tap = (InputDevice_Multitap*)FIO->Ports[portidx];
-			auto mcdummy = new InputDevice();
-			//next->
-			tap->SetSubDevice(subidx, next, mcdummy);
-		}
+ if(A == 0xFFFE0130)
+ {
+  CPU->SetBIU(V);
+  return;
+ }
+}
 
-		return SHOCK_OK;
-	}
+void PSX_MemPoke8(uint32 A, uint8 V)
+{
+ s_PSX->MemPoke<uint8, false>(0, A, V);
+}
 
-	s32 PollActive(s32 address, bool clear)
-	{
-		int portnum = addressToPortNum(address);
-		if (portnum == SHOCK_INVALID_ADDRESS) return SHOCK_INVALID_ADDRESS;
+void PSX_MemPoke16(uint32 A, uint16 V)
+{
+ s_PSX->MemPoke<uint16, false>(0, A, V);
+}
 
-		s32 ret = SHOCK_FALSE;
+void PSX_MemPoke32(uint32 A, uint32 V)
+{
+ s_PSX->MemPoke<uint32, false>(0, A, V);
+}
 
-		u8* buf = ports[portnum].buffer;
-		switch(ports[portnum].type)
-		{
-		case ePeripheralType_DualShock:
-			{
-				IO_Dualshock* io_dualshock = (IO_Dualshock*)buf;
-				if(io_dualshock->active) ret = SHOCK_TRUE;
-				if(clear) io_dualshock->active = 0;
-				return ret;
-				break;
-			}
-		case ePeripheralType_DualAnalog:
-			{
-				IO_DualAnalog* io_dualanalog = (IO_DualAnalog*)buf;
-				if(io_dualanalog->active) ret = SHOCK_TRUE;
-				if(clear) io_dualanalog->active = 0;
-				return ret;
-				break;
-			}
-		case ePeripheralType_Pad:
-			{
-				IO_Gamepad* io_gamepad = (IO_Gamepad*)buf;
-				if(io_gamepad->active) ret = SHOCK_TRUE;
-				if(clear) io_gamepad->active = 0;
-				return ret;
-				break;
-			}
-		case ePeripheralType_NegCon:
-		{
-			IO_NegCon* io_negcon = (IO_NegCon*)buf;
-			if (io_negcon->active) ret = SHOCK_TRUE;
-			if (clear) io_negcon->active = 0;
-			return ret;
-			break;
-		}
+void PSX::Power(bool powering_up)
+{
+ PSX_PRNG.ResetState();	// Should occur first!
 
-		case ePeripheralType_None:
-			return SHOCK_NOCANDO;
+ memset(MainRAM->data8, 0, 2048 * 1024);
 
-		default:
-			return SHOCK_ERROR;
-		}
-	}
+ for(unsigned i = 0; i < 9; i++)
+  SysControl.Regs[i] = 0;
 
-	s32 SetPadInput(s32 address, u32 buttons, u8 left_x, u8 left_y, u8 right_x, u8 right_y)
-	{
-		int portnum = addressToPortNum(address);
-		if (portnum == SHOCK_INVALID_ADDRESS) return SHOCK_INVALID_ADDRESS;
+ CPU->Power();
 
-		u8* buf = ports[portnum].buffer;
-		switch(ports[portnum].type)
-		{
-		case ePeripheralType_DualShock:
-			{
-				IO_Dualshock* io_dualshock = (IO_Dualshock*)buf;
-				io_dualshock->buttons[0] = (buttons>>0)&0xFF;
-				io_dualshock->buttons[1] = (buttons>>8)&0xFF;
-				io_dualshock->buttons[2] = (buttons>>16)&0xFF; //this is only the analog mode button
-				io_dualshock->right_x = right_x;
-				io_dualshock->right_y = right_y;
-				io_dualshock->left_x = left_x;
-				io_dualshock->left_y = left_y;
-				return SHOCK_OK;
-			}
-		case ePeripheralType_Pad:
-			{
-				IO_Gamepad* io_gamepad = (IO_Gamepad*)buf;
-				io_gamepad->buttons[0] = (buttons>>0)&0xFF;
-				io_gamepad->buttons[1] = (buttons>>8)&0xFF;
-				return SHOCK_OK;
-			}
-		case ePeripheralType_DualAnalog:
-			{
-				IO_DualAnalog* io_dualanalog = (IO_DualAnalog*)buf;
-				io_dualanalog->buttons[0] = (buttons>>0)&0xFF;
-				io_dualanalog->buttons[1] = (buttons>>8)&0xFF;
-				io_dualanalog->right_x = right_x;
-				io_dualanalog->right_y = right_y;
-				io_dualanalog->left_x = left_x;
-				io_dualanalog->left_y = left_y;
-				return SHOCK_OK;
-			}
-		case ePeripheralType_NegCon:
-			{
-				IO_NegCon* io_negcon = (IO_NegCon*)buf;
-				io_negcon->buttons[0] = (buttons >> 0) & 0xFF;
-				io_negcon->buttons[1] = (buttons >> 8) & 0xFF;
-				io_negcon->twist = left_x;
-				io_negcon->anabuttons[0] = left_y;
-				io_negcon->anabuttons[1] = right_x;
-				io_negcon->anabuttons[2] = right_y;
-				return SHOCK_OK;
-			}
-		
-		default:
-			return SHOCK_ERROR;
-		}
-	}
+ EventReset();
 
-	s32 MemcardTransact(s32 address, ShockMemcardTransaction* transaction)
-	{
-		int portnum = addressToPortNum(address);
-		if (portnum == SHOCK_INVALID_ADDRESS) return SHOCK_INVALID_ADDRESS;
+ TIMER->Power();
 
-		//TODO - once we get flexible here, do some extra condition checks.. whether memcards exist, etc. much like devices.
-		switch(transaction->transaction)
-		{
-			case eShockMemcardTransaction_Connect: 
-				//cant connect when a memcard is already connected
-				if(!strcmp(FIO->MCPorts[portnum]->GetName(),"InputDevice_Memcard"))
-					return SHOCK_NOCANDO;
-				delete FIO->MCPorts[portnum]; //delete dummy
-				FIO->MCPorts[portnum] = Device_Memcard_Create();
-			
-			case eShockMemcardTransaction_Disconnect: 
-				return SHOCK_ERROR; //not supported yet
+ DMA->Power();
 
-			case eShockMemcardTransaction_Write:
-				FIO->MCPorts[portnum]->WriteNV((uint8*)transaction->buffer128k,0,128*1024);
-				FIO->MCPorts[portnum]->ResetNVDirtyCount();
-				return SHOCK_OK;
+ FIO->Reset(powering_up);
+ SIO->Power();
 
-			case eShockMemcardTransaction_Read:
-			{
-				const u8* ptr = FIO->MCPorts[portnum]->ReadNV();
-				memcpy(transaction->buffer128k,ptr,128*1024);
-				FIO->MCPorts[portnum]->ResetNVDirtyCount();
-				return SHOCK_OK;
-			}
+ MDEC->Power();
+ CDC->Power();
+ GPU->Power();
+ //SPU->Power();	// Called from CDC->Power()
+ IRQ->Power();
 
-			case eShockMemcardTransaction_CheckDirty:
-				if(FIO->GetMemcardDirtyCount(portnum))
-					return SHOCK_TRUE;
-				else return SHOCK_FALSE;
+ ForceEventUpdates(0);
 
-			default:
-				return SHOCK_ERROR;
-		}
-	}
+ deint.ClearState();
+}
 
-	void UpdateInput()
-	{
-		for(int i=0;i<ports.size();i++)
-		{
-			if(ports[i].device)
-				ports[i].device->UpdateInput(ports[i].buffer);
-		}
-	}
 
-} s_ShockPeripheralState;
+void PSX_GPULineHook(const pscpu_timestamp_t timestamp, const pscpu_timestamp_t line_timestamp, bool vsync, uint32 *pixels, const MDFN_PixelFormat* const format, const unsigned width, const unsigned pix_clock_offset, const unsigned pix_clock, const unsigned pix_clock_divider)
+{
+ FIO->GPULineHook(timestamp, line_timestamp, vsync, pixels, format, width, pix_clock_offset, pix_clock, pix_clock_divider);
+}
+
+}
 
-EW_EXPORT s32 shock_Peripheral_Connect(void* psx, s32 address, s32 type)
+using namespace MDFN_IEN_PSX;
+
+s32 PSX::Peripheral_Connect(s32 address, s32 type)
 {
+	s_StateSize = -1;
 	return s_ShockPeripheralState.Connect(address, type);
 }
 
-EW_EXPORT s32 shock_Peripheral_SetPadInput(void* psx, s32 address, u32 buttons, u8 left_x, u8 left_y, u8 right_x, u8 right_y)
+EW_EXPORT s32 shock_Peripheral_Connect(void* psx, s32 address, s32 type)
+{
+	if(!psx)
+		return SHOCK_NOCANDO;
+
+	PSXBinding bind(psx);
+	return bind->Peripheral_Connect(address, type);
+}
+
+s32 PSX::Peripheral_SetPadInput(s32 address, u32 buttons, u8 left_x, u8 left_y, u8 right_x, u8 right_y)
 {
 	return s_ShockPeripheralState.SetPadInput(address, buttons, left_x, left_y, right_x, right_y);
 }
 
-EW_EXPORT s32 shock_Peripheral_PollActive(void* psx, s32 address, s32 clear)
+EW_EXPORT s32 shock_Peripheral_SetPadInput(void* psx, s32 address, u32 buttons, u8 left_x, u8 left_y, u8 right_x, u8 right_y)
+{
+	if(!psx)
+		return SHOCK_NOCANDO;
+
+	PSXBinding bind(psx);
+	return bind->Peripheral_SetPadInput(address, buttons, left_x, left_y, right_x, right_y);
+}
+
+s32 PSX::Peripheral_PollActive(s32 address, s32 clear)
 {
 	return s_ShockPeripheralState.PollActive(address, clear!=SHOCK_FALSE);
 }
 
-EW_EXPORT s32 shock_Peripheral_MemcardTransact(void* psx, s32 address, ShockMemcardTransaction* transaction)
+EW_EXPORT s32 shock_Peripheral_PollActive(void* psx, s32 address, s32 clear)
+{
+	if(!psx)
+		return SHOCK_NOCANDO;
+
+	PSXBinding bind(psx);
+	return bind->Peripheral_PollActive(address, clear);
+}
+
+s32 PSX::Peripheral_MemcardTransact(s32 address, ShockMemcardTransaction* transaction)
 {
+	s_StateSize = -1;
 	return s_ShockPeripheralState.MemcardTransact(address, transaction);
 }
 
-static void MountCPUAddressSpace()
+EW_EXPORT s32 shock_Peripheral_MemcardTransact(void* psx, s32 address, ShockMemcardTransaction* transaction)
+{
+	if(!psx)
+		return SHOCK_NOCANDO;
+
+	PSXBinding bind(psx);
+	return bind->Peripheral_MemcardTransact(address, transaction);
+}
+
+void PSX::MountCPUAddressSpace()
 {
 	for(uint32 ma = 0x00000000; ma < 0x00800000; ma += 2048 * 1024)
 	{
-		CPU->SetFastMap(MainRAM.data8, 0x00000000 + ma, 2048 * 1024);
-		CPU->SetFastMap(MainRAM.data8, 0x80000000 + ma, 2048 * 1024);
-		CPU->SetFastMap(MainRAM.data8, 0xA0000000 + ma, 2048 * 1024);
+		CPU->SetFastMap(MainRAM->data8, 0x00000000 + ma, 2048 * 1024);
+		CPU->SetFastMap(MainRAM->data8, 0x80000000 + ma, 2048 * 1024);
+		CPU->SetFastMap(MainRAM->data8, 0xA0000000 + ma, 2048 * 1024);
 	}
 
 	CPU->SetFastMap(BIOSROM->data8, 0x1FC00000, 512 * 1024);
@@ -1355,14 +1616,7 @@ static void MountCPUAddressSpace()
 	}
 }
 
-static MDFN_Surface *VTBuffer[2] = { NULL, NULL };
-static int *VTLineWidths[2] = { NULL, NULL };
-static bool s_FramebufferNormalized;
-static bool s_Created;
-static int s_FramebufferCurrent;
-static int s_FramebufferCurrentWidth;
-
-EW_EXPORT s32 shock_Create(void** psx, s32 region, void* firmware512k)
+s32 PSX::Create(s32 region, void* firmware512k)
 {
 	#ifdef SHOCK_RUN_TESTS
 	static bool ranTests = false;
@@ -1377,10 +1631,7 @@ EW_EXPORT s32 shock_Create(void** psx, s32 region, void* firmware512k)
  //psx_dbg_level = MDFN_GetSettingUI("psx.dbg_level");
  //DBG_Init();
 	
-	//yeah, we only support a static instance.
-	//we'll flag whether it's created though
-	*psx = NULL;
-	s_Created = true;
+	s_StateSize = -1;
 
 	//PIO Mem: why wouldn't we want this?
 	static const bool WantPIOMem = true;
@@ -1391,11 +1642,18 @@ EW_EXPORT s32 shock_Create(void** psx, s32 region, void* firmware512k)
 	if(WantPIOMem) PIOMem = new MultiAccessSizeMem<65536, false>();
 	else PIOMem = NULL;
 
+	MainRAM = new MultiAccessSizeMem<2048 * 1024, false>();
+	soundbuf = new int16[1024 * 1024];
+
 	CPU = new PS_CPU();
 	SPU = new PS_SPU();
-	GPU_Init(region == REGION_EU);
+	GPU = new PS_GPU(region == REGION_EU);
 	CDC = new PS_CDC();
-	DMA_Init();
+	IRQ = new PS_IRQ();
+	DMA = new PS_DMA();
+	TIMER = new PS_TIMER();
+	SIO = new PS_SIO();
+	MDEC = new PS_MDEC();
 
 
 	//setup gpu output surfaces
@@ -1411,11 +1669,12 @@ EW_EXPORT s32 shock_Create(void** psx, s32 region, void* firmware512k)
 		const uint8 a = rc;
 		const uint8 b = rc >> 8;
 
-		(GPU.OutputLUT +   0)[a] = ((a & 0x1F) << (3 + nf.Rshift)) | ((a >> 5) << (3 + nf.Gshift));
-		(GPU.OutputLUT + 256)[b] = ((b & 0x3) << (6 + nf.Gshift)) | (((b >> 2) & 0x1F) << (3 + nf.Bshift));
+		(GPU->OutputLUT +   0)[a] = ((a & 0x1F) << (3 + nf.Rshift)) | ((a >> 5) << (3 + nf.Gshift));
+		(GPU->OutputLUT + 256)[b] = ((b & 0x3) << (6 + nf.Gshift)) | (((b >> 2) & 0x1F) << (3 + nf.Bshift));
 	}
 
 	FIO = new FrontIO();
+	Bind(this); //the devices exist now; the peripheral setup goes through FIO
 	s_ShockPeripheralState.Initialize();
 
 	MountCPUAddressSpace();
@@ -1428,13 +1687,17 @@ EW_EXPORT s32 shock_Create(void** psx, s32 region, void* firmware512k)
 	return SHOCK_OK;
 }
 
-EW_EXPORT s32 shock_Destroy(void* psx)
+EW_EXPORT s32 shock_Create(void** psx, s32 region, void* firmware512k)
 {
-	if(!s_Created)
-		return SHOCK_NOCANDO;
+	PSX* ctx = new PSX();
+	PSXBinding bind(ctx);
 
-	s_Created = false;
+	*psx = ctx;
+	return ctx->Create(region, firmware512k);
+}
 
+PSX::~PSX()
+{
 	for(int i=0;i<2;i++)
 	{
 		delete VTBuffer[i];
@@ -1458,7 +1721,11 @@ EW_EXPORT s32 shock_Destroy(void* psx)
 		SPU = NULL;
 	}
 
-	GPU_Kill();
+	if(GPU)
+	{
+		delete GPU;
+		GPU = NULL;
+	}
 
 	if(CPU)
 	{
@@ -1472,7 +1739,11 @@ EW_EXPORT s32 shock_Destroy(void* psx)
 		FIO = NULL;
 	}
 
-	DMA_Kill();
+	delete IRQ;
+	delete DMA;
+	delete TIMER;
+	delete SIO;
+	delete MDEC;
 
 	if(BIOSROM)
 	{
@@ -1486,34 +1757,63 @@ EW_EXPORT s32 shock_Destroy(void* psx)
 		PIOMem = NULL;
 	}
 
-	cdifs = NULL;
+	delete MainRAM;
+	MainRAM = NULL;
+
+	delete[] soundbuf;
+	soundbuf = NULL;
+}
+
+EW_EXPORT s32 shock_Destroy(void* psx)
+{
+	if(!psx)
+		return SHOCK_NOCANDO;
+
+	PSXBinding bind(psx);
+	delete (PSX*)psx;
+	return SHOCK_OK;
+}
+
+s32 PSX::PowerOn()
+{
+	if(s_ShockState.power) return SHOCK_NOCANDO;
+
+	s_ShockState.power = true;
+	Power(true);
 
 	return SHOCK_OK;
 }
 
-//Sets the power to ON. It is an error to turn an already-on console ON again
-EW_EXPORT s32 shock_PowerOn(void* psx)
+//Sets the power to ON. It is an error to turn an already-on console ON again
+EW_EXPORT s32 shock_PowerOn(void* psx)
+{
+	if(!psx)
+		return SHOCK_NOCANDO;
+
+	PSXBinding bind(psx);
+	return bind->PowerOn();
+}
+
+s32 PSX::SoftReset()
 {
-	if(s_ShockState.power) return SHOCK_NOCANDO;
+	if (!s_ShockState.power) return SHOCK_NOCANDO;
 
-	s_ShockState.power = true;
-	PSX_Power(true);
+	Power(false);
 
 	return SHOCK_OK;
 }
 
 //Triggers a soft reset immediately. Returns SHOCK_NOCANDO if console is powered off.
-EW_EXPORT s32 shock_SoftReset(void *psx)
+EW_EXPORT s32 shock_SoftReset(void* psx)
 {
-	if (!s_ShockState.power) return SHOCK_NOCANDO;
-
-	PSX_Power(false);
+	if(!psx)
+		return SHOCK_NOCANDO;
 
-	return SHOCK_OK;
+	PSXBinding bind(psx);
+	return bind->SoftReset();
 }
 
-//Sets the power to OFF. It is an error to turn an already-off console OFF again
-EW_EXPORT s32 shock_PowerOff(void* psx)
+s32 PSX::PowerOff()
 {
 	if(!s_ShockState.power) return SHOCK_NOCANDO;
 
@@ -1521,9 +1821,20 @@ EW_EXPORT s32 shock_PowerOff(void* psx)
 	return SHOCK_ERROR;
 }
 
-EW_EXPORT s32 shock_Step(void* psx, eShockStep step)
+//Sets the power to OFF. It is an error to turn an already-off console OFF again
+EW_EXPORT s32 shock_PowerOff(void* psx)
+{
+	if(!psx)
+		return SHOCK_NOCANDO;
+
+	PSXBinding bind(psx);
+	return bind->PowerOff();
+}
+
+s32 PSX::Step(eShockStep step)
 {
 	//only eShockStep_Frame is supported
+	const bool skipAudio = (step & eShockStep_SkipAudio) != 0;
 
 	pscpu_timestamp_t timestamp = 0;
 
@@ -1553,34 +1864,48 @@ EW_EXPORT s32 shock_Step(void* psx, eShockStep step)
 		deint.SetType(Deinterlacer::DEINT_BOB);
 	if (s_ShockConfig.opts.deinterlaceMode == eShockDeinterlaceMode_BobOffset)
 		deint.SetType(Deinterlacer::DEINT_BOB_OFFSET);
+	if (s_ShockConfig.opts.deinterlaceMode == eShockDeinterlaceMode_Blend)
+		deint.SetType(Deinterlacer::DEINT_BLEND);
 
 	//-------------------------
 
 	s_ShockPeripheralState.UpdateInput();
 	
 	//GPU->StartFrame(psf_loader ? NULL : espec); //a reminder that when we do psf, we will be telling the gpu not to draw
-	GPU_StartFrame(&espec);
+	GPU->StartFrame(&espec);
 	
 	//not that it matters, but we may need to control this at some point
 	static const int ResampleQuality = 5;
-	SPU->StartFrame(espec.SoundRate, ResampleQuality); 
+	SPU->StartFrame(espec.SoundRate, ResampleQuality, skipAudio);
 
 	GpuFrameForLag = false;
 
+#ifdef WANT_PSX_PROFILE
+	if(!ProfileCalibTicks)
+	{
+		ProfileCalibTicks = ProfileTicks();
+		ProfileCalibTime = std::chrono::steady_clock::now();
+	}
+	ProfileLast = ProfileTicks(); //the frontend's time between steps isn't charged to anything
+#endif
+
 	Running = -1;
 	timestamp = CPU->Run(timestamp, psx_dbg_level >= PSX_DBG_BIOS_PRINT, /*psf_loader != NULL*/ false); //huh?
 	assert(timestamp);
 
+	CPU->FlushBinaryTrace();
+
 	ForceEventUpdates(timestamp);
-	if(GPU_GetScanlineNum() < 100)
-		printf("[BUUUUUUUG] Frame timing end glitch; scanline=%u, st=%u\n", GPU_GetScanlineNum(), timestamp);
+	GPU->SyncRAM(); //so the frontend sees all of this frame's drawing in GPURAM
+	if(GPU->GetScanlineNum() < 100)
+		printf("[BUUUUUUUG] Frame timing end glitch; scanline=%u, st=%u\n", GPU->GetScanlineNum(), timestamp);
 
 	espec.SoundBufSize = SPU->EndFrame(espec.SoundBuf);
 
 	CDC->ResetTS();
-	TIMER_ResetTS();
-	DMA_ResetTS();
-	GPU_ResetTS();
+	TIMER->ResetTS();
+	DMA->ResetTS();
+	GPU->ResetTS();
 	FIO->ResetTS();
 
 	RebaseTS(timestamp);
@@ -1616,16 +1941,24 @@ EW_EXPORT s32 shock_Step(void* psx, eShockStep step)
 	fflush(stdout);
 	fflush(stderr);
 
+#ifdef WANT_PSX_PROFILE
+	ProfileSwitch(PSX_PROF_CPU);
+#endif
+
 
 	return SHOCK_OK;
 }
 
-struct FramebufferCropInfo
+EW_EXPORT s32 shock_Step(void* psx, eShockStep step)
 {
-	int width, height, xo, yo;
-};
+	if(!psx)
+		return SHOCK_NOCANDO;
+
+	PSXBinding bind(psx);
+	return bind->Step(step);
+}
 
-static void _shock_AnalyzeFramebufferCropInfo(int fbIndex, FramebufferCropInfo* info)
+void PSX::_shock_AnalyzeFramebufferCropInfo(int fbIndex, FramebufferCropInfo* info)
 {
 	//presently, except for contrived test programs, it is safe to assume this is the same for the entire frame (no known use by games)
 	//however, due to the dump_framebuffer, it may be incorrect at scanline 0. so lets use another one for the heuristic here
@@ -1642,8 +1975,8 @@ static void _shock_AnalyzeFramebufferCropInfo(int fbIndex, FramebufferCropInfo*
 	{
 		//printf("%d %d %d %d | %d | %d\n",yo,height, GPU->GetVertStart(), GPU->GetVertEnd(), espec.DisplayRect.y, GPU->FirstLine);
 
-		height = GPU.GetVertEnd() - GPU.GetVertStart();
-		yo = GPU.FirstLine;
+		height = GPU->GetVertEnd() - GPU->GetVertStart();
+		yo = GPU->FirstLine;
 
 		if (espec.DisplayRect.h == 288 || espec.DisplayRect.h == 240)
 		{
@@ -1672,7 +2005,7 @@ static void _shock_AnalyzeFramebufferCropInfo(int fbIndex, FramebufferCropInfo*
 
 
 //`normalizes` the framebuffer to 700x480 (or 800x576 for PAL) by pixel doubling and wrecking the AR a little bit as needed
-void NormalizeFramebuffer()
+void PSX::NormalizeFramebuffer()
 {
 	//mednafen's advised solution for smooth gaming: "scale the output width to z * nominal_width, and the output height to z * nominal_height, where nominal_width and nominal_height are members of the MDFNGI struct"
 	//IOW, mednafen's strategy is to put everything in a 320x240 and scale it up 3x to 960x720 by default (which is adequate to contain the largest PSX framebuffer of 700x480)
@@ -1707,7 +2040,7 @@ void NormalizeFramebuffer()
 
 	int virtual_width = 800;
 	int virtual_height = 480;
-	if (GPU.HardwarePALType)
+	if (GPU->HardwarePALType)
 		virtual_height = 576;
 
 	if (s_ShockConfig.opts.renderType == eShockRenderType_ClipOverscan)
@@ -1847,7 +2180,7 @@ void NormalizeFramebuffer()
 	s_FramebufferCurrent = curr;
 }
 
-EW_EXPORT s32 shock_GetSamples(void* psx, void* buffer)
+s32 PSX::GetSamples(void* buffer)
 {
 	//if buffer is NULL, user just wants to know how many samples, so dont do any copying
 	if(buffer != NULL)
@@ -1858,14 +2191,24 @@ EW_EXPORT s32 shock_GetSamples(void* psx, void* buffer)
 	return espec.SoundBufSize;
 }
 
+EW_EXPORT s32 shock_GetSamples(void* psx, void* buffer)
+{
+	if(!psx)
+		return SHOCK_NOCANDO;
+
+	PSXBinding bind(psx);
+	return bind->GetSamples(buffer);
+}
 
-EW_EXPORT s32 shock_GetFramebuffer(void* psx, ShockFramebufferInfo* fb)
+
+//prepares the current framebuffer according to the eShockFramebufferFlags and describes its visible region
+void PSX::PrepareFramebuffer(s32 flags, ShockFramebufferView* view)
 {
 	//TODO - fastpath for emitting to the final framebuffer, although if we did that, we'd have to regenerate it every time
 	//TODO - let the frontend do this, anyway. need a new filter for it. this was in the plans from the beginning, i just havent done it yet
 
 	//if user requires normalization, do it now
-	if(fb->flags & eShockFramebufferFlags_Normalize)
+	if(flags & eShockFramebufferFlags_Normalize)
 		if(!s_FramebufferNormalized)
 		{
 			NormalizeFramebuffer();
@@ -1882,14 +2225,28 @@ EW_EXPORT s32 shock_GetFramebuffer(void* psx, ShockFramebufferInfo* fb)
 	int yo = cropInfo.yo;
 
 	//sloppy, but the above AnalyzeFramebufferCropInfo() will give us too short of a buffer
-	if(fb->flags & eShockFramebufferFlags_Normalize)
+	if(flags & eShockFramebufferFlags_Normalize)
 	{
 		height = espec.DisplayRect.h;
 		yo = 0;
 	}
 
-	fb->width = width;
-	fb->height = height;
+	view->flags = flags;
+	view->width = width;
+	view->height = height;
+	view->x = espec.DisplayRect.x;
+	view->y = yo;
+	view->pitch = s_FramebufferCurrentWidth;
+	view->pixels = VTBuffer[fbIndex]->pixels;
+}
+
+s32 PSX::GetFramebuffer(ShockFramebufferInfo* fb)
+{
+	ShockFramebufferView view;
+	PrepareFramebuffer(fb->flags, &view);
+
+	fb->width = view.width;
+	fb->height = view.height;
 		
 	//is that all we needed?
 	if(fb->ptr == NULL)
@@ -1899,20 +2256,44 @@ EW_EXPORT s32 shock_GetFramebuffer(void* psx, ShockFramebufferInfo* fb)
 
 	//maybe we need to output the framebuffer
 	//do a raster loop and copy it to the target
-	uint32* src = VTBuffer[fbIndex]->pixels + (s_FramebufferCurrentWidth*yo) + espec.DisplayRect.x;
+	const uint32* src = view.pixels + (view.pitch*view.y) + view.x;
 	uint32* dst = (u32*)fb->ptr;
-	int tocopy = width*4;
-	for(int y=0;y<height;y++)
+	int tocopy = view.width*4;
+	for(int y=0;y<view.height;y++)
 	{
 		memcpy(dst,src,tocopy);
-		src += s_FramebufferCurrentWidth;
-		dst += width;
+		src += view.pitch;
+		dst += view.width;
 	}
 
 	return SHOCK_OK;
 }
 
-static MDFN_COLD void LoadEXE(const uint8 *data, const uint32 size, bool ignore_pcsp = false)
+EW_EXPORT s32 shock_GetFramebuffer(void* psx, ShockFramebufferInfo* fb)
+{
+	if(!psx)
+		return SHOCK_NOCANDO;
+
+	PSXBinding bind(psx);
+	return bind->GetFramebuffer(fb);
+}
+
+s32 PSX::GetFramebufferView(ShockFramebufferView* fb)
+{
+	PrepareFramebuffer(fb->flags, fb);
+	return SHOCK_OK;
+}
+
+EW_EXPORT s32 shock_GetFramebufferView(void* psx, ShockFramebufferView* fb)
+{
+	if(!psx)
+		return SHOCK_NOCANDO;
+
+	PSXBinding bind(psx);
+	return bind->GetFramebufferView(fb);
+}
+
+MDFN_COLD void PSX::LoadEXE(const uint8 *data, const uint32 size, bool ignore_pcsp)
 {
  uint32 PC;
  uint32 SP;
@@ -2085,22 +2466,28 @@ static MDFN_COLD void LoadEXE(const uint8 *data, const uint32 size, bool ignore_
  po += 4;
 }
 
-EW_EXPORT s32 shock_MountEXE(void* psx, void* exebuf, s32 size, s32 ignore_pcsp)
+s32 PSX::MountEXE(void* exebuf, s32 size, s32 ignore_pcsp)
 {
 	LoadEXE((uint8*)exebuf, (uint32)size, !!ignore_pcsp);
 	return SHOCK_OK;
 }
 
+EW_EXPORT s32 shock_MountEXE(void* psx, void* exebuf, s32 size, s32 ignore_pcsp)
+{
+	if(!psx)
+		return SHOCK_NOCANDO;
+
+	PSXBinding bind(psx);
+	return bind->MountEXE(exebuf, size, ignore_pcsp);
+}
+
 EW_EXPORT s32 shock_CreateDisc(ShockDiscRef** outDisc, void *Opaque, s32 lbaCount, ShockDisc_ReadTOC ReadTOC, ShockDisc_ReadLBA ReadLBA2448, bool suppliesDeinterleavedSubcode)
 {
 	*outDisc = new ShockDiscRef(Opaque, lbaCount, ReadTOC, ReadLBA2448, suppliesDeinterleavedSubcode);
 	return SHOCK_OK;
 }
 
-ShockDiscRef* s_CurrDisc = NULL;
-ShockDiscInfo s_CurrDiscInfo;
-
-static s32 _shock_SetOrPokeDisc(void* psx, ShockDiscRef* disc, bool poke)
+s32 PSX::_shock_SetOrPokeDisc(ShockDiscRef* disc, bool poke)
 {
 	ShockDiscInfo info;
 	strcpy(info.id,"\0\0\0\0");
@@ -2118,23 +2505,41 @@ static s32 _shock_SetOrPokeDisc(void* psx, ShockDiscRef* disc, bool poke)
 	return SHOCK_OK;
 }
 
+s32 PSX::SetDisc(ShockDiscRef* disc)
+{
+	return _shock_SetOrPokeDisc(disc,false);
+}
+
 //Sets the disc in the tray. Returns SHOCK_NOCANDO if it's closed (TODO). You can pass NULL to remove a disc from the tray
 EW_EXPORT s32 shock_SetDisc(void* psx, ShockDiscRef* disc)
 {
-	return _shock_SetOrPokeDisc(psx,disc,false);
+	if(!psx)
+		return SHOCK_NOCANDO;
+
+	PSXBinding bind(psx);
+	return bind->SetDisc(disc);
 }
 
-EW_EXPORT s32 shock_PokeDisc(void* psx, ShockDiscRef* disc)
+s32 PSX::PokeDisc(ShockDiscRef* disc)
 {
 	//let's talk about why this function is needed. well, let's paste an old comment on the subject:
 	//heres a comment from some old savestating code. something to keep in mind (maybe or maybe not a surprise depending on your point of view)
 	//"Call SetDisc() BEFORE we load CDC state, since SetDisc() has emulation side effects.  We might want to clean this up in the future."
 	//I'm not really sure I like how SetDisc works, so I'm glad this was brought to our attention
 
-	return _shock_SetOrPokeDisc(psx,disc,true);
+	return _shock_SetOrPokeDisc(disc,true);
 }
 
-EW_EXPORT s32 shock_OpenTray(void* psx)
+EW_EXPORT s32 shock_PokeDisc(void* psx, ShockDiscRef* disc)
+{
+	if(!psx)
+		return SHOCK_NOCANDO;
+
+	PSXBinding bind(psx);
+	return bind->PokeDisc(disc);
+}
+
+s32 PSX::OpenTray()
 {
 	if(s_ShockState.eject) return SHOCK_NOCANDO;
 	s_ShockState.eject = true;
@@ -2142,7 +2547,16 @@ EW_EXPORT s32 shock_OpenTray(void* psx)
 	return SHOCK_OK;
 }
 
-EW_EXPORT s32 shock_CloseTray(void* psx)
+EW_EXPORT s32 shock_OpenTray(void* psx)
+{
+	if(!psx)
+		return SHOCK_NOCANDO;
+
+	PSXBinding bind(psx);
+	return bind->OpenTray();
+}
+
+s32 PSX::CloseTray()
 {
 	if(!s_ShockState.eject) return SHOCK_NOCANDO;
 	s_ShockState.eject = false;
@@ -2150,6 +2564,15 @@ EW_EXPORT s32 shock_CloseTray(void* psx)
 	return SHOCK_OK;
 }
 
+EW_EXPORT s32 shock_CloseTray(void* psx)
+{
+	if(!psx)
+		return SHOCK_NOCANDO;
+
+	PSXBinding bind(psx);
+	return bind->CloseTray();
+}
+
 
 EW_EXPORT s32 shock_DestroyDisc(ShockDiscRef* disc)
 {
@@ -2157,6 +2580,13 @@ EW_EXPORT s32 shock_DestroyDisc(ShockDiscRef* disc)
 	return SHOCK_OK;
 }
 
+EW_EXPORT s32 shock_SetDiscPrefetch(ShockDiscRef* disc, s32 sectors)
+{
+	if(sectors < 0) return SHOCK_ERROR;
+	disc->SetPrefetch(sectors);
+	return SHOCK_OK;
+}
+
 
 class CDIF_Stream_Thing : public Stream
 {
@@ -2526,6 +2956,149 @@ Breakout:
 	return SHOCK_OK;
 }
 
+//Reads sectors ahead of the emulated drive on a background thread, into a small direct-mapped ring.
+//The emulation gets exactly the same data either way, whether or not a sector was ready; on a miss, it reads it itself.
+//This relies on the frontend returning the same data for a given sector every time.
+class ShockDiscPrefetcher
+{
+public:
+	ShockDiscPrefetcher(void* opaque, s32 lbaCount, ShockDisc_ReadLBA cbReadLBA2448, s32 sectors)
+		: mOpaque(opaque)
+		, mLbaCount(lbaCount)
+		, mcbReadLBA2448(cbReadLBA2448)
+		, mSlots(sectors)
+		, mNext(0)
+		, mEnd(0)
+		, mQuit(false)
+	{
+		for(auto& slot : mSlots)
+			slot.lba = INT32_MIN;
+		mThread = std::thread(&ShockDiscPrefetcher::ThreadMain, this);
+	}
+
+	~ShockDiscPrefetcher()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mRingLock);
+			mQuit = true;
+		}
+		mRingCond.notify_all();
+		mThread.join();
+	}
+
+	//reads the sector (from the ring if it's there), and starts fetching the ones after it
+	s32 Read(s32 lba, void* dst2448)
+	{
+		s32 ret;
+		bool hit = false;
+
+		{
+			std::lock_guard<std::mutex> lock(mRingLock);
+			const Slot& slot = mSlots[SlotIndex(lba)];
+			if(slot.lba == lba)
+			{
+				memcpy(dst2448, slot.data, sizeof(slot.data));
+				ret = slot.ret;
+				hit = true;
+			}
+		}
+
+		if(!hit)
+			ret = Call(lba, dst2448);
+
+		{
+			std::lock_guard<std::mutex> lock(mRingLock);
+			mNext = lba + 1;
+			mEnd = std::min<s32>(lba + (s32)mSlots.size(), mLbaCount);
+		}
+		mRingCond.notify_one();
+
+		return ret;
+	}
+
+	//all frontend callbacks go through here, so they're never issued concurrently
+	s32 Call(s32 lba, void* dst2448)
+	{
+		std::lock_guard<std::mutex> lock(mCallbackLock);
+		return mcbReadLBA2448(mOpaque, lba, dst2448);
+	}
+
+	std::mutex& CallbackLock() { return mCallbackLock; }
+
+private:
+	struct Slot
+	{
+		s32 lba;
+		s32 ret;
+		u8 data[2448];
+	};
+
+	size_t SlotIndex(s32 lba) { return (u32)(lba + 150) % mSlots.size(); }
+
+	void ThreadMain()
+	{
+		std::unique_lock<std::mutex> lock(mRingLock);
+
+		for(;;)
+		{
+			mRingCond.wait(lock, [this]{ return mQuit || mNext < mEnd; });
+			if(mQuit)
+				return;
+
+			const s32 lba = mNext++;
+			if(mSlots[SlotIndex(lba)].lba == lba)
+				continue;
+
+			lock.unlock();
+			u8 buf[2448];
+			const s32 ret = Call(lba, buf);
+			lock.lock();
+
+			Slot& slot = mSlots[SlotIndex(lba)];
+			slot.lba = lba;
+			slot.ret = ret;
+			memcpy(slot.data, buf, sizeof(buf));
+		}
+	}
+
+	void* const mOpaque;
+	const s32 mLbaCount;
+	const ShockDisc_ReadLBA mcbReadLBA2448;
+
+	std::vector<Slot> mSlots;
+	s32 mNext, mEnd; //sectors still to fetch
+	bool mQuit;
+	std::mutex mRingLock;
+	std::condition_variable mRingCond;
+	std::mutex mCallbackLock;
+	std::thread mThread;
+};
+
+ShockDiscRef::~ShockDiscRef()
+{
+	delete mPrefetcher;
+}
+
+void ShockDiscRef::SetPrefetch(s32 sectors)
+{
+	delete mPrefetcher;
+	mPrefetcher = NULL;
+
+	if(sectors > 0)
+		mPrefetcher = new ShockDiscPrefetcher(mOpaque, mLbaCount, mcbReadLBA2448, sectors);
+}
+
+s32 ShockDiscRef::ReadTOC(ShockTOC *read_target, ShockTOCTrack tracks[100 + 1])
+{
+	if(mPrefetcher)
+	{
+		std::lock_guard<std::mutex> lock(mPrefetcher->CallbackLock());
+		return mcbReadTOC(mOpaque, read_target, tracks);
+	}
+
+	return mcbReadTOC(mOpaque, read_target, tracks);
+}
+
 bool ShockDiscRef::ReadLBA_PW(uint8* pwbuf96, int32 lba, bool hint_fullread)
 {
 	//TODO - whats that hint mean
@@ -2546,7 +3119,7 @@ s32 ShockDiscRef::ReadLBA2448(s32 lba, void* dst2448)
 
 s32 ShockDiscRef::InternalReadLBA2448(s32 lba, void* dst2448, bool needSubcode)
 {
-	int ret = mcbReadLBA2448(mOpaque, lba, dst2448);
+	int ret = mPrefetcher ? mPrefetcher->Read(lba, dst2448) : mcbReadLBA2448(mOpaque, lba, dst2448);
 	if(ret != SHOCK_OK)
 		return ret;
 	
@@ -2602,7 +3175,8 @@ s32 ShockDiscRef::ReadLBA2048(s32 lba, void* dst2048)
 		u8 buf[2352];
 	};
 
-	static union {
+	//(named, since gcc won't take anonymous structs inside an unnamed union)
+	union SectorBuf2448 {
 		struct {
 			union {
 				XASector xasector;
@@ -2612,28 +3186,28 @@ s32 ShockDiscRef::ReadLBA2048(s32 lba, void* dst2048)
 		};
 		u8 buf2448[2448];
 	};
+	SectorBuf2448 buf;
 
-	s32 ret = InternalReadLBA2448(lba,buf2448,false);
+	s32 ret = InternalReadLBA2448(lba,buf.buf2448,false);
 	if(ret != SHOCK_OK)
 		return ret;
 
-	if(sector.mode == 1)
-		memcpy(dst2048,sector.data2048,2048);
+	if(buf.sector.mode == 1)
+		memcpy(dst2048,buf.sector.data2048,2048);
 	else
-		memcpy(dst2048,xasector.form1.data2048,2048);
+		memcpy(dst2048,buf.xasector.form1.data2048,2048);
 
-	return sector.mode;
+	return buf.sector.mode;
 }
 
-//Returns information about a memory buffer for peeking (main memory, spu memory, etc.)
-EW_EXPORT s32 shock_GetMemData(void* psx, void** ptr, s32* size, s32 memType)
+s32 PSX::GetMemData(void** ptr, s32* size, s32 memType)
 {
 	switch(memType)
 	{
-	case eMemType_MainRAM: *ptr = MainRAM.data8; *size = 2048*1024; break;
+	case eMemType_MainRAM: *ptr = MainRAM->data8; *size = 2048*1024; break;
 	case eMemType_BiosROM: *ptr = BIOSROM->data8; *size = 512*1024; break;
 	case eMemType_PIOMem: *ptr = PIOMem->data8; *size = 64*1024; break;
-	case eMemType_GPURAM: *ptr = GPU.GPURAM; *size = 2*512*1024; break;
+	case eMemType_GPURAM: GPU->SyncRAM(); *ptr = GPU->GPURAM; *size = 2*512*1024; break;
 	case eMemType_SPURAM: *ptr = SPU->SPURAM; *size = 512*1024; break;
 	case eMemType_DCache: *ptr = CPU->debug_GetScratchRAMPtr(); *size = 1024; break;
 	default:
@@ -2642,23 +3216,20 @@ EW_EXPORT s32 shock_GetMemData(void* psx, void** ptr, s32* size, s32 memType)
 	return SHOCK_OK;
 }
 
-class PSX
+//Returns information about a memory buffer for peeking (main memory, spu memory, etc.)
+EW_EXPORT s32 shock_GetMemData(void* psx, void** ptr, s32* size, s32 memType)
 {
-public:
-	template<bool isReader>void SyncState(EW::NewState *ns);
-} s_PSX;
+	if(!psx)
+		return SHOCK_NOCANDO;
 
-namespace MDFN_IEN_PSX {
-void DMA_SyncState(bool isReader, EW::NewState *ns);
-void GTE_SyncState(bool isReader, EW::NewState *ns);
-void TIMER_SyncState(bool isReader, EW::NewState *ns);
-void SIO_SyncState(bool isReader, EW::NewState *ns);
-void MDEC_SyncState(bool isReader, EW::NewState *ns);
-void IRQ_SyncState(bool isReader, EW::NewState *ns);
+	PSXBinding bind(psx);
+	return bind->GetMemData(ptr, size, memType);
 }
 
 SYNCFUNC(PSX)
 {
+  auto& MainRAM = *this->MainRAM; //keeps the "MainRAM.data8" name the text savestates go by
+
   NSS(s_ShockState);
   PSS(MainRAM.data8, 2*1024*1024);
   NSS(SysControl.Regs);
@@ -2682,28 +3253,30 @@ SYNCFUNC(PSX)
 	TSS(CPU);
 
 	ns->EnterSection("GTE");
-	GTE_SyncState(isReader,ns);
+	CPU->GTE.SyncState(isReader,ns);
 	ns->ExitSection("GTE");
 
 	ns->EnterSection("DMA");
-	DMA_SyncState(isReader,ns);
+	DMA->SyncState(isReader,ns);
 	ns->ExitSection("DMA");
 
 	ns->EnterSection("TIMER");
-	TIMER_SyncState(isReader,ns);
+	TIMER->SyncState(isReader,ns);
 	ns->ExitSection("TIMER");
 
 	ns->EnterSection("SIO");
-	SIO_SyncState(isReader,ns);
+	SIO->SyncState(isReader,ns);
 	ns->ExitSection("SIO");
 
 	TSS(CDC);
 
 	ns->EnterSection("MDEC");
-	MDEC_SyncState(isReader,ns);
+	MDEC->SyncState(isReader,ns);
 	ns->ExitSection("MDEC");
 
-	TSS((&GPU)); //did some special logic for the CPU, ordering may matter, but probably not
+	ns->EnterSection("(&GPU)"); //section name kept from when GPU was a global object
+	GPU->SyncState<isReader>(ns);
+	ns->ExitSection("(&GPU)"); //did some special logic for the CPU, ordering may matter, but probably not
 
 	TSS(SPU);
 	TSS(FIO); //TODO - DUALSHOCK, MC
@@ -2713,7 +3286,7 @@ SYNCFUNC(PSX)
 	 //ret &= IRQ_StateAction(sm, load, data_only);	// 
 
 	ns->EnterSection("IRQ");
-	IRQ_SyncState(isReader,ns);
+	IRQ->SyncState(isReader,ns);
 	ns->ExitSection("IRQ");
 
 	if(isReader)
@@ -2726,21 +3299,25 @@ SYNCFUNC(PSX)
 	}
 }
 
-EW_EXPORT s32 shock_StateTransaction(void *psx, ShockStateTransaction* transaction)
+s32 PSX::StateTransaction(ShockStateTransaction* transaction)
 {
 	switch(transaction->transaction)
 	{
 	case eShockStateTransaction_BinarySize:
 		{
-			EW::NewStateDummy dummy;
-			s_PSX.SyncState<false>(&dummy);
-			return dummy.GetLength();
+			if(s_StateSize < 0)
+			{
+				EW::NewStateDummy dummy;
+				SyncState<false>(&dummy);
+				s_StateSize = dummy.GetLength();
+			}
+			return s_StateSize;
 		}
 	case eShockStateTransaction_BinaryLoad:
 		{
 			if(transaction->buffer == NULL) return SHOCK_ERROR;
 			EW::NewStateExternalBuffer loader((char*)transaction->buffer, transaction->bufferLength);
-			s_PSX.SyncState<true>(&loader);
+			SyncState<true>(&loader);
 			if(!loader.Overflow() && loader.GetLength() == transaction->bufferLength)
 				return SHOCK_OK;
 			else return SHOCK_ERROR;
@@ -2749,21 +3326,46 @@ EW_EXPORT s32 shock_StateTransaction(void *psx, ShockStateTransaction* transacti
 		{
 			if(transaction->buffer == NULL) return SHOCK_ERROR;
 			EW::NewStateExternalBuffer saver((char*)transaction->buffer, transaction->bufferLength);
-			s_PSX.SyncState<false>(&saver);
+			SyncState<false>(&saver);
 			if(!saver.Overflow() && saver.GetLength() == transaction->bufferLength)
 				return SHOCK_OK;
 			else return SHOCK_ERROR;
 		}
+	case eShockStateTransaction_BinaryDeltaSave:
+		{
+			//with no buffer, compare against nothing to get the largest size
+			if(transaction->buffer == NULL)
+			{
+				EW::NewStateDeltaBuffer sizer(NULL, 0, NULL, 0);
+				SyncState<false>(&sizer);
+				return sizer.GetLength();
+			}
+			if(transaction->reference == NULL) return SHOCK_ERROR;
+			EW::NewStateDeltaBuffer saver((char*)transaction->buffer, transaction->bufferLength, (const char*)transaction->reference, transaction->referenceLength);
+			SyncState<false>(&saver);
+			if(!saver.Overflow() && saver.GetReferenceLength() == transaction->referenceLength)
+				return saver.GetLength();
+			else return SHOCK_ERROR;
+		}
+	case eShockStateTransaction_BinaryDeltaLoad:
+		{
+			if(transaction->buffer == NULL || transaction->reference == NULL) return SHOCK_ERROR;
+			EW::NewStateDeltaBuffer loader((char*)transaction->buffer, transaction->bufferLength, (const char*)transaction->reference, transaction->referenceLength);
+			SyncState<true>(&loader);
+			if(!loader.Overflow() && !loader.BadReference() && loader.GetLength() == transaction->bufferLength && loader.GetReferenceLength() == transaction->referenceLength)
+				return SHOCK_OK;
+			else return SHOCK_ERROR;
+		}
 	case eShockStateTransaction_TextLoad:
 		{
 			EW::NewStateExternalFunctions saver(&transaction->ff);
-			s_PSX.SyncState<true>(&saver);
+			SyncState<true>(&saver);
 			return SHOCK_OK;
 		}
 	case eShockStateTransaction_TextSave:
 		{
 			EW::NewStateExternalFunctions loader(&transaction->ff);
-			s_PSX.SyncState<false>(&loader);
+			SyncState<false>(&loader);
 			return SHOCK_OK;
 		}
 		return SHOCK_ERROR;
@@ -2773,7 +3375,16 @@ EW_EXPORT s32 shock_StateTransaction(void *psx, ShockStateTransaction* transacti
 	}
 }
 
-EW_EXPORT s32 shock_GetRegisters_CPU(void* psx, ShockRegisters_CPU* buffer)
+EW_EXPORT s32 shock_StateTransaction(void* psx, ShockStateTransaction* transaction)
+{
+	if(!psx)
+		return SHOCK_NOCANDO;
+
+	PSXBinding bind(psx);
+	return bind->StateTransaction(transaction);
+}
+
+s32 PSX::GetRegisters_CPU(ShockRegisters_CPU* buffer)
 {
 	memcpy(buffer->GPR,CPU->debug_GetGPRPtr(),32*4);
 	buffer->PC = CPU->GetRegister(PS_CPU::GSREG_PC_NEXT,NULL,0);
@@ -2788,8 +3399,16 @@ EW_EXPORT s32 shock_GetRegisters_CPU(void* psx, ShockRegisters_CPU* buffer)
 	return SHOCK_OK;
 }
 
-//Sets a CPU register. Rather than have an enum for the registers, lets just use the index (not offset) within the struct
-EW_EXPORT s32 shock_SetRegister_CPU(void* psx, s32 index, u32 value)
+EW_EXPORT s32 shock_GetRegisters_CPU(void* psx, ShockRegisters_CPU* buffer)
+{
+	if(!psx)
+		return SHOCK_NOCANDO;
+
+	PSXBinding bind(psx);
+	return bind->GetRegisters_CPU(buffer);
+}
+
+s32 PSX::SetRegister_CPU(s32 index, u32 value)
 {
 	//takes advantage of layout of GSREG_ matchign our struct (not an accident!)
 	CPU->SetRegister((u32)index,value);
@@ -2797,66 +3416,181 @@ EW_EXPORT s32 shock_SetRegister_CPU(void* psx, s32 index, u32 value)
 	return SHOCK_OK;
 }
 
-EW_EXPORT s32 shock_SetRenderOptions(void* pxs, ShockRenderOptions* opts)
+//Sets a CPU register. Rather than have an enum for the registers, lets just use the index (not offset) within the struct
+EW_EXPORT s32 shock_SetRegister_CPU(void* psx, s32 index, u32 value)
+{
+	if(!psx)
+		return SHOCK_NOCANDO;
+
+	PSXBinding bind(psx);
+	return bind->SetRegister_CPU(index, value);
+}
+
+s32 PSX::SetRenderOptions(ShockRenderOptions* opts)
 {
-	GPU.SetRenderOptions(opts);
+	GPU->SetRenderOptions(opts);
 	s_ShockConfig.opts = *opts;
 	return SHOCK_OK;
 }
 
-extern void* g_ShockTraceCallbackOpaque;
-extern ShockCallback_Trace g_ShockTraceCallback;
-extern ShockCallback_Mem g_ShockMemCallback;
-extern eShockMemCb g_ShockMemCbType;
+EW_EXPORT s32 shock_SetRenderOptions(void* psx, ShockRenderOptions* opts)
+{
+	if(!psx)
+		return SHOCK_NOCANDO;
+
+	PSXBinding bind(psx);
+	return bind->SetRenderOptions(opts);
+}
+
+s32 PSX::SetTraceCallback(void* opaque, ShockCallback_Trace callback)
+{
+	CPU->SetTraceCallback(opaque, callback);
+
+	return SHOCK_OK;
+}
 
 //Sets the callback to be used for CPU tracing
 EW_EXPORT s32 shock_SetTraceCallback(void* psx, void* opaque, ShockCallback_Trace callback)
 {
-	g_ShockTraceCallbackOpaque = opaque;
-	g_ShockTraceCallback = callback;
+	if(!psx)
+		return SHOCK_NOCANDO;
+
+	PSXBinding bind(psx);
+	return bind->SetTraceCallback(opaque, callback);
+}
+
+s32 PSX::SetBinaryTrace(ShockTraceRecord* buffer, s32 capacity, void* opaque, ShockCallback_TraceFlush flush)
+{
+	if (buffer && (capacity <= 0 || !flush))
+		return SHOCK_ERROR;
+
+	CPU->SetBinaryTrace(buffer, capacity, opaque, flush);
+
+	return SHOCK_OK;
+}
+
+//Sets up binary tracing into a frontend buffer, flushed when full and at the end of every frame
+EW_EXPORT s32 shock_SetBinaryTrace(void* psx, ShockTraceRecord* buffer, s32 capacity, void* opaque, ShockCallback_TraceFlush flush)
+{
+	if(!psx)
+		return SHOCK_NOCANDO;
+
+	PSXBinding bind(psx);
+	return bind->SetBinaryTrace(buffer, capacity, opaque, flush);
+}
+
+s32 PSX::SetMemCb(ShockCallback_Mem callback, eShockMemCb cbMask, const ShockMemCbRange* ranges, s32 nranges)
+{
+	if (ranges && nranges < 0)
+		return SHOCK_ERROR;
 
+	CPU->SetMemCb(callback, cbMask, ranges, nranges);
 	return SHOCK_OK;
 }
 
 //Sets the callback to be used for memory hook events
-EW_EXPORT s32 shock_SetMemCb(void* psx, ShockCallback_Mem callback, eShockMemCb cbMask)
+//ranges selects the addresses to be watched (at 4KB page granularity, so the frontend must still check the exact address); pass NULL to watch everything
+EW_EXPORT s32 shock_SetMemCb(void* psx, ShockCallback_Mem callback, eShockMemCb cbMask, const ShockMemCbRange* ranges, s32 nranges)
+{
+	if(!psx)
+		return SHOCK_NOCANDO;
+
+	PSXBinding bind(psx);
+	return bind->SetMemCb(callback, cbMask, ranges, nranges);
+}
+
+s32 PSX::SetLEC(bool enabled)
 {
-	g_ShockMemCallback = callback;
-	g_ShockMemCbType = cbMask;
+	CDC->SetLEC(enabled);
 	return SHOCK_OK;
 }
 
 //Sets whether LEC is enabled (sector level error correction). Defaults to FALSE (disabled)
 EW_EXPORT s32 shock_SetLEC(void* psx, bool enabled)
 {
-	CDC->SetLEC(enabled);
-	return SHOCK_OK;
+	if(!psx)
+		return SHOCK_NOCANDO;
+
+	PSXBinding bind(psx);
+	return bind->SetLEC(enabled);
+}
+
+s32 PSX::GetGPUUnlagged()
+{
+	return GpuFrameForLag ? SHOCK_TRUE : SHOCK_FALSE;
 }
 
 //whether "determine lag from GPU frames" signal is set (GPU did something considered non-lag)
 //returns SHOCK_TRUE or SHOCK_FALSE
 EW_EXPORT s32 shock_GetGPUUnlagged(void* psx)
 {
-	return GpuFrameForLag ? SHOCK_TRUE : SHOCK_FALSE;
+	if(!psx)
+		return SHOCK_NOCANDO;
+
+	PSXBinding bind(psx);
+	return bind->GetGPUUnlagged();
+}
+
+s32 PSX::GetProfile(ShockProfile* profile)
+{
+#ifdef WANT_PSX_PROFILE
+	//work out how long a tick is over the span since the last call
+	const uint64 ticks = ProfileTicks();
+	const std::chrono::steady_clock::time_point time = std::chrono::steady_clock::now();
+	double ns_per_tick = 0;
+	if (ProfileCalibTicks && ticks != ProfileCalibTicks)
+		ns_per_tick = std::chrono::duration<double, std::nano>(time - ProfileCalibTime).count() / (double)(ticks - ProfileCalibTicks);
+	ProfileCalibTicks = ticks;
+	ProfileCalibTime = time;
+
+	profile->cpu = (u64)(ProfileTime[PSX_PROF_CPU] * ns_per_tick);
+	profile->gpu = (u64)(ProfileTime[PSX_PROF_GPU] * ns_per_tick);
+	profile->spu = (u64)(ProfileTime[PSX_PROF_SPU] * ns_per_tick);
+	profile->cdc = (u64)(ProfileTime[PSX_PROF_CDC] * ns_per_tick);
+	profile->mdec = (u64)(ProfileTime[PSX_PROF_MDEC] * ns_per_tick);
+	memset(ProfileTime, 0, sizeof(ProfileTime));
+	return SHOCK_OK;
+#else
+	return SHOCK_NOCANDO;
+#endif
 }
 
-EW_EXPORT s32 shock_PeekMemory(void* psx, u32 address, u8* value) 
+EW_EXPORT s32 shock_GetProfile(void* psx, ShockProfile* profile)
 {
-	if (!s_Created) {
+	if(!psx)
 		return SHOCK_NOCANDO;
-	}
 
+	PSXBinding bind(psx);
+	return bind->GetProfile(profile);
+}
+
+s32 PSX::PeekMemory(u32 address, u8* value)
+{
 	*value = CPU->PeekMem8(address);
 	return SHOCK_OK;
 }
 
-EW_EXPORT s32 shock_PokeMemory(void* psx, u32 address, u8 value) 
+EW_EXPORT s32 shock_PeekMemory(void* psx, u32 address, u8* value)
 {
-	if (!s_Created) {
+	if(!psx)
 		return SHOCK_NOCANDO;
-	}
 
+	PSXBinding bind(psx);
+	return bind->PeekMemory(address, value);
+}
+
+s32 PSX::PokeMemory(u32 address, u8 value)
+{
 	CPU->PokeMem8(address, value);
 	return SHOCK_OK;
 
 }
+
+EW_EXPORT s32 shock_PokeMemory(void* psx, u32 address, u8 value)
+{
+	if(!psx)
+		return SHOCK_NOCANDO;
+
+	PSXBinding bind(psx);
+	return bind->PokeMemory(address, value);
+}
@@ -107,12 +107,44 @@ namespace MDFN_IEN_PSX
 
  #define PSX_EVENT_MAXTS       		0x20000000
  void PSX_SetEventNT(const int type, const pscpu_timestamp_t next_timestamp);
+ void PSX_CancelEvent(const int type);	// Same as setting it to PSX_EVENT_MAXTS.
 
  void PSX_SetDMACycleSteal(unsigned stealage);
 
  void PSX_GPULineHook(const pscpu_timestamp_t timestamp, const pscpu_timestamp_t line_timestamp, bool vsync, uint32 *pixels, const MDFN_PixelFormat* const format, const unsigned width, const unsigned pix_clock_offset, const unsigned pix_clock, const unsigned pix_clock_divider);
 
  uint32 PSX_GetRandU32(uint32 mina, uint32 maxa);
+
+#ifdef WANT_PSX_PROFILE
+ //
+ // Wall-clock time accounting per subsystem, for shock_GetProfile().  Time is charged to the subsystem entered most recently,
+ // so it's exclusive(the CDC's time doesn't include the SPU it clocks); PSX_PROF_CPU gets everything not claimed by another.
+ //
+ enum
+ {
+  PSX_PROF_CPU = 0,
+  PSX_PROF_GPU,
+  PSX_PROF_SPU,
+  PSX_PROF_CDC,
+  PSX_PROF_MDEC,
+  PSX_PROF__COUNT,
+
+  PSX_PROF_KEEP = PSX_PROF__COUNT	// Stay with the current one.
+ };
+
+ unsigned PSX_ProfileSwitch(unsigned which);	// Returns the previous subsystem.
+
+ struct PSX_ProfileScope
+ {
+  INLINE PSX_ProfileScope(unsigned which) : prev(PSX_ProfileSwitch(which)) { }
+  INLINE ~PSX_ProfileScope() { PSX_ProfileSwitch(prev); }
+
+  const unsigned prev;
+ };
+ #define PSX_PROFILE(which) PSX_ProfileScope psx_profile_scope(which)
+#else
+ #define PSX_PROFILE(which)
+#endif
 }
 
 
@@ -129,10 +161,10 @@ namespace MDFN_IEN_PSX
  class PS_CDC;
  class PS_SPU;
 
- MDFN_HIDE extern PS_CPU *CPU;
- MDFN_HIDE extern PS_CDC *CDC;
- MDFN_HIDE extern PS_SPU *SPU;
- MDFN_HIDE extern MultiAccessSizeMem<2048 * 1024, false> MainRAM;
+ MDFN_HIDE extern EW_THREAD PS_CPU *CPU;
+ MDFN_HIDE extern EW_THREAD PS_CDC *CDC;
+ MDFN_HIDE extern EW_THREAD PS_SPU *SPU;
+ MDFN_HIDE extern EW_THREAD MultiAccessSizeMem<2048 * 1024, false> *MainRAM;
 }
 
 enum eRegion
@@ -147,12 +179,17 @@ enum eShockDeinterlaceMode
 {
 	eShockDeinterlaceMode_Weave,
 	eShockDeinterlaceMode_Bob,
-	eShockDeinterlaceMode_BobOffset
+	eShockDeinterlaceMode_BobOffset,
+	eShockDeinterlaceMode_Blend
 };
 
 enum eShockStep
 {
-	eShockStep_Frame
+	eShockStep_Frame,
+
+	//flag, OR'd into the step type: don't produce any sound this step (shock_GetSamples will return nothing).
+	//all the SPU state games can see (envelopes, reverb work area, capture buffers, IRQs) is still emulated, so savestates are unaffected
+	eShockStep_SkipAudio = 0x100
 };
 
 enum eShockFramebufferFlags
@@ -201,7 +238,9 @@ enum eShockStateTransaction : s32
 	eShockStateTransaction_BinaryLoad = 1,
 	eShockStateTransaction_BinarySave = 2,
 	eShockStateTransaction_TextLoad = 3,
-	eShockStateTransaction_TextSave = 4
+	eShockStateTransaction_TextSave = 4,
+	eShockStateTransaction_BinaryDeltaSave = 5, //saves only what changed since the reference state; returns the length of the delta (or the largest it could be, if the buffer is NULL)
+	eShockStateTransaction_BinaryDeltaLoad = 6 //loads a delta made with BinaryDeltaSave; the reference state must be the same one it was saved against
 };
 
 enum eShockMemcardTransaction
@@ -213,7 +252,7 @@ enum eShockMemcardTransaction
 	eShockMemcardTransaction_CheckDirty = 4, //checks whether the memcard is dirty
 };
 
-enum eShockMemCb
+enum eShockMemCb : s32
 {
 	eShockMemCb_None = 0,
 	eShockMemCb_Read = 1,
@@ -267,11 +306,36 @@ typedef s32 (*ShockDisc_ReadLBA)(void* opaque, s32 lba, void* dst);
 //The callback to be issued for traces
 typedef void (*ShockCallback_Trace)(void* opaque, u32 PC, u32 inst, const char* msg);
 
+//a record written by the binary tracer for every executed instruction.
+//nothing is disassembled while running; run PC and instr through shock_Util_DisassembleMIPS afterwards if text is wanted
+struct ShockTraceRecord
+{
+	u32 PC;
+	u32 instr;
+	u32 timestamp; //cpu timestamp at fetch (rebased at the end of every frame)
+	u32 value; //what the instruction wrote to GPR[reg]. for loads, that's the value arriving after the delay slot
+	u8 reg; //the GPR written by the instruction, or 0 if none
+	u8 pad[3];
+};
+
+//the callback to be issued with binary trace records, when the buffer fills up and at the end of every frame
+typedef void (*ShockCallback_TraceFlush)(void* opaque, const ShockTraceRecord* records, u32 count);
+
 //the callback to be issued for memory hook events
 //note: only one callback can be set. the type is sent to mask that one callback, not indicate which event type the callback is fore.
 //there isnt one callback per type.
 typedef void (*ShockCallback_Mem)(u32 address, eShockMemCb type, u32 size, u32 value);
 
+//an inclusive address range to watch for the given event types (any combination of eShockMemCb bits).
+//reads are matched against the physical address; writes and executes against the virtual address, the same as what the callback receives
+struct ShockMemCbRange
+{
+	u32 type;
+	u32 start, end;
+};
+
+class ShockDiscPrefetcher;
+
 class ShockDiscRef
 {
 public:
@@ -281,13 +345,16 @@ public:
 		, mcbReadTOC(cbReadTOC)
 		, mcbReadLBA2448(cbReadLBA2448)
 		, mSuppliesDeinterleavedSubcode(suppliesDeinterleavedSubcode)
+		, mPrefetcher(NULL)
 	{
 	}
 
-	s32 ReadTOC( ShockTOC *read_target, ShockTOCTrack tracks[100 + 1])
-	{
-		return mcbReadTOC(mOpaque, read_target, tracks);
-	}
+	~ShockDiscRef();
+
+	s32 ReadTOC( ShockTOC *read_target, ShockTOCTrack tracks[100 + 1]);
+
+	//reads up to `sectors` sectors ahead of the last one read on a background thread. 0 turns it off.
+	void SetPrefetch(s32 sectors);
 
 	//formerly ReadRawSector
 	//Reads 2352 + 96
@@ -309,6 +376,7 @@ private:
 	ShockDisc_ReadTOC mcbReadTOC;
 	ShockDisc_ReadLBA mcbReadLBA2448;
 	bool mSuppliesDeinterleavedSubcode;
+	ShockDiscPrefetcher* mPrefetcher;
 };
 
 struct ShockDiscInfo
@@ -324,12 +392,32 @@ struct ShockFramebufferInfo
 	void* ptr;
 };
 
+//A view into the core's own framebuffer, for frontends that can consume it in place
+struct ShockFramebufferView
+{
+	s32 flags; //in: eShockFramebufferFlags
+	s32 width, height; //size of the visible region
+	s32 x, y; //position of the visible region within the buffer
+	s32 pitch; //distance between rows, in pixels
+	const u32* pixels; //the buffer; the visible region starts at pixels[y*pitch + x]
+};
+
 struct ShockRenderOptions
 {
 	s32 scanline_start, scanline_end;
 	eShockRenderType renderType;
 	eShockDeinterlaceMode deinterlaceMode;
 	bool skip;
+
+	//number of threads to rasterize untextured polygons on; 0 or 1 renders everything on the emulation thread.
+	//output and timing are identical either way.
+	s32 renderThreads;
+};
+
+//time spent in each subsystem, in nanoseconds. each one excludes the others; cpu gets everything not claimed by another
+struct ShockProfile
+{
+	u64 cpu, gpu, spu, cdc, mdec;
 };
 
 struct ShockMemcardTransaction
@@ -346,6 +434,10 @@ struct ShockStateTransaction
 
 	//originally this was a pointer, however, we had problems getting it to marshal correctly
 	EW::FPtrs ff;
+
+	//for the delta transactions: a full binary state (from BinarySave) of the same configuration
+	const void *reference;
+	s32 referenceLength;
 };
 
 //Creates a ShockDiscRef (representing a disc) with the given properties. Returns it in the specified output pointer.
@@ -356,12 +448,19 @@ EW_EXPORT s32 shock_CreateDisc(ShockDiscRef** outDisc, void *Opaque, s32 lbaCoun
 //Destroys a ShockDiscRef created with shock_CreateDisc. Make sure you havent left it in the playstation before destroying it!
 EW_EXPORT s32 shock_DestroyDisc(ShockDiscRef* disc);
 
+//Lets the disc read up to `sectors` sectors ahead of the emulated drive on a background thread, so the emulation doesn't have to wait for them. 0 (the default) turns it off.
+//The ReadLBA2448 callback will then be called from that thread too (never concurrently with itself or ReadTOC), so it has to be safe to call from another thread.
+//It also has to return the same data for a sector every time, which is the case for any disc image. Emulation is otherwise unaffected.
+EW_EXPORT s32 shock_SetDiscPrefetch(ShockDiscRef* disc, s32 sectors);
+
 //Inspects a disc by looking for the system.cnf and retrieves some necessary information about it.
 //Useful for determining the region of a disc
 EW_EXPORT s32 shock_AnalyzeDisc(ShockDiscRef* disc, ShockDiscInfo* info);
 
 //Creates the psx instance as a console of the specified region.
 //Additionally mounts the firmware from the provided buffer (the contents are copied)
+//Any number of instances may exist, and each may be used from any thread, so long as one instance isn't used from two threads at once.
+//Every other function returns SHOCK_NOCANDO when given a NULL handle.
 //TODO - receive a model number parameter instead
 EW_EXPORT s32 shock_Create(void** psx, s32 region, void* firmware512k);
 
@@ -429,6 +528,10 @@ EW_EXPORT s32 shock_Step(void* psx, eShockStep step);
 //This helps us copy fewer times.
 EW_EXPORT s32 shock_GetFramebuffer(void* psx, ShockFramebufferInfo* fb);
 
+//Like shock_GetFramebuffer, but describes the core's framebuffer instead of copying it out.
+//The view is only valid until the next shock_Step (or any other call which can change the framebuffer, such as a savestate load or shock_SetRenderOptions)
+EW_EXPORT s32 shock_GetFramebufferView(void* psx, ShockFramebufferView* fb);
+
 //Returns the queued SPU output (usually ~737 samples per frame) as the normal 16bit interleaved stereo format
 //The size of the queue will be returned. Make sure your buffer can handle it. Pass NULL just to get the required size.
 EW_EXPORT s32 shock_GetSamples(void* psx, void* buffer);
@@ -448,6 +551,10 @@ EW_EXPORT s32 shock_SetRegister_CPU(void* psx, s32 index, u32 value);
 //Sets the callback to be used for CPU tracing
 EW_EXPORT s32 shock_SetTraceCallback(void* psx, void* opaque, ShockCallback_Trace callback);
 
+//Sets up binary tracing into the provided buffer of `capacity` records, which is handed to `flush` whenever it fills up and at the end of every frame.
+//The buffer must stay valid until binary tracing is disabled again by passing NULL. Pending records are flushed when the buffer is changed.
+EW_EXPORT s32 shock_SetBinaryTrace(void* psx, ShockTraceRecord* buffer, s32 capacity, void* opaque, ShockCallback_TraceFlush flush);
+
 //Sets whether LEC is enabled (sector level error correction). Defaults to FALSE (disabled)
 EW_EXPORT s32 shock_SetLEC(void* psx, bool enabled);
 
@@ -455,6 +562,10 @@ EW_EXPORT s32 shock_SetLEC(void* psx, bool enabled);
 //returns SHOCK_TRUE or SHOCK_FALSE
 EW_EXPORT s32 shock_GetGPUUnlagged(void* psx);
 
+//Fetches the time spent in each subsystem since the last call, and resets the counts.
+//Only builds made with WANT_PSX_PROFILE defined keep these; returns SHOCK_NOCANDO otherwise
+EW_EXPORT s32 shock_GetProfile(void* psx, ShockProfile* profile);
+
 EW_EXPORT s32 shock_PeekMemory(void* psx, u32 address, u8* value);
 
 EW_EXPORT s32 shock_PokeMemory(void* psx, u32 address, u8 value);
\ No newline at end of file
@@ -27,13 +27,7 @@ namespace MDFN_IEN_PSX
 
 // Dummy implementation.
 
-static uint16 Status;
-static uint16 Mode;
-static uint16 Control;
-static uint16 BaudRate;
-static uint32 DataBuffer;
-
-void SIO_Power(void)
+void PS_SIO::Power(void)
 {
  Status = 0;
  Mode = 0;
@@ -42,7 +36,7 @@ void SIO_Power(void)
  DataBuffer = 0;
 }
 
-uint32 SIO_Read(pscpu_timestamp_t timestamp, uint32 A)
+uint32 PS_SIO::Read(pscpu_timestamp_t timestamp, uint32 A)
 {
  uint32 ret = 0;
 
@@ -77,7 +71,7 @@ uint32 SIO_Read(pscpu_timestamp_t timestamp, uint32 A)
  return(ret >> ((A & 1) * 8));
 }
 
-void SIO_Write(pscpu_timestamp_t timestamp, uint32 A, uint32 V)
+void PS_SIO::Write(pscpu_timestamp_t timestamp, uint32 A, uint32 V)
 {
  V <<= (A & 1) * 8;
 
@@ -108,7 +102,7 @@ void SIO_Write(pscpu_timestamp_t timestamp, uint32 A, uint32 V)
 }
 
 
-void SIO_SyncState(bool isReader, EW::NewState *ns)
+void PS_SIO::SyncState(bool isReader, EW::NewState *ns)
 {
   NSS(Status);
   NSS(Mode);
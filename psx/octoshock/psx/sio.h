@@ -25,9 +25,26 @@
 namespace MDFN_IEN_PSX
 {
 
-void SIO_Write(pscpu_timestamp_t timestamp, uint32 A, uint32 V);
-uint32 SIO_Read(pscpu_timestamp_t timestamp, uint32 A);
-void SIO_Power(void);
+class PS_SIO
+{
+ public:
+
+ void SyncState(bool isReader, EW::NewState *ns);
+
+ void Write(pscpu_timestamp_t timestamp, uint32 A, uint32 V);
+ uint32 Read(pscpu_timestamp_t timestamp, uint32 A);
+ void Power(void);
+
+ private:
+
+ uint16 Status;
+ uint16 Mode;
+ uint16 Control;
+ uint16 BaudRate;
+ uint32 DataBuffer;
+};
+
+MDFN_HIDE extern EW_THREAD PS_SIO *SIO;
 
 }
 
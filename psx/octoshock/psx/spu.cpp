@@ -82,6 +82,11 @@
 #include "cdc.h"
 #include "spu.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+ #define SPU_RESAMP_SSE2 1
+ #include <emmintrin.h>
+#endif
+
 namespace MDFN_IEN_PSX
 {
 
@@ -94,6 +99,7 @@ PS_SPU::PS_SPU()
 {
  last_rate = -1;
  last_quality = ~0U;
+ SkipAudio = false;
 
  IntermediateBufferPos = 0;
  memset(IntermediateBuffer, 0, sizeof(IntermediateBuffer));
@@ -246,7 +252,7 @@ INLINE int16 SPU_Sweep::ReadVolume(void)
  return((int16)Current);
 }
 
-void SPU_Sweep::Clock(void)
+INLINE void SPU_Sweep::Clock(void)
 {
  if(!(Control & 0x8000))
  {
@@ -254,7 +260,12 @@ void SPU_Sweep::Clock(void)
   return;
  }
 
- if(Control & 0x8000) 	// Sweep enabled
+ RunSweep();
+}
+
+void SPU_Sweep::RunSweep(void)
+{
+ // Sweep enabled
  {
   const bool log_mode = (bool)(Control & 0x4000);
   const bool dec_mode = (bool)(Control & 0x2000);
@@ -329,7 +340,7 @@ void PS_SPU::RunDecoder(SPU_Voice *voice)
    {
     //SPUIRQ_DBG("SPU IRQ (VDA): 0x%06x", addr);
     IRQAsserted = true;
-    IRQ_Assert(IRQ_SPU, IRQAsserted);
+    IRQ->Assert(IRQ_SPU, IRQAsserted);
    }
   }
   return;
@@ -374,7 +385,7 @@ void PS_SPU::RunDecoder(SPU_Voice *voice)
    {
     //SPUIRQ_DBG("SPU IRQ: 0x%06x", addr);
     IRQAsserted = true;
-    IRQ_Assert(IRQ_SPU, IRQAsserted);
+    IRQ->Assert(IRQ_SPU, IRQAsserted);
    }
   }
 
@@ -561,7 +572,7 @@ INLINE void PS_SPU::CheckIRQAddr(uint32 addr)
   {
    //SPUIRQ_DBG("SPU IRQ (ALT): 0x%06x", addr);
    IRQAsserted = true;
-   IRQ_Assert(IRQ_SPU, IRQAsserted);
+   IRQ->Assert(IRQ_SPU, IRQAsserted);
   }
  }
 }
@@ -610,6 +621,8 @@ INLINE void PS_SPU::RunNoise(void)
 int32 PS_SPU::UpdateFromCDC(int32 clocks)
 //pscpu_timestamp_t PS_SPU::Update(const pscpu_timestamp_t timestamp)
 {
+ PSX_PROFILE(PSX_PROF_SPU);
+
  //int32 clocks = timestamp - lastts;
  int32 sample_clocks = 0;
  //lastts = timestamp;
@@ -686,9 +699,10 @@ int32 PS_SPU::UpdateFromCDC(int32 clocks)
    }
 
    //
-   // Decode new samples if necessary.
+   // Decode new samples if necessary.  (With enough buffered and the IRQ disabled, there's nothing for RunDecoder() to do.)
    //
-   RunDecoder(voice);
+   if(voice->DecodeAvail < 11 || (SPUControl & 0x40))
+    RunDecoder(voice);
 
 
    //
@@ -876,21 +890,24 @@ int32 PS_SPU::UpdateFromCDC(int32 clocks)
   
   RunReverb(accum_fv, reverb);
 
-  for(unsigned lr = 0; lr < 2; lr++)
-  {
-   accum[lr] += ((reverb[lr] * ReverbVol[lr]) >> 15);
-   clamp(&accum[lr], -32768, 32767);
-   output[lr] = (accum[lr] * GlobalSweep[lr].ReadVolume()) >> 15;
-   clamp(&output[lr], -32768, 32767);
-  }
-
-  if(IntermediateBufferPos < 4096)	// Overflow might occur in some debugger use cases.
+  if(!SkipAudio)
   {
-   // 75%, for some (resampling) headroom.
    for(unsigned lr = 0; lr < 2; lr++)
-    IntermediateBuffer[IntermediateBufferPos][lr] = (output[lr] * 3 + 2) >> 2;
+   {
+    accum[lr] += ((reverb[lr] * ReverbVol[lr]) >> 15);
+    clamp(&accum[lr], -32768, 32767);
+    output[lr] = (accum[lr] * GlobalSweep[lr].ReadVolume()) >> 15;
+    clamp(&output[lr], -32768, 32767);
+   }
+
+   if(IntermediateBufferPos < 4096)	// Overflow might occur in some debugger use cases.
+   {
+    // 75%, for some (resampling) headroom.
+    for(unsigned lr = 0; lr < 2; lr++)
+     IntermediateBuffer[IntermediateBufferPos][lr] = (output[lr] * 3 + 2) >> 2;
 
-   IntermediateBufferPos++;
+    IntermediateBufferPos++;
+   }
   }
 
   sample_clocks--;
@@ -937,6 +954,8 @@ uint32 PS_SPU::ReadDMA(void)
 
 void PS_SPU::Write(pscpu_timestamp_t timestamp, uint32 A, uint16 V)
 {
+ PSX_PROFILE(PSX_PROF_SPU);
+
  //if((A & 0x3FF) < 0x180)
  // PSX_WARNING("[SPU] Write: %08x %04x", A, V);
 
@@ -1093,7 +1112,7 @@ void PS_SPU::Write(pscpu_timestamp_t timestamp, uint32 A, uint16 V)
 	      if(!(V & 0x40))
 	      {
 	       IRQAsserted = false;
-	       IRQ_Assert(IRQ_SPU, IRQAsserted);
+	       IRQ->Assert(IRQ_SPU, IRQAsserted);
 	      }
 	      CheckIRQAddr(RWAddr);
 	      break;
@@ -1124,6 +1143,8 @@ void PS_SPU::Write(pscpu_timestamp_t timestamp, uint32 A, uint16 V)
 
 uint16 PS_SPU::Read(pscpu_timestamp_t timestamp, uint32 A)
 {
+ PSX_PROFILE(PSX_PROF_SPU);
+
  A &= 0x3FF;
 
  PSX_DBGINFO("[SPU] Read: %08x", A);
@@ -1193,8 +1214,10 @@ uint16 PS_SPU::Read(pscpu_timestamp_t timestamp, uint32 A)
 }
 
 
-void PS_SPU::StartFrame(double rate, uint32 quality)
+void PS_SPU::StartFrame(double rate, uint32 quality, bool skip_audio)
 {
+ SkipAudio = skip_audio;
+
  if((int)rate != last_rate || quality != last_quality)
  {
   int err = 0;
@@ -1296,7 +1319,7 @@ SYNCFUNC(PS_SPU)
 
 		RvbResPos &= 0x3F;
 
-		IRQ_Assert(IRQ_SPU, IRQAsserted);
+		IRQ->Assert(IRQ_SPU, IRQAsserted);
 	}
 }
 
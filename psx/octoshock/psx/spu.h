@@ -72,6 +72,8 @@ class SPU_Sweep
  void Clock(void);
 
  private:
+ void RunSweep(void);
+
  uint16 Control;
  uint16 Current;	// We typecast it to (int16) in several places, but keep it here as (uint16) to prevent signed overflow/underflow, which compilers
 			// may not treat consistently.
@@ -129,7 +131,7 @@ class PS_SPU
  void WriteDMA(uint32 V);
  uint32 ReadDMA(void);
 
- void StartFrame(double rate, uint32 quality);
+ void StartFrame(double rate, uint32 quality, bool skip_audio = false);
  int32 EndFrame(int16 *SoundBuf);
 
  int32 UpdateFromCDC(int32 clocks);
@@ -255,6 +257,9 @@ void RunReverb(const int32* in, int32* out);
  int last_rate;
  uint32 last_quality;
 
+ // Don't produce output samples this frame; everything else(reverb work area, capture buffers, envelopes, IRQs) is still run.
+ bool SkipAudio;
+
  // Buffers 44.1KHz samples, should have enough for two(worst-case scenario) video frames(2* ~735 frames NTSC, 2* ~882 PAL) plus jitter plus enough for the resampler leftovers.
  // We'll just go with 4096 because powers of 2 are AWESOME and such.
  uint32 IntermediateBufferPos;
@@ -80,30 +80,13 @@
 /*
  FIXME: Clock appropriately(and update events) when using SetRegister() via the debugger.
 
- TODO: If we ever return randomish values to "simulate" open bus, remember to change the return type and such of the TIMER_Read() function to full 32-bit too.
+ TODO: If we ever return randomish values to "simulate" open bus, remember to change the return type and such of the Read() function to full 32-bit too.
 */
 
 namespace MDFN_IEN_PSX
 {
 
-struct Timer
-{
- uint32 Mode;
- uint32 Counter;	// Only 16-bit, but 32-bit here for detecting counting past target.
- uint32 Target;
-
- uint32 Div8Counter;
-
- bool IRQDone;
- int32 DoZeCounting;
-};
-
-static bool vblank;
-static bool hretrace;
-static Timer Timers[3];
-static pscpu_timestamp_t lastts;
-
-static uint32 CalcNextEvent(void)
+uint32 PS_TIMER::CalcNextEvent(void)
 {
  uint32 next_event = 1024;	//
 
@@ -148,7 +131,7 @@ static uint32 CalcNextEvent(void)
  return(next_event);
 }
 
-static MDFN_FASTCALL bool TimerMatch(unsigned i)
+MDFN_FASTCALL bool PS_TIMER::TimerMatch(unsigned i)
 {
  bool irq_exact = false;
 
@@ -172,14 +155,14 @@ static MDFN_FASTCALL bool TimerMatch(unsigned i)
 #endif
 
   Timers[i].IRQDone = true;
-  IRQ_Assert(IRQ_TIMER_0 + i, true);
-  IRQ_Assert(IRQ_TIMER_0 + i, false);
+  IRQ->Assert(IRQ_TIMER_0 + i, true);
+  IRQ->Assert(IRQ_TIMER_0 + i, false);
  }
 
  return irq_exact;
 }
 
-static MDFN_FASTCALL bool TimerOverflow(unsigned i)
+MDFN_FASTCALL bool PS_TIMER::TimerOverflow(unsigned i)
 {
  bool irq_exact = false;
 
@@ -197,14 +180,14 @@ static MDFN_FASTCALL bool TimerOverflow(unsigned i)
 #endif
 
   Timers[i].IRQDone = true;
-  IRQ_Assert(IRQ_TIMER_0 + i, true);
-  IRQ_Assert(IRQ_TIMER_0 + i, false);
+  IRQ->Assert(IRQ_TIMER_0 + i, true);
+  IRQ->Assert(IRQ_TIMER_0 + i, false);
  }
 
  return irq_exact;
 }
 
-static MDFN_FASTCALL void ClockTimer(int i, uint32 clocks)
+MDFN_FASTCALL void PS_TIMER::ClockTimer(int i, uint32 clocks)
 {
  if(Timers[i].DoZeCounting <= 0)
   clocks = 0;
@@ -255,7 +238,7 @@ static MDFN_FASTCALL void ClockTimer(int i, uint32 clocks)
  }
 }
 
-MDFN_FASTCALL void TIMER_SetVBlank(bool status)
+MDFN_FASTCALL void PS_TIMER::SetVBlank(bool status)
 {
  switch(Timers[1].Mode & 0x7)
  {
@@ -298,7 +281,7 @@ MDFN_FASTCALL void TIMER_SetVBlank(bool status)
  vblank = status;
 }
 
-MDFN_FASTCALL void TIMER_SetHRetrace(bool status)
+MDFN_FASTCALL void PS_TIMER::SetHRetrace(bool status)
 {
  if(hretrace && !status)
  {
@@ -314,19 +297,19 @@ MDFN_FASTCALL void TIMER_SetHRetrace(bool status)
  hretrace = status;
 }
 
-MDFN_FASTCALL void TIMER_AddDotClocks(uint32 count)
+MDFN_FASTCALL void PS_TIMER::AddDotClocks(uint32 count)
 {
  if(Timers[0].Mode & 0x100)
   ClockTimer(0, count);
 }
 
-void TIMER_ClockHRetrace(void)
+void PS_TIMER::ClockHRetrace(void)
 {
  if(Timers[1].Mode & 0x100)
   ClockTimer(1, 1);
 }
 
-MDFN_FASTCALL pscpu_timestamp_t TIMER_Update(const pscpu_timestamp_t timestamp)
+MDFN_FASTCALL pscpu_timestamp_t PS_TIMER::Update(const pscpu_timestamp_t timestamp)
 {
  int32 cpu_clocks = timestamp - lastts;
 
@@ -345,7 +328,7 @@ MDFN_FASTCALL pscpu_timestamp_t TIMER_Update(const pscpu_timestamp_t timestamp)
  return(timestamp + CalcNextEvent());
 }
 
-static MDFN_FASTCALL void CalcCountingStart(unsigned which)
+MDFN_FASTCALL void PS_TIMER::CalcCountingStart(unsigned which)
 {
  Timers[which].DoZeCounting = true;
 
@@ -372,9 +355,9 @@ static MDFN_FASTCALL void CalcCountingStart(unsigned which)
  }
 }
 
-MDFN_FASTCALL void TIMER_Write(const pscpu_timestamp_t timestamp, uint32 A, uint16 V)
+MDFN_FASTCALL void PS_TIMER::Write(const pscpu_timestamp_t timestamp, uint32 A, uint16 V)
 {
- TIMER_Update(timestamp);
+ Update(timestamp);
 
  int which = (A >> 4) & 0x3;
 
@@ -411,7 +394,7 @@ MDFN_FASTCALL void TIMER_Write(const pscpu_timestamp_t timestamp, uint32 A, uint
  PSX_SetEventNT(PSX_EVENT_TIMER, timestamp + CalcNextEvent());
 }
 
-MDFN_FASTCALL uint16 TIMER_Read(const pscpu_timestamp_t timestamp, uint32 A)
+MDFN_FASTCALL uint16 PS_TIMER::Read(const pscpu_timestamp_t timestamp, uint32 A)
 {
  uint16 ret = 0;
  int which = (A >> 4) & 0x3;
@@ -423,7 +406,7 @@ MDFN_FASTCALL uint16 TIMER_Read(const pscpu_timestamp_t timestamp, uint32 A)
   return(ret >> ((A & 3) * 8));
  }
 
- TIMER_Update(timestamp);
+ Update(timestamp);
 
  switch(A & 0xC)
  {
@@ -447,13 +430,13 @@ MDFN_FASTCALL uint16 TIMER_Read(const pscpu_timestamp_t timestamp, uint32 A)
 }
 
 
-void TIMER_ResetTS(void)
+void PS_TIMER::ResetTS(void)
 {
  lastts = 0;
 }
 
 
-void TIMER_Power(void)
+void PS_TIMER::Power(void)
 {
  lastts = 0;
 
@@ -462,14 +445,14 @@ void TIMER_Power(void)
  memset(Timers, 0, sizeof(Timers));
 }
 
-void TIMER_SyncState(bool isReader, EW::NewState *ns)
+void PS_TIMER::SyncState(bool isReader, EW::NewState *ns)
 {
 	NSS(Timers);
   NSS(vblank);
   NSS(hretrace);
 }
 
-uint32 TIMER_GetRegister(unsigned int which, char *special, const uint32 special_len)
+uint32 PS_TIMER::GetRegister(unsigned int which, char *special, const uint32 special_len)
 {
  int tw = (which >> 4) & 0x3;
  uint32 ret = 0;
@@ -492,7 +475,7 @@ uint32 TIMER_GetRegister(unsigned int which, char *special, const uint32 special
  return(ret);
 }
 
-void TIMER_SetRegister(unsigned int which, uint32 value)
+void PS_TIMER::SetRegister(unsigned int which, uint32 value)
 {
  int tw = (which >> 4) & 0x3;
 
@@ -40,22 +40,56 @@ enum
  TIMER_GSREG_TARGET2,
 };
 
-uint32 TIMER_GetRegister(unsigned int which, char *special, const uint32 special_len);
-void TIMER_SetRegister(unsigned int which, uint32 value);
+class PS_TIMER
+{
+ public:
+
+ void SyncState(bool isReader, EW::NewState *ns);
+
+ uint32 GetRegister(unsigned int which, char *special, const uint32 special_len);
+ void SetRegister(unsigned int which, uint32 value);
+
+
+ MDFN_FASTCALL void Write(const pscpu_timestamp_t timestamp, uint32 A, uint16 V);
+ MDFN_FASTCALL uint16 Read(const pscpu_timestamp_t timestamp, uint32 A);
+
+ MDFN_FASTCALL void AddDotClocks(uint32 count);
+ void ClockHRetrace(void);
+ MDFN_FASTCALL void SetHRetrace(bool status);
+ MDFN_FASTCALL void SetVBlank(bool status);
 
+ MDFN_FASTCALL pscpu_timestamp_t Update(const pscpu_timestamp_t);
+ void ResetTS(void);
 
-MDFN_FASTCALL void TIMER_Write(const pscpu_timestamp_t timestamp, uint32 A, uint16 V);
-MDFN_FASTCALL uint16 TIMER_Read(const pscpu_timestamp_t timestamp, uint32 A);
+ void Power(void) MDFN_COLD;
 
-MDFN_FASTCALL void TIMER_AddDotClocks(uint32 count);
-void TIMER_ClockHRetrace(void);
-MDFN_FASTCALL void TIMER_SetHRetrace(bool status);
-MDFN_FASTCALL void TIMER_SetVBlank(bool status);
+ private:
 
-MDFN_FASTCALL pscpu_timestamp_t TIMER_Update(const pscpu_timestamp_t);
-void TIMER_ResetTS(void);
+ struct Timer
+ {
+  uint32 Mode;
+  uint32 Counter;	// Only 16-bit, but 32-bit here for detecting counting past target.
+  uint32 Target;
+
+  uint32 Div8Counter;
+
+  bool IRQDone;
+  int32 DoZeCounting;
+ };
+
+ uint32 CalcNextEvent(void);
+ MDFN_FASTCALL bool TimerMatch(unsigned i);
+ MDFN_FASTCALL bool TimerOverflow(unsigned i);
+ MDFN_FASTCALL void ClockTimer(int i, uint32 clocks);
+ MDFN_FASTCALL void CalcCountingStart(unsigned which);
+
+ bool vblank;
+ bool hretrace;
+ Timer Timers[3];
+ pscpu_timestamp_t lastts;
+};
 
-void TIMER_Power(void) MDFN_COLD;
+MDFN_HIDE extern EW_THREAD PS_TIMER *TIMER;
 
 }
 
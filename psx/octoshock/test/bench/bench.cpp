@@ -0,0 +1,448 @@
+//octobench: a headless octoshock benchmark and regression gate.
+//It runs a BIOS plus a disc image or PS-EXE for some number of frames, optionally replaying an input log,
+//then reports frames/sec and (when built with WANT_PSX_PROFILE, as the Makefile does by default) the time spent in each subsystem.
+//With -hashes, it writes a hash of the video, audio and savestate of every frame, so two builds can be compared with diff.
+//
+//usage: octobench <bios> <disc.bin|program.exe> [options]
+//  -frames N      frames to run (default: the length of the input log, or 600 without one)
+//  -input FILE    input log for a DualShock in port 1, one line per frame: "<buttons, hex> [lx ly rx ry]".
+//                 blank lines and lines starting with # are skipped. the last line is held if the log runs out
+//  -hashes FILE   write "<frame> <video> <audio> <state>" hashes for every frame to FILE ("-" for stdout)
+//  -nostate       leave the (slow) savestate hash out of -hashes
+//  -instances N   run N copies at once, each on a thread of its own, and check that they all hashed the same
+//  -renderthreads N  draw untextured triangles on N render threads. with -instances, instance 0 still draws on its own
+//                 thread, so the hash check compares the threaded renderer against the plain one
+//
+//the disc image must be a single data track of raw 2352 byte sectors (a .bin without a .cue), like the miniclient takes
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "octoshock.h"
+#include "psx/psx.h"
+#include "cdrom/CDUtility.h"
+
+class BinReader2352
+{
+public:
+	BinReader2352(FILE* inf)
+		: inf(inf)
+	{
+		fseek(inf,0,SEEK_END);
+		lbaCount = (s32)(ftell(inf)/2352);
+		fseek(inf,0,SEEK_SET);
+
+		shock_CreateDisc(&disc,this,lbaCount,s_ReadTOC,s_ReadLBA2448,false);
+	}
+
+	~BinReader2352()
+	{
+		shock_DestroyDisc(disc);
+		fclose(inf);
+	}
+
+	ShockDiscRef* disc;
+
+private:
+	FILE* inf;
+	s32 lbaCount;
+
+	static s32 s_ReadTOC(void* opaque, ShockTOC *read_target, ShockTOCTrack tracks[100 + 1]) { return ((BinReader2352*)opaque)->ReadTOC(read_target, tracks); }
+	static s32 s_ReadLBA2448(void* opaque, s32 lba, void* dst) { return ((BinReader2352*)opaque)->ReadLBA2448(lba,dst); }
+
+	s32 ReadTOC(ShockTOC *read_target, ShockTOCTrack tracks[100 + 1])
+	{
+		memset(read_target,0,sizeof(*read_target));
+		read_target->disc_type = 0;
+		read_target->first_track = 1;
+		read_target->last_track = 1;
+		tracks[1].adr = 1;
+		tracks[1].lba = 0;
+		tracks[1].control = 4;
+		tracks[2].adr = 1;
+		tracks[2].lba = lbaCount;
+		tracks[2].control = 0;
+		tracks[100].adr = 1;
+		tracks[100].lba = lbaCount;
+		tracks[100].control = 0;
+		return SHOCK_OK;
+	}
+
+	s32 ReadLBA2448(s32 lba, void* dst)
+	{
+		u8* sector = (u8*)dst;
+
+		memset(sector,0,2352);
+		if(lba >= 0 && lba < lbaCount)
+		{
+			fseek(inf,(long)lba*2352,SEEK_SET);
+			if(fread(sector,1,2352,inf) != 2352)
+				return SHOCK_ERROR;
+		}
+
+		//synthesize the Q subchannel (position data) for track 1; the rest of the subcode is empty
+		u8 q[0xC];
+		u8 m, s, f;
+		memset(q,0,sizeof(q));
+		q[0] = 0x01 | (0x04 << 4);
+		q[1] = CDUtility::U8_to_BCD(1);
+		q[2] = CDUtility::U8_to_BCD(1);
+		CDUtility::LBA_to_AMSF(lba - 150, &m, &s, &f); //track relative, track 1 starts at lba 0
+		q[3] = CDUtility::U8_to_BCD(m);
+		q[4] = CDUtility::U8_to_BCD(s);
+		q[5] = CDUtility::U8_to_BCD(f);
+		CDUtility::LBA_to_AMSF(lba, &m, &s, &f);
+		q[7] = CDUtility::U8_to_BCD(m);
+		q[8] = CDUtility::U8_to_BCD(s);
+		q[9] = CDUtility::U8_to_BCD(f);
+		CDUtility::subq_generate_checksum(q);
+
+		u8* pw = sector + 2352;
+		for(int i = 0; i < 96; i++)
+			pw[i] = ((q[i >> 3] >> (7 - (i & 0x7))) & 1) ? 0x40 : 0x00;
+
+		return SHOCK_OK;
+	}
+};
+
+struct InputFrame
+{
+	u32 buttons;
+	u8 lx, ly, rx, ry;
+};
+
+static bool LoadInputLog(const char* path, std::vector<InputFrame>& log)
+{
+	FILE* inf = fopen(path,"r");
+	if(!inf)
+		return false;
+
+	char line[256];
+	while(fgets(line,sizeof(line),inf))
+	{
+		if(line[0] == '#' || line[0] == '\n' || line[0] == '\r' || line[0] == 0)
+			continue;
+
+		InputFrame frame;
+		unsigned buttons, lx = 128, ly = 128, rx = 128, ry = 128;
+		if(sscanf(line,"%x %u %u %u %u",&buttons,&lx,&ly,&rx,&ry) < 1)
+			continue;
+		frame.buttons = buttons;
+		frame.lx = lx; frame.ly = ly; frame.rx = rx; frame.ry = ry;
+		log.push_back(frame);
+	}
+
+	fclose(inf);
+	return true;
+}
+
+static std::vector<u8> LoadFile(const char* path)
+{
+	std::vector<u8> ret;
+	FILE* inf = fopen(path,"rb");
+	if(!inf)
+		return ret;
+	fseek(inf,0,SEEK_END);
+	ret.resize(ftell(inf));
+	fseek(inf,0,SEEK_SET);
+	if(fread(ret.data(),1,ret.size(),inf) != ret.size())
+		ret.clear();
+	fclose(inf);
+	return ret;
+}
+
+//64bit FNV-1a
+static u64 Hash(u64 h, const void* data, size_t len)
+{
+	const u8* p = (const u8*)data;
+	for(size_t i = 0; i < len; i++)
+		h = (h ^ p[i]) * 0x100000001B3ULL;
+	return h;
+}
+
+static const u64 kHashInit = 0xCBF29CE484222325ULL;
+
+//everything an instance needs to run, shared (read only) by all of them
+struct BenchConfig
+{
+	const char* contentpath;
+	std::vector<u8> firmware;
+	std::vector<u8> exe; //empty when running a disc image
+	s32 region;
+	int frames;
+	std::vector<InputFrame> inputLog;
+	bool wantHashes, hashState;
+	int renderThreads;
+};
+
+struct BenchResult
+{
+	double stepSeconds;
+	ShockProfile total;
+	bool haveProfile;
+	std::string hashes;
+	bool ok;
+};
+
+static void RunInstance(const BenchConfig& cfg, int renderThreads, BenchResult& res)
+{
+	res.stepSeconds = 0;
+	memset(&res.total,0,sizeof(res.total));
+	res.haveProfile = true;
+	res.ok = false;
+
+	//each instance reads the disc through its own file handle
+	BinReader2352* bin = NULL;
+	if(cfg.exe.empty())
+	{
+		FILE* inf = fopen(cfg.contentpath,"rb");
+		if(!inf)
+			return;
+		bin = new BinReader2352(inf);
+	}
+
+	void* psx = NULL;
+
+	ShockRenderOptions renderOpts;
+	memset(&renderOpts,0,sizeof(renderOpts));
+	renderOpts.deinterlaceMode = eShockDeinterlaceMode_Weave;
+	renderOpts.renderType = eShockRenderType_Normal;
+	renderOpts.scanline_start = 0;
+	renderOpts.scanline_end = cfg.region == REGION_EU ? 287 : 239;
+	renderOpts.skip = false;
+	renderOpts.renderThreads = renderThreads;
+
+	if(shock_Create(&psx, cfg.region, (void*)cfg.firmware.data()) != SHOCK_OK)
+	{
+		delete bin;
+		return;
+	}
+	if(bin)
+	{
+		shock_OpenTray(psx);
+		shock_SetDisc(psx,bin->disc);
+		shock_CloseTray(psx);
+	}
+	else
+	{
+		shock_MountEXE(psx,(void*)cfg.exe.data(),(s32)cfg.exe.size(),false);
+		shock_CloseTray(psx);
+	}
+	shock_SetRenderOptions(psx, &renderOpts);
+	shock_Peripheral_Connect(psx,0x01,ePeripheralType_DualShock);
+	shock_PowerOn(psx);
+
+	ShockStateTransaction stateTransaction;
+	memset(&stateTransaction,0,sizeof(stateTransaction));
+	stateTransaction.transaction = eShockStateTransaction_BinarySize;
+	const s32 stateSize = shock_StateTransaction(psx,&stateTransaction);
+	std::vector<u8> state(stateSize > 0 ? stateSize : 0);
+	std::vector<s16> samples;
+
+	ShockProfile profile;
+	shock_GetProfile(psx,&profile); //discard whatever powering on did
+
+	for(int frame = 0; frame < cfg.frames; frame++)
+	{
+		if(!cfg.inputLog.empty())
+		{
+			const InputFrame& in = cfg.inputLog[frame < (int)cfg.inputLog.size() ? frame : cfg.inputLog.size() - 1];
+			shock_Peripheral_SetPadInput(psx,0x01,in.buttons,in.lx,in.ly,in.rx,in.ry);
+		}
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		shock_Step(psx,eShockStep_Frame);
+		res.stepSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		if(shock_GetProfile(psx,&profile) == SHOCK_OK)
+		{
+			res.total.cpu += profile.cpu;
+			res.total.gpu += profile.gpu;
+			res.total.spu += profile.spu;
+			res.total.cdc += profile.cdc;
+			res.total.mdec += profile.mdec;
+		}
+		else res.haveProfile = false;
+
+		//the samples have to be fetched every frame either way
+		samples.resize(shock_GetSamples(psx,NULL) * 2);
+		shock_GetSamples(psx,samples.data());
+
+		if(cfg.wantHashes)
+		{
+			ShockFramebufferView fb;
+			fb.flags = eShockFramebufferFlags_None;
+			shock_GetFramebufferView(psx,&fb);
+			u64 videoHash = kHashInit;
+			for(int y = 0; y < fb.height; y++)
+				videoHash = Hash(videoHash, fb.pixels + (fb.y + y) * fb.pitch + fb.x, fb.width * 4);
+			videoHash = Hash(videoHash, &fb.width, sizeof(fb.width));
+			videoHash = Hash(videoHash, &fb.height, sizeof(fb.height));
+
+			u64 audioHash = Hash(kHashInit, samples.data(), samples.size() * sizeof(s16));
+
+			u64 stateHash = 0;
+			if(cfg.hashState && !state.empty())
+			{
+				stateTransaction.transaction = eShockStateTransaction_BinarySave;
+				stateTransaction.buffer = state.data();
+				stateTransaction.bufferLength = (s32)state.size();
+				shock_StateTransaction(psx,&stateTransaction);
+				stateHash = Hash(kHashInit, state.data(), state.size());
+			}
+
+			char line[80];
+			snprintf(line,sizeof(line),"%d %016llx %016llx %016llx\n",frame,(unsigned long long)videoHash,(unsigned long long)audioHash,(unsigned long long)stateHash);
+			res.hashes += line;
+		}
+	}
+
+	shock_Destroy(psx);
+	delete bin;
+	res.ok = true;
+}
+
+int main(int argc, char **argv)
+{
+	if(argc < 3)
+	{
+		fprintf(stderr,"usage: %s <bios> <disc.bin|program.exe> [-frames N] [-input FILE] [-hashes FILE] [-nostate] [-instances N] [-renderthreads N]\n",argv[0]);
+		return 1;
+	}
+
+	BenchConfig cfg;
+	const char* fwpath = argv[1];
+	cfg.contentpath = argv[2];
+	cfg.frames = -1;
+	cfg.hashState = true;
+	cfg.renderThreads = 0;
+	const char* inputpath = NULL;
+	const char* hashpath = NULL;
+	int instances = 1;
+
+	for(int i = 3; i < argc; i++)
+	{
+		if(!strcmp(argv[i],"-frames") && i+1 < argc) cfg.frames = atoi(argv[++i]);
+		else if(!strcmp(argv[i],"-input") && i+1 < argc) inputpath = argv[++i];
+		else if(!strcmp(argv[i],"-hashes") && i+1 < argc) hashpath = argv[++i];
+		else if(!strcmp(argv[i],"-nostate")) cfg.hashState = false;
+		else if(!strcmp(argv[i],"-instances") && i+1 < argc) instances = atoi(argv[++i]);
+		else if(!strcmp(argv[i],"-renderthreads") && i+1 < argc) cfg.renderThreads = atoi(argv[++i]);
+		else
+		{
+			fprintf(stderr,"unknown option: %s\n",argv[i]);
+			return 1;
+		}
+	}
+	if(instances < 1)
+		instances = 1;
+
+	cfg.firmware = LoadFile(fwpath);
+	if(cfg.firmware.size() != 512*1024)
+	{
+		fprintf(stderr,"couldn't load a 512KB bios from %s\n",fwpath);
+		return 1;
+	}
+
+	if(inputpath && !LoadInputLog(inputpath,cfg.inputLog))
+	{
+		fprintf(stderr,"couldn't open input log %s\n",inputpath);
+		return 1;
+	}
+	if(cfg.frames < 0)
+		cfg.frames = cfg.inputLog.empty() ? 600 : (int)cfg.inputLog.size();
+
+	FILE* hashout = NULL;
+	if(hashpath)
+	{
+		hashout = strcmp(hashpath,"-") ? fopen(hashpath,"w") : stdout;
+		if(!hashout)
+		{
+			fprintf(stderr,"couldn't open %s for writing\n",hashpath);
+			return 1;
+		}
+	}
+	//with several instances the hashes are needed to check them against each other
+	cfg.wantHashes = hashout || instances > 1;
+
+	//a PS-EXE is recognized by its header; anything else is taken to be a disc image
+	cfg.region = REGION_NA;
+	{
+		FILE* inf = fopen(cfg.contentpath,"rb");
+		if(!inf)
+		{
+			fprintf(stderr,"couldn't open %s\n",cfg.contentpath);
+			return 1;
+		}
+		char magic[8] = {0};
+		if(fread(magic,1,8,inf) == 8 && !memcmp(magic,"PS-X EXE",8))
+		{
+			fclose(inf);
+			cfg.exe = LoadFile(cfg.contentpath);
+		}
+		else
+		{
+			BinReader2352 bin(inf);
+			ShockDiscInfo info;
+			shock_AnalyzeDisc(bin.disc, &info);
+			if(info.region != REGION_NONE)
+				cfg.region = info.region;
+			printf("disc id: %s\n",info.id);
+		}
+	}
+
+	//the first instance runs right here; when there are others to check it against, it's the one that draws without render threads
+	std::vector<BenchResult> results(instances);
+	std::vector<std::thread> threads;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for(int i = 1; i < instances; i++)
+		threads.emplace_back(RunInstance, std::cref(cfg), cfg.renderThreads, std::ref(results[i]));
+	RunInstance(cfg, instances > 1 ? 0 : cfg.renderThreads, results[0]);
+	for(auto& thread : threads)
+		thread.join();
+	const double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	int ret = 0;
+	for(int i = 0; i < instances; i++)
+	{
+		if(!results[i].ok)
+		{
+			fprintf(stderr,"instance %d couldn't be created\n",i);
+			ret = 1;
+		}
+		else if(results[i].hashes != results[0].hashes)
+		{
+			fprintf(stderr,"instance %d didn't hash the same as instance 0\n",i);
+			ret = 1;
+		}
+	}
+
+	const BenchResult& res = results[0];
+	printf("frames: %d  time: %.3fs  fps: %.1f\n", cfg.frames, res.stepSeconds, res.stepSeconds > 0 ? cfg.frames / res.stepSeconds : 0.0);
+	if(instances > 1)
+		printf("instances: %d  wall time: %.3fs  total fps: %.1f\n", instances, wallSeconds, wallSeconds > 0 ? cfg.frames * instances / wallSeconds : 0.0);
+	if(res.haveProfile)
+	{
+		const u64 sum = res.total.cpu + res.total.gpu + res.total.spu + res.total.cdc + res.total.mdec;
+		const struct { const char* name; u64 ns; } rows[] = {
+			{ "cpu", res.total.cpu }, { "gpu", res.total.gpu }, { "spu", res.total.spu }, { "cdc", res.total.cdc }, { "mdec", res.total.mdec }
+		};
+		for(const auto& row : rows)
+			printf("  %-5s %9.3fms  %5.1f%%\n", row.name, row.ns / 1e6, sum ? row.ns * 100.0 / sum : 0.0);
+	}
+	else printf("  (no per-subsystem times; build with WANT_PSX_PROFILE)\n");
+
+	if(hashout)
+	{
+		fputs(res.hashes.c_str(), hashout);
+		if(hashout != stdout)
+			fclose(hashout);
+	}
+
+	return ret;
+}
@@ -312,6 +312,7 @@ int main(int argc, char **argv)
 	renderOpts.scanline_start = 0;
 	renderOpts.scanline_end = 239;
 	renderOpts.skip = false;
+	renderOpts.renderThreads = 0;
 
 
 	shock_Create(&psx, REGION_NA, firmware);
@@ -20,6 +20,13 @@
 
 #include "Deinterlacer.h"
 
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DEINT_SSE2 1
+#include <emmintrin.h>
+#endif
+
 Deinterlacer::Deinterlacer() : FieldBuffer(NULL), StateValid(false), DeintType(DEINT_WEAVE)
 {
  PrevDRect.x = 0;
@@ -54,6 +61,34 @@ void Deinterlacer::SetType(unsigned dt)
  }
 }
 
+//
+// Per-channel average, rounding up(same as PAVGB), of two lines of 32bpp pixels.
+//
+static INLINE void BlendLine(uint32* dest, const uint32* a, const uint32* b, int32 count)
+{
+ int32 x = 0;
+
+#ifdef DEINT_SSE2
+ for(; (x + 4) <= count; x += 4)
+ {
+  const __m128i pa = _mm_loadu_si128((const __m128i*)(a + x));
+  const __m128i pb = _mm_loadu_si128((const __m128i*)(b + x));
+
+  _mm_storeu_si128((__m128i*)(dest + x), _mm_avg_epu8(pa, pb));
+ }
+#endif
+
+ for(; x < count; x++)
+  dest[x] = (a[x] | b[x]) - (((a[x] ^ b[x]) & 0xFEFEFEFE) >> 1);
+}
+
+// Paletted and 16bpp surfaces don't have channels that can be averaged bytewise; blend degrades to bob there.
+template<typename T>
+static INLINE void BlendLine(T* dest, const T* a, const T* b, int32 count)
+{
+ memcpy(dest, a, count * sizeof(T));
+}
+
 template<typename T>
 void Deinterlacer::InternalProcess(MDFN_Surface *surface, MDFN_Rect &DisplayRect, int32 *LineWidths, const bool field)
 {
@@ -63,6 +98,7 @@ void Deinterlacer::InternalProcess(MDFN_Surface *surface, MDFN_Rect &DisplayRect
  // [...]
  const bool LineWidths_In_Valid = (LineWidths[0] != ~0);
  const bool WeaveGood = (StateValid && PrevDRect.h == DisplayRect.h && DeintType == DEINT_WEAVE);
+ const bool BlendGood = (StateValid && PrevDRect.h == DisplayRect.h && PrevDRect.x == DisplayRect.x && DeintType == DEINT_BLEND);
  //
  // XReposition stuff is to prevent exceeding the dimensions of the video surface under certain conditions(weave deinterlacer, previous field has higher
  // horizontal resolution than current field, and current field's rectangle has an x offset that's too large when taking into consideration the previous field's
@@ -95,6 +131,8 @@ void Deinterlacer::InternalProcess(MDFN_Surface *surface, MDFN_Rect &DisplayRect
 	    LineWidths[(y * 2) + field + DisplayRect.y] * sizeof(T));
   }
 
+  bool Blended = false;
+
   if(WeaveGood)
   {
    const T* src = FieldBuffer->pix<T>() + y * FieldBuffer->pitchinpix;
@@ -105,7 +143,18 @@ void Deinterlacer::InternalProcess(MDFN_Surface *surface, MDFN_Rect &DisplayRect
 
    memcpy(dest, src, LWBuffer[y] * sizeof(T));
   }
-  else if(DeintType == DEINT_BOB)
+  else if(BlendGood && LWBuffer[y] == LineWidths[(y * 2) + field + DisplayRect.y])
+  {
+   const T* src = surface->pix<T>() + ((y * 2) + field + DisplayRect.y) * surface->pitchinpix + DisplayRect.x;
+   const T* prev = FieldBuffer->pix<T>() + y * FieldBuffer->pitchinpix;
+   T* dest = surface->pix<T>() + ((y * 2) + (field ^ 1) + DisplayRect.y) * surface->pitchinpix + DisplayRect.x;
+
+   LineWidths[(y * 2) + (field ^ 1) + DisplayRect.y] = LWBuffer[y];
+
+   BlendLine(dest, src, prev, LWBuffer[y]);
+   Blended = true;
+  }
+  else if(DeintType == DEINT_BOB || DeintType == DEINT_BLEND)
   {
    const T* src = surface->pix<T>() + ((y * 2) + field + DisplayRect.y) * surface->pitchinpix + DisplayRect.x;
    T* dest = surface->pix<T>() + ((y * 2) + (field ^ 1) + DisplayRect.y) * surface->pitchinpix + DisplayRect.x;
@@ -147,7 +196,7 @@ void Deinterlacer::InternalProcess(MDFN_Surface *surface, MDFN_Rect &DisplayRect
   //
   //
   //
-  if(DeintType == DEINT_WEAVE)
+  if(DeintType == DEINT_WEAVE || DeintType == DEINT_BLEND)
   {
    const int32 *src_lw = &LineWidths[(y * 2) + field + DisplayRect.y];
    const T* src = surface->pix<T>() + ((y * 2) + field + DisplayRect.y) * surface->pitchinpix + DisplayRect.x;
@@ -158,6 +207,15 @@ void Deinterlacer::InternalProcess(MDFN_Surface *surface, MDFN_Rect &DisplayRect
 
    StateValid = true;
   }
+
+  // Now that the current field's line is saved, it can take the blended result too.
+  if(Blended)
+  {
+   const T* src = surface->pix<T>() + ((y * 2) + (field ^ 1) + DisplayRect.y) * surface->pitchinpix + DisplayRect.x;
+   T* dest = surface->pix<T>() + ((y * 2) + field + DisplayRect.y) * surface->pitchinpix + DisplayRect.x;
+
+   memcpy(dest, src, LWBuffer[y] * sizeof(T));
+  }
  }
 }
 
@@ -165,7 +223,7 @@ void Deinterlacer::Process(MDFN_Surface *surface, MDFN_Rect &DisplayRect, int32
 {
  const MDFN_Rect DisplayRect_Original = DisplayRect;
 
- if(DeintType == DEINT_WEAVE)
+ if(DeintType == DEINT_WEAVE || DeintType == DEINT_BLEND)
  {
   if(!FieldBuffer || FieldBuffer->w < surface->w || FieldBuffer->h < (surface->h / 2))
   {
@@ -32,6 +32,7 @@ class Deinterlacer
   DEINT_BOB_OFFSET = 0,	// Code will fall-through to this case under certain conditions, too.
   DEINT_BOB,
   DEINT_WEAVE,
+  DEINT_BLEND,		// Each line pair is the average of this field and the previous one; one field of latency, no combing.
  };
 
  void SetType(unsigned t);
@@ -61,6 +61,7 @@
 			this.rbWeave = new System.Windows.Forms.RadioButton();
 			this.rbBobOffset = new System.Windows.Forms.RadioButton();
 			this.rbBob = new System.Windows.Forms.RadioButton();
+			this.rbBlend = new System.Windows.Forms.RadioButton();
 			this.groupBox4 = new System.Windows.Forms.GroupBox();
 			this.groupBox5 = new System.Windows.Forms.GroupBox();
 			this.cbLEC = new System.Windows.Forms.CheckBox();
@@ -418,14 +419,27 @@
 			this.toolTip1.SetToolTip(this.rbBob, "Good for causing a headache. All glory to Bob.");
 			this.rbBob.UseVisualStyleBackColor = true;
 			// 
+			// rbBlend
+			// 
+			this.rbBlend.AutoSize = true;
+			this.rbBlend.Location = new System.Drawing.Point(6, 42);
+			this.rbBlend.Name = "rbBlend";
+			this.rbBlend.Size = new System.Drawing.Size(52, 17);
+			this.rbBlend.TabIndex = 49;
+			this.rbBlend.TabStop = true;
+			this.rbBlend.Text = "Blend";
+			this.toolTip1.SetToolTip(this.rbBlend, "Averages each field with the previous one: no combing or flicker, but motion is a bit blurred.");
+			this.rbBlend.UseVisualStyleBackColor = true;
+			// 
 			// groupBox4
 			// 
 			this.groupBox4.Controls.Add(this.rbWeave);
 			this.groupBox4.Controls.Add(this.rbBobOffset);
 			this.groupBox4.Controls.Add(this.rbBob);
+			this.groupBox4.Controls.Add(this.rbBlend);
 			this.groupBox4.Location = new System.Drawing.Point(492, 251);
 			this.groupBox4.Name = "groupBox4";
-			this.groupBox4.Size = new System.Drawing.Size(212, 49);
+			this.groupBox4.Size = new System.Drawing.Size(212, 68);
 			this.groupBox4.TabIndex = 50;
 			this.groupBox4.TabStop = false;
 			this.groupBox4.Text = "Deinterlacing";
@@ -469,7 +483,7 @@
 			this.groupBox6.Controls.Add(this.cbGpuLag);
 			this.groupBox6.Location = new System.Drawing.Point(264, 308);
 			this.groupBox6.Name = "groupBox6";
-			this.groupBox6.Size = new System.Drawing.Size(238, 85);
+			this.groupBox6.Size = new System.Drawing.Size(222, 85);
 			this.groupBox6.TabIndex = 48;
 			this.groupBox6.TabStop = false;
 			this.groupBox6.Text = "Emulation User Settings";
@@ -547,6 +561,7 @@
 		private System.Windows.Forms.RadioButton rbWeave;
 		private System.Windows.Forms.RadioButton rbBobOffset;
 		private System.Windows.Forms.RadioButton rbBob;
+		private System.Windows.Forms.RadioButton rbBlend;
 		private System.Windows.Forms.GroupBox groupBox5;
 		private System.Windows.Forms.CheckBox cbLEC;
 		private System.Windows.Forms.CheckBox cbGpuLag;
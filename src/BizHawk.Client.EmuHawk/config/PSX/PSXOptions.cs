@@ -61,6 +61,7 @@ namespace BizHawk.Client.EmuHawk
 			rbWeave.Checked = _settings.DeinterlaceMode == Octoshock.eDeinterlaceMode.Weave;
 			rbBob.Checked = _settings.DeinterlaceMode == Octoshock.eDeinterlaceMode.Bob;
 			rbBobOffset.Checked = _settings.DeinterlaceMode == Octoshock.eDeinterlaceMode.BobOffset;
+			rbBlend.Checked = _settings.DeinterlaceMode == Octoshock.eDeinterlaceMode.Blend;
 
 			NTSC_FirstLineNumeric.Value = _settings.ScanlineStart_NTSC;
 			NTSC_LastLineNumeric.Value = _settings.ScanlineEnd_NTSC;
@@ -113,6 +114,7 @@ namespace BizHawk.Client.EmuHawk
 			if (rbWeave.Checked) _settings.DeinterlaceMode = Octoshock.eDeinterlaceMode.Weave;
 			if (rbBob.Checked) _settings.DeinterlaceMode = Octoshock.eDeinterlaceMode.Bob;
 			if (rbBobOffset.Checked) _settings.DeinterlaceMode = Octoshock.eDeinterlaceMode.BobOffset;
+			if (rbBlend.Checked) _settings.DeinterlaceMode = Octoshock.eDeinterlaceMode.Blend;
 
 			settings.ScanlineStart_NTSC = (int)NTSC_FirstLineNumeric.Value;
 			settings.ScanlineEnd_NTSC = (int)NTSC_LastLineNumeric.Value;
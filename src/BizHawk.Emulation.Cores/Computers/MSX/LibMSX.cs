@@ -104,6 +104,33 @@ namespace BizHawk.Emulation.Cores.Computers.MSX
 		[DllImport(lib, CallingConvention = cc)]
 		public static extern void MSX_load_state(IntPtr core, byte[] loader);
 
+		/// <summary>
+		/// Size of a checked state, plain states fit in this too
+		/// </summary>
+		/// <param name="core">opaque state pointer</param>
+		[DllImport(lib, CallingConvention = cc)]
+		public static extern uint MSX_state_size(IntPtr core);
+
+		/// <summary>
+		/// Save a versioned state
+		/// </summary>
+		/// <param name="core">opaque state pointer</param>
+		/// <param name="saver">save buffer</param>
+		/// <param name="length">length of the save buffer</param>
+		/// <returns>length written, negative value if the buffer is too small</returns>
+		[DllImport(lib, CallingConvention = cc)]
+		public static extern int MSX_save_state_checked(IntPtr core, byte[] saver, uint length);
+
+		/// <summary>
+		/// Load a versioned state
+		/// </summary>
+		/// <param name="core">opaque state pointer</param>
+		/// <param name="loader">load buffer</param>
+		/// <param name="length">length of the load buffer</param>
+		/// <returns>0 on success, negative value if the state is truncated or from another version</returns>
+		[DllImport(lib, CallingConvention = cc)]
+		public static extern int MSX_load_state_checked(IntPtr core, byte[] loader, uint length);
+
 		/// <summary>
 		/// Read the system bus
 		/// </summary>
@@ -128,6 +155,69 @@ namespace BizHawk.Emulation.Cores.Computers.MSX
 		[DllImport(lib, CallingConvention = cc)]
 		public static extern byte MSX_getram(IntPtr core, int addr);
 
+		/// <summary>
+		/// Read a range of the system bus
+		/// </summary>
+		/// <param name="core">opaque state pointer</param>
+		/// <param name="dest">where to copy to</param>
+		/// <param name="addr">system bus address, wraps around</param>
+		/// <param name="length">number of bytes</param>
+		[DllImport(lib, CallingConvention = cc)]
+		public static extern void MSX_getsysbus_range(IntPtr core, byte[] dest, uint addr, uint length);
+
+		/// <summary>
+		/// Read a range of the VRAM
+		/// </summary>
+		/// <param name="core">opaque state pointer</param>
+		/// <param name="dest">where to copy to</param>
+		/// <param name="addr">vram address, wraps around</param>
+		/// <param name="length">number of bytes</param>
+		[DllImport(lib, CallingConvention = cc)]
+		public static extern void MSX_getvram_range(IntPtr core, byte[] dest, uint addr, uint length);
+
+		/// <summary>
+		/// Write a range of the VRAM
+		/// </summary>
+		/// <param name="core">opaque state pointer</param>
+		/// <param name="src">where to copy from</param>
+		/// <param name="addr">vram address, wraps around</param>
+		/// <param name="length">number of bytes</param>
+		[DllImport(lib, CallingConvention = cc)]
+		public static extern void MSX_setvram_range(IntPtr core, byte[] src, uint addr, uint length);
+
+		/// <summary>
+		/// Read a range of the RAM
+		/// </summary>
+		/// <param name="core">opaque state pointer</param>
+		/// <param name="dest">where to copy to</param>
+		/// <param name="addr">ram address, wraps around</param>
+		/// <param name="length">number of bytes</param>
+		[DllImport(lib, CallingConvention = cc)]
+		public static extern void MSX_getram_range(IntPtr core, byte[] dest, uint addr, uint length);
+
+		/// <summary>
+		/// Write a range of the RAM
+		/// </summary>
+		/// <param name="core">opaque state pointer</param>
+		/// <param name="src">where to copy from</param>
+		/// <param name="addr">ram address, wraps around</param>
+		/// <param name="length">number of bytes</param>
+		[DllImport(lib, CallingConvention = cc)]
+		public static extern void MSX_setram_range(IntPtr core, byte[] src, uint addr, uint length);
+
+		/// <summary>
+		/// Get a pointer to a flat memory area, valid for the life of the core
+		/// </summary>
+		/// <param name="core">opaque state pointer</param>
+		/// <param name="which">area index, count up from 0 until false is returned</param>
+		/// <param name="data">pointer to the area</param>
+		/// <param name="size">size of the area in bytes</param>
+		/// <param name="writable">whether the area can be written through the pointer</param>
+		/// <param name="name">pointer to const char *</param>
+		[DllImport(lib, CallingConvention = cc)]
+		[return: MarshalAs(UnmanagedType.U1)]
+		public static extern bool MSX_get_memory_area(IntPtr core, int which, ref IntPtr data, ref int size, [MarshalAs(UnmanagedType.U1)] ref bool writable, ref IntPtr name);
+
 		/// <summary>
 		/// type of the cpu trace callback
 		/// </summary>
@@ -41,9 +41,12 @@ namespace BizHawk.Emulation.Cores.Computers.MSX
 			
 			LibMSX.MSX_settracecallback(MSX_Pntr, tracecb);
 			
-			LibMSX.MSX_frame_advance(MSX_Pntr, ctrl1_byte, ctrl2_byte, kb_rows, true, true);
+			LibMSX.MSX_frame_advance(MSX_Pntr, ctrl1_byte, ctrl2_byte, kb_rows, render, rendersound);
 
-			LibMSX.MSX_get_video(MSX_Pntr, _vidbuffer);
+			if (render)
+			{
+				LibMSX.MSX_get_video(MSX_Pntr, _vidbuffer);
+			}
 
 			/*
 			int msg_l = LibMSX.MSX_getmessagelength(MSX_Pntr);
@@ -1,6 +1,8 @@
 ﻿using System.Collections.Generic;
 using System.Linq;
+using System.Runtime.InteropServices;
 
+using BizHawk.Common;
 using BizHawk.Emulation.Common;
 
 namespace BizHawk.Emulation.Cores.Computers.MSX
@@ -21,23 +23,41 @@ namespace BizHawk.Emulation.Cores.Computers.MSX
 					MemoryDomain.Endian.Little,
 					(addr) => LibMSX.MSX_getsysbus(MSX_Pntr, (int)(addr & 0xFFFF)),
 					(addr, value) => { }, 
-					1),
-				new MemoryDomainDelegate(
-					"VRAM",
-					0x4000,
-					MemoryDomain.Endian.Little,
-					(addr) => LibMSX.MSX_getvram(MSX_Pntr, (int)(addr & 0x3FFF)),
-					(addr, value) => { },
-					1),
-				new MemoryDomainDelegate(
-					"RAM",
-					0x10000,
-					MemoryDomain.Endian.Little,
-					(addr) => LibMSX.MSX_getram(MSX_Pntr, (int)(addr & 0xFFFF)),
-					(addr, value) => { },
-					1)
+					1,
+					bulkPeekByte: (addresses, values) =>
+					{
+						var start = (ulong)addresses.Start;
+						var count = addresses.Count();
+
+						// the core copies straight into values, so it has to be exactly the right size
+						if (values.Length != (long)count)
+						{
+							throw new ArgumentException("Invalid length of values array", nameof(values));
+						}
+
+						if (start >= 0x10000 || start + count > 0x10000)
+						{
+							throw new ArgumentOutOfRangeException(nameof(addresses));
+						}
+
+						LibMSX.MSX_getsysbus_range(MSX_Pntr, values, (uint)start, (uint)count);
+					})
 			};
 
+			// RAM and VRAM are flat in the core, so they are accessed in place
+			for (int i = 0; ; i++)
+			{
+				IntPtr data = IntPtr.Zero;
+				int size = 0;
+				bool writable = false;
+				IntPtr name = IntPtr.Zero;
+
+				if (!LibMSX.MSX_get_memory_area(MSX_Pntr, i, ref data, ref size, ref writable, ref name))
+					break;
+
+				domains.Add(new MemoryDomainIntPtr(Marshal.PtrToStringAnsi(name), MemoryDomain.Endian.Little, data, size, writable, 1));
+			}
+
 			if (SaveRAM != null)
 			{
 				var saveRamDomain = new MemoryDomainDelegate("Save RAM", SaveRAM.Length, MemoryDomain.Endian.Little,
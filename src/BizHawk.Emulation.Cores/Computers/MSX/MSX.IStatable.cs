@@ -4,6 +4,9 @@ namespace BizHawk.Emulation.Cores.Computers.MSX
 {
 	public partial class MSX
 	{
+		// states from before the core state had a header were a bare, fixed size buffer
+		private const int LegacyCoreStateSize = 0x28000;
+
 		private void SyncState(Serializer ser)
 		{
 			ser.BeginSection("MSX");
@@ -24,11 +27,30 @@ namespace BizHawk.Emulation.Cores.Computers.MSX
 			if (ser.IsReader)
 			{
 				ser.Sync(nameof(MSX_core), ref MSX_core, false);
-				LibMSX.MSX_load_state(MSX_Pntr, MSX_core);
+				switch (LibMSX.MSX_load_state_checked(MSX_Pntr, MSX_core, (uint)MSX_core.Length))
+				{
+					case 0:
+						break;
+					case -1:
+						throw new InvalidOperationException("MSX core state is truncated");
+					case -2 when MSX_core.Length == LegacyCoreStateSize:
+						LibMSX.MSX_load_state(MSX_Pntr, MSX_core);
+						// later saves are checked ones, which need a buffer of the current size
+						MSX_core = new byte[LibMSX.MSX_state_size(MSX_Pntr)];
+						break;
+					case -2:
+						throw new InvalidOperationException("Not an MSX core state");
+					default:
+						throw new InvalidOperationException("MSX core state is from an incompatible version");
+				}
 			}
 			else
 			{
-				LibMSX.MSX_save_state(MSX_Pntr, MSX_core);
+				if (LibMSX.MSX_save_state_checked(MSX_Pntr, MSX_core, (uint)MSX_core.Length) < 0)
+				{
+					throw new InvalidOperationException($"{nameof(LibMSX.MSX_save_state_checked)}() returned an error");
+				}
+
 				ser.Sync(nameof(MSX_core), ref MSX_core, false);
 			}
 		}
@@ -133,6 +133,7 @@ namespace BizHawk.Emulation.Cores.Computers.MSX
 			for (int i = 0; i < 0x10000; i++) { RomData2[i] = 0; }
 			
 			MSX_Pntr = LibMSX.MSX_create();
+			MSX_core = new byte[LibMSX.MSX_state_size(MSX_Pntr)];
 
 			LibMSX.MSX_load_bios(MSX_Pntr, Bios, Basic);
 			LibMSX.MSX_load(MSX_Pntr, RomData, (uint)RomData.Length, mapper_1, RomData2, (uint)RomData2.Length, 0);
@@ -167,7 +168,7 @@ namespace BizHawk.Emulation.Cores.Computers.MSX
 		}
 
 		private IntPtr MSX_Pntr { get; set; } = IntPtr.Zero;
-		private byte[] MSX_core = new byte[0x28000];
+		private byte[] MSX_core;
 		private static byte[] Bios = null;
 		private static byte[] Basic;
 
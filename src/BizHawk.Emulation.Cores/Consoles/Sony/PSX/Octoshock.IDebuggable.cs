@@ -112,15 +112,47 @@ namespace BizHawk.Emulation.Cores.Sony.PSX
 		{
 			mem_cb = new OctoshockDll.ShockCallback_Mem(ShockMemCallback);
 			_memoryCallbacks.ActiveChanged += RefreshMemCallbacks;
+			_memoryCallbacks.CallbackAdded += OnMemCallbackChanged;
+			_memoryCallbacks.CallbackRemoved += OnMemCallbackChanged;
 		}
 
+		private void OnMemCallbackChanged(IMemoryCallback callback) => RefreshMemCallbacks();
+
 		private void RefreshMemCallbacks()
 		{
 			OctoshockDll.eShockMemCb mask = OctoshockDll.eShockMemCb.None;
 			if (MemoryCallbacks.HasReads) mask |= OctoshockDll.eShockMemCb.Read;
 			if (MemoryCallbacks.HasWrites) mask |= OctoshockDll.eShockMemCb.Write;
 			if (MemoryCallbacks.HasExecutes) mask |= OctoshockDll.eShockMemCb.Execute;
-			OctoshockDll.shock_SetMemCb(psx, mem_cb, mask);
+
+			// the core only calls back for the pages these ranges touch; MemoryCallbackSystem still does the exact address match
+			var ranges = new List<OctoshockDll.ShockMemCbRange>();
+			foreach (var cb in MemoryCallbacks)
+			{
+				var range = new OctoshockDll.ShockMemCbRange
+				{
+					type = cb.Type switch
+					{
+						MemoryCallbackType.Read => OctoshockDll.eShockMemCb.Read,
+						MemoryCallbackType.Write => OctoshockDll.eShockMemCb.Write,
+						_ => OctoshockDll.eShockMemCb.Execute
+					},
+					start = 0,
+					end = uint.MaxValue
+				};
+
+				// a mask that only clears low bits matches one contiguous range. anything else (or no address at all) watches everything
+				uint mirror = ~(cb.AddressMask ?? uint.MaxValue);
+				if (cb.Address.HasValue && (mirror & (mirror + 1)) == 0)
+				{
+					range.start = cb.Address.Value & ~mirror;
+					range.end = range.start | mirror;
+				}
+
+				ranges.Add(range);
+			}
+
+			OctoshockDll.shock_SetMemCb(psx, mem_cb, mask, ranges.ToArray(), ranges.Count);
 		}
 
 		private void SetMemoryDomains()
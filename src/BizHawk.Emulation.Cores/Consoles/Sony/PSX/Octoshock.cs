@@ -349,6 +349,8 @@ namespace BizHawk.Emulation.Cores.Sony.PSX
 			disposed = true;
 
 			_memoryCallbacks.ActiveChanged -= RefreshMemCallbacks;
+			_memoryCallbacks.CallbackAdded -= OnMemCallbackChanged;
+			_memoryCallbacks.CallbackRemoved -= OnMemCallbackChanged;
 
 			//discs arent bound to shock core instances, but they may be mounted. kill the core instance first to effectively dereference the disc
 			OctoshockDll.shock_Destroy(psx);
@@ -784,6 +786,7 @@ namespace BizHawk.Emulation.Cores.Sony.PSX
 			if (_Settings.DeinterlaceMode == eDeinterlaceMode.Weave) ropts.deinterlaceMode = OctoshockDll.eShockDeinterlaceMode.Weave;
 			if (_Settings.DeinterlaceMode == eDeinterlaceMode.Bob) ropts.deinterlaceMode = OctoshockDll.eShockDeinterlaceMode.Bob;
 			if (_Settings.DeinterlaceMode == eDeinterlaceMode.BobOffset) ropts.deinterlaceMode = OctoshockDll.eShockDeinterlaceMode.BobOffset;
+			if (_Settings.DeinterlaceMode == eDeinterlaceMode.Blend) ropts.deinterlaceMode = OctoshockDll.eShockDeinterlaceMode.Blend;
 
 			OctoshockDll.shock_SetRenderOptions(psx, ref ropts);
 
@@ -798,7 +801,9 @@ namespace BizHawk.Emulation.Cores.Sony.PSX
 				OctoshockDll.shock_SoftReset(psx);
 
 			//------------------------
-			OctoshockDll.shock_Step(psx, OctoshockDll.eShockStep.Frame);
+			var step = OctoshockDll.eShockStep.Frame;
+			if (!rendersound) step |= OctoshockDll.eShockStep.SkipAudio;
+			OctoshockDll.shock_Step(psx, step);
 			//------------------------
 
 			//lag maintenance:
@@ -1098,7 +1103,8 @@ namespace BizHawk.Emulation.Cores.Sony.PSX
 		{
 			Weave,
 			Bob,
-			BobOffset
+			BobOffset,
+			Blend,
 		}
 
 		[CoreSettings]
@@ -26,9 +26,11 @@ namespace BizHawk.Emulation.Cores.Sony.PSX
 			PAL = 1,
 		}
 
+		[Flags]
 		public enum eShockStep
 		{
-			Frame
+			Frame = 0,
+			SkipAudio = 0x100, // flag: produce no sound, but keep all SPU state exact
 		}
 
 		public enum eShockFramebufferFlags
@@ -53,7 +55,9 @@ namespace BizHawk.Emulation.Cores.Sony.PSX
 			BinaryLoad = 1,
 			BinarySave = 2,
 			TextLoad = 3,
-			TextSave = 4
+			TextSave = 4,
+			BinaryDeltaSave = 5,
+			BinaryDeltaLoad = 6
 		}
 
 		public enum eShockMemcardTransaction
@@ -95,7 +99,8 @@ namespace BizHawk.Emulation.Cores.Sony.PSX
 		{
 			Weave,
 			Bob,
-			BobOffset
+			BobOffset,
+			Blend,
 		}
 
 		[Flags]
@@ -147,6 +152,35 @@ namespace BizHawk.Emulation.Cores.Sony.PSX
 			public void* ptr;
 		}
 
+		[StructLayout(LayoutKind.Sequential)]
+		public struct ShockFramebufferView
+		{
+			[MarshalAs(UnmanagedType.I4)]
+			public eShockFramebufferFlags flags;
+			public int width, height;
+			public int x, y;
+			public int pitch;
+			public int* pixels;
+		}
+
+		[StructLayout(LayoutKind.Sequential)]
+		public struct ShockTraceRecord
+		{
+			public uint PC;
+			public uint instr;
+			public uint timestamp;
+			public uint value; //what the instruction wrote to GPR[reg]
+			public byte reg; //0 if none
+			public fixed byte pad[3];
+		}
+
+		[StructLayout(LayoutKind.Sequential)]
+		public struct ShockMemCbRange
+		{
+			public eShockMemCb type;
+			public uint start, end; //inclusive
+		}
+
 		[StructLayout(LayoutKind.Sequential)]
 		public struct ShockRenderOptions
 		{
@@ -154,6 +188,7 @@ namespace BizHawk.Emulation.Cores.Sony.PSX
 			public eShockRenderType renderType;
 			public eShockDeinterlaceMode deinterlaceMode;
 			public bool skip;
+			public int renderThreads;
 		}
 
 		[StructLayout(LayoutKind.Sequential)]
@@ -181,12 +216,17 @@ namespace BizHawk.Emulation.Cores.Sony.PSX
 			public void* buffer;
 			public int bufferLength;
 			public TextStateFPtrs ff;
+			public void* reference;
+			public int referenceLength;
 		}
 
 
 		[UnmanagedFunctionPointer(CallingConvention.Cdecl)]
 		public delegate void ShockCallback_Trace(IntPtr opaque, uint PC, uint inst, string dis);
 
+		[UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+		public delegate void ShockCallback_TraceFlush(IntPtr opaque, ShockTraceRecord* records, uint count);
+
 		[UnmanagedFunctionPointer(CallingConvention.Cdecl)]
 		public delegate int ShockDisc_ReadTOC(IntPtr opaque, ShockTOC* read_target, ShockTOCTrack* tracks101);
 
@@ -205,6 +245,9 @@ namespace BizHawk.Emulation.Cores.Sony.PSX
 		[DllImport(dd, CallingConvention = cc)]
 		public static extern int shock_DestroyDisc(IntPtr disc);
 
+		[DllImport(dd, CallingConvention = cc)]
+		public static extern int shock_SetDiscPrefetch(IntPtr disc, int sectors);
+
 		[DllImport(dd, CallingConvention = cc)]
 		public static extern int shock_AnalyzeDisc(IntPtr disc, out ShockDiscInfo info);
 
@@ -266,6 +309,9 @@ namespace BizHawk.Emulation.Cores.Sony.PSX
 		[DllImport(dd, CallingConvention = cc)]
 		public static extern int shock_GetFramebuffer(IntPtr psx, ref ShockFramebufferInfo fb);
 
+		[DllImport(dd, CallingConvention = cc)]
+		public static extern int shock_GetFramebufferView(IntPtr psx, ref ShockFramebufferView fb);
+
 		[DllImport(dd, CallingConvention = cc)]
 		public static extern int shock_GetSamples(IntPtr psx, void* buffer);
 
@@ -290,7 +336,10 @@ namespace BizHawk.Emulation.Cores.Sony.PSX
 		public static extern int shock_SetTraceCallback(IntPtr psx, IntPtr opaque, ShockCallback_Trace callback);
 
 		[DllImport(dd, CallingConvention = cc)]
-		public static extern int shock_SetMemCb(IntPtr psx, ShockCallback_Mem cb, eShockMemCb cbMask);
+		public static extern int shock_SetBinaryTrace(IntPtr psx, ShockTraceRecord* buffer, int capacity, IntPtr opaque, ShockCallback_TraceFlush flush);
+
+		[DllImport(dd, CallingConvention = cc)]
+		public static extern int shock_SetMemCb(IntPtr psx, ShockCallback_Mem cb, eShockMemCb cbMask, ShockMemCbRange[] ranges, int nranges);
 
 		[DllImport(dd, CallingConvention = cc)]
 		public static extern int shock_SetLEC(IntPtr psx, bool enable);
@@ -46,6 +46,20 @@ namespace BizHawk.Emulation.DiscSystem
 				_ = mednadisc_ReadSector(handle, LBA, pBuffer + offset);
 		}
 
+		/// <summary>
+		/// Reads the whole disc on <paramref name="threads"/> workers (0 = one per core), checking EDC/L-EC on data sectors
+		/// and hashing each track's 2352-byte sectors
+		/// </summary>
+		public MednadiscTrackReport[] VerifyTracks(int threads = 0)
+		{
+			var reports = new MednadiscTrackReport[100];
+			int n;
+			fixed (MednadiscTrackReport* pReports = &reports[0])
+				n = mednadisc_VerifyDisc(handle, threads, pReports);
+			Array.Resize(ref reports, Math.Max(n, 0));
+			return reports;
+		}
+
 #if false
 		public void ReadSubcodeDeinterleaved(int LBA, byte[] buffer, int offset)
 		{
@@ -133,6 +147,21 @@ namespace BizHawk.Emulation.DiscSystem
 			public bool Valid => _validByte != 0;
 		}
 
+		[StructLayout(LayoutKind.Sequential)]
+		public struct MednadiscTrackReport
+		{
+			public int track;
+			public int lba;
+			public int sectors;
+			public int is_data;
+			public uint crc32;
+			public fixed byte sha1[20];
+			public int edc_ok;
+			public int edc_corrected;
+			public int edc_bad;
+			public int read_errors;
+		}
+
 		[DllImport("mednadisc.dll", CallingConvention = CallingConvention.Cdecl)]
 		public static extern IntPtr mednadisc_LoadCD(string path);
 
@@ -144,5 +173,8 @@ namespace BizHawk.Emulation.DiscSystem
 
 		[DllImport("mednadisc.dll", CallingConvention = CallingConvention.Cdecl)]
 		public static extern void mednadisc_ReadTOC(IntPtr disc, MednadiscTOC* toc, MednadiscTOCTrack* tracks101);
+
+		[DllImport("mednadisc.dll", CallingConvention = CallingConvention.Cdecl)]
+		public static extern int mednadisc_VerifyDisc(IntPtr disc, int threads, MednadiscTrackReport* reports100);
 	}
 }
\ No newline at end of file
@@ -27,7 +27,7 @@ public:
 
 public:
 	System *sys;
-	template<bool isReader>void SyncState(NewState *ns);
+	template<bool isReader, class NS>void SyncState(NS *ns);
 };
 
 
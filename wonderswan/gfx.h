@@ -84,7 +84,7 @@ private:
 
 public:
 	System *sys;
-	template<bool isReader>void SyncState(NewState *ns);
+	template<bool isReader, class NS>void SyncState(NS *ns);
 };
 
 }
@@ -43,7 +43,7 @@ private:
 	void Recalc();
 public:
 	System *sys;
-	template<bool isReader>void SyncState(NewState *ns);
+	template<bool isReader, class NS>void SyncState(NS *ns);
 };
 
 }
@@ -55,7 +55,7 @@ namespace MDFN_IEN_WSWAN
 
 
 
-	uint8 Memory::Read20(uint32 A)
+	uint8 Memory::Read20Slow(uint32 A)
 	{
 		uint32	offset, bank;
 
@@ -84,6 +84,25 @@ namespace MDFN_IEN_WSWAN
 		}
 	}
 
+	void Memory::UpdateReadMap()
+	{
+		const uint32 rom_mask = (rom_size >> 16) - 1;
+
+		ReadMap[0] = wsRAM;
+
+		// SRAM smaller than a bank mirrors within it, so that case stays on the slow path
+		if(sram_size >= 0x10000)
+			ReadMap[1] = wsSRAM + ((BankSelector[1] << 16) & (sram_size - 1));
+		else
+			ReadMap[1] = nullptr;
+
+		ReadMap[2] = wsCartROM + ((BankSelector[2] & rom_mask) << 16);
+		ReadMap[3] = wsCartROM + ((BankSelector[3] & rom_mask) << 16);
+
+		for(uint32 bank = 4; bank < 16; bank++)
+			ReadMap[bank] = wsCartROM + (((((BankSelector[0] & 0xF) << 4) | bank) & rom_mask) << 16);
+	}
+
 	void Memory::CheckDMA()
 	{
 		if(DMAControl & 0x80)
@@ -268,10 +287,10 @@ namespace MDFN_IEN_WSWAN
 				ButtonReadLatch |= (WSButtonStatus >> 4) & 0xF;
 			break;
 
-		case 0xC0: BankSelector[0] = V & 0xF; break;
-		case 0xC1: BankSelector[1] = V; break;
-		case 0xC2: BankSelector[2] = V; break;
-		case 0xC3: BankSelector[3] = V; break;
+		case 0xC0: BankSelector[0] = V & 0xF; UpdateReadMap(); break;
+		case 0xC1: BankSelector[1] = V; UpdateReadMap(); break;
+		case 0xC2: BankSelector[2] = V; UpdateReadMap(); break;
+		case 0xC3: BankSelector[3] = V; UpdateReadMap(); break;
 		}
 	}
 
@@ -321,6 +340,7 @@ namespace MDFN_IEN_WSWAN
 		wsRAM[0x75B3] = 0x31;
 
 		std::memset(BankSelector, 0, sizeof(BankSelector));
+		UpdateReadMap();
 		ButtonWhich = 0;
 		ButtonReadLatch = 0;
 		DMASource = 0;
@@ -365,5 +385,8 @@ namespace MDFN_IEN_WSWAN
 		NSS(CommData);
 
 		NSS(language);
+
+		if (isReader)
+			UpdateReadMap();
 	}
 }
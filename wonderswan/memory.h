@@ -10,7 +10,12 @@ class Memory
 public:
 	~Memory();
 
-	uint8 Read20(uint32);
+	// instruction fetches and data reads go through here, so banks that are plain memory are read straight from ReadMap
+	uint8 Read20(uint32 A)
+	{
+		const uint8 *page = ReadMap[(A >> 16) & 0xF];
+		return page ? page[A & 0xFFFF] : Read20Slow(A);
+	}
 	void Write20(uint32 address,uint8 data);
 
 	void Init(const SyncSettings &settings);
@@ -47,6 +52,9 @@ private:
 
 	uint8 BankSelector[4];
 
+	// host pointer to each 64K bank, or null where Read20Slow has to work it out.  not stated, rebuilt from BankSelector
+	const uint8 *ReadMap[16];
+
 	uint8 CommControl, CommData;
 
 	bool language;
@@ -56,9 +64,11 @@ public:
 
 public:
 	System *sys;
-	template<bool isReader>void SyncState(NewState *ns);
+	template<bool isReader, class NS>void SyncState(NS *ns);
 private:
 	void CheckDMA();
+	uint8 Read20Slow(uint32 A);
+	void UpdateReadMap();
 
 };
 
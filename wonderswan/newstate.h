@@ -15,7 +15,10 @@ public:
 	virtual void ExitSection(const char *name) { }
 };
 
-class NewStateDummy : public NewState
+// SyncState is instantiated for each of the final classes below, so their Save and Load
+// are called directly and inlined; the binary ones end up as plain copies
+
+class NewStateDummy final : public NewState
 {
 private:
 	long length;
@@ -23,11 +26,11 @@ public:
 	NewStateDummy();
 	long GetLength() { return length; }
 	void Rewind() { length = 0; }
-	virtual void Save(const void *ptr, size_t size, const char *name);
-	virtual void Load(void *ptr, size_t size, const char *name);
+	virtual void Save(const void *ptr, size_t size, const char *name) { length += size; }
+	virtual void Load(void *ptr, size_t size, const char *name) { }
 };
 
-class NewStateExternalBuffer : public NewState
+class NewStateExternalBuffer final : public NewState
 {
 private:
 	char *const buffer;
@@ -38,8 +41,18 @@ public:
 	long GetLength() { return length; }
 	void Rewind() { length = 0; }
 	bool Overflow() { return length > maxlength; }
-	virtual void Save(const void *ptr, size_t size, const char *name);
-	virtual void Load(void *ptr, size_t size, const char *name);
+	virtual void Save(const void *ptr, size_t size, const char *name)
+	{
+		if (maxlength - length >= (long)size)
+			std::memcpy(buffer + length, ptr, size);
+		length += size;
+	}
+	virtual void Load(void *ptr, size_t size, const char *name)
+	{
+		if (maxlength - length >= (long)size)
+			std::memcpy(ptr, buffer + length, size);
+		length += size;
+	}
 };
 
 struct FPtrs
@@ -50,7 +63,7 @@ struct FPtrs
 	void (*ExitSection_)(const char *name);
 };
 
-class NewStateExternalFunctions : public NewState
+class NewStateExternalFunctions final : public NewState
 {
 private:
 	void (*Save_)(const void *ptr, size_t size, const char *name);
@@ -67,9 +80,12 @@ public:
 
 // defines and explicitly instantiates 
 #define SYNCFUNC(x)\
-	template void x::SyncState<false>(NewState *ns);\
-	template void x::SyncState<true>(NewState *ns);\
-	template<bool isReader>void x::SyncState(NewState *ns)
+	template void x::SyncState<false>(NewStateDummy *ns);\
+	template void x::SyncState<false>(NewStateExternalBuffer *ns);\
+	template void x::SyncState<true>(NewStateExternalBuffer *ns);\
+	template void x::SyncState<false>(NewStateExternalFunctions *ns);\
+	template void x::SyncState<true>(NewStateExternalFunctions *ns);\
+	template<bool isReader, class NS>void x::SyncState(NS *ns)
 
 // N = normal variable
 // P = pointer to fixed size data
@@ -22,7 +22,7 @@ private:
 	uint8 Command, Data;
 public:
 	System *sys;
-	template<bool isReader>void SyncState(NewState *ns);
+	template<bool isReader, class NS>void SyncState(NS *ns);
 
 };
 
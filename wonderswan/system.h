@@ -57,7 +57,7 @@ public:
 	bool rotate; // rotate screen and controls left 90
 	uint32 oldbuttons;
 
-	template<bool isReader>void SyncState(NewState *ns);
+	template<bool isReader, class NS>void SyncState(NS *ns);
 };
 
 struct SyncSettings